@@ -8,23 +8,20 @@
 
 #pragma once
 
+#include <cstddef>
 #include <vector>
 #include <string>
 #include <ignition/math.hh>
 #include "Bilinear_interp.hpp"
 #include "Math_util.hpp"
 #include "LookupTable.hpp"
+#include "AerodynamicModelT.hpp"
 #include "AerodynamicState.hpp"
 #include "Airfoil.hpp"
 #include "IPhysicsEnvironment.hpp"
 
 namespace avionics_sim {
 
-struct AeroAngles {
-    double attackAngle_deg;
-    double sideSlipAngle_deg;
-};
-
 // TODO(Nicholas): Move this out to its own file
 /**
  * \brief Interface class to the lift drag model object.
@@ -46,7 +43,7 @@ class IAerodynamicModel {
         double controlAngle_rad) = 0;
 
     /**
-     * \brief A function called from within updateLiftDragInBody_N that is useful to extend access to for cases of evaluating aerodynamics under propwash conditions.
+     * \brief A function called from within updateForcesInBody_N, once the pose and velocity are resolved into the flow, that is useful to extend access to for cases of evaluating aerodynamics under propwash conditions.
      */
     virtual ignition::math::Vector3d updateForcesInBody_N(
         double planarVelocity_m_per_s,
@@ -54,10 +51,63 @@ class IAerodynamicModel {
         double angleOfAttack_deg,
         double sideSlipAngle_deg)  = 0;
 
+    /**
+     * \brief Updates the model with a batch of poses and velocities of an airfoil and calculates the forces of each.
+     *
+     * \details Each array holds count elements. The forces, and the model afterwards, are those of calling
+     * updateForcesInBody_N() on each pose in turn, which is what this does unless overridden to cost less per element.
+     */
+    virtual void updateForcesInBody_N(
+        const ignition::math::Pose3d *posesInWorld_m_rad,
+        const ignition::math::Vector3d *velocitiesInWorld_m_per_s,
+        const double *propWashes_m_per_s,
+        const double *controlAngles_rad,
+        std::size_t count,
+        ignition::math::Vector3d *forcesInBody_N) {
+        for (std::size_t i = 0; i < count; i++) {
+            forcesInBody_N[i] = updateForcesInBody_N(
+                                    posesInWorld_m_rad[i],
+                                    velocitiesInWorld_m_per_s[i],
+                                    propWashes_m_per_s[i],
+                                    controlAngles_rad[i]);
+        }
+    }
+
+    /**
+     * \brief Updates the model with a pose and velocity of an airfoil and calculates the resultant force and moment.
+     *
+     * \details The force is that of updateForcesInBody_N(), which is all this gives, with no moment, unless overridden.
+     */
+    virtual AeroWrench updateWrenchInBody(
+        const ignition::math::Pose3d &poseInWorld_m_rad,
+        const ignition::math::Vector3d &velocityInWorld_m_per_s,
+        double propWash_m_per_s,
+        double controlAngle_rad) {
+        AeroWrench wrench;
+        wrench.force_N = updateForcesInBody_N(poseInWorld_m_rad, velocityInWorld_m_per_s, propWash_m_per_s,
+                                              controlAngle_rad);
+        return wrench;
+    }
+
     virtual ~IAerodynamicModel() {}
 };
 
-class AerodynamicModel : public IAerodynamicModel {
+///
+/// \brief      Lift drag model of an airfoil, behind IAerodynamicModel.
+///
+/// \details    An AerodynamicModelT reading its environment through IPhysicsEnvironment, whose virtual functions
+///             forward to it. Callers whose environment and polar are known when they are compiled can use an
+///             AerodynamicModelT of those types directly, for the same forces with no virtual call.
+///
+///             The update from a pose resolves the flow and then calls the update from the planar and lateral
+///             velocities and angles, which calls updateForcesInBodyFromFlow_N(), so that a subclass overriding either
+///             sees every update from a pose. An AerodynamicModel which is not a subclass calls
+///             updateForcesInBodyFromFlow_N() straight away, with the angle of attack in the radians it was resolved
+///             in, for exactly the forces of AerodynamicModelT; a subclass has them converted back from degrees. The
+///             updates of AerodynamicModelT brought in below, from a rotation or a snapshot, and updateWrenchInBody()
+///             call neither.
+///
+class AerodynamicModel : public IAerodynamicModel, public AerodynamicModelT<IPhysicsEnvironment, Airfoil> {
   public:
     AerodynamicModel();  ///< Default constructor
 
@@ -72,6 +122,19 @@ class AerodynamicModel : public IAerodynamicModel {
     ///
     virtual ~AerodynamicModel();
 
+    /// \brief The updates from a rotation or a snapshot, which the virtual updates below would otherwise hide.
+    using AerodynamicModelT<IPhysicsEnvironment, Airfoil>::updateForcesInBody_N;
+    using AerodynamicModelT<IPhysicsEnvironment, Airfoil>::updateWrenchInBody;
+
+    ///
+    /// \brief      Updates the model with a pose and velocity of the airfoil and calculates the resultant forces.
+    /// \details    Resolves the flow, then calls the update from the planar and lateral velocities and angles below.
+    /// \param[in]  poseInWorld_m_rad
+    /// \param[in]  velocityInWorld_m_per_s
+    /// \param[in]  propWash_m_per_s
+    /// \param[in]  controlAngle_rad
+    /// \return     Force in body
+    ///
     virtual ignition::math::Vector3d updateForcesInBody_N(
         ignition::math::Pose3d
         poseInWorld_m_rad,
@@ -79,117 +142,83 @@ class AerodynamicModel : public IAerodynamicModel {
         double propWash_m_per_s,
         double controlAngle_rad);
 
+    ///
+    /// \brief      Calculates the forces of a flow already resolved into planar and lateral velocities and angles.
+    /// \details    Called from the update from a pose, and calls updateForcesInBodyFromFlow_N().
+    /// \param[in]  planarVelocity_m_per_s
+    /// \param[in]  lateralVelocity_m_per_s
+    /// \param[in]  angleOfAttack_deg
+    /// \param[in]  sideSlipAngle_deg
+    /// \return     Force in body
+    ///
     virtual ignition::math::Vector3d updateForcesInBody_N(
         double planarVelocity_m_per_s,
         double lateralVelocity_m_per_s,
         double angleOfAttack_deg,
         double sideSlipAngle_deg);
 
-    double calculateAttackAngleWithControl(
-        double controlAngle_rad,
-        double angleOfAttackBody_deg,
-        double planarVelocity_m_per_s);
-
-    // Function to calculate dynamic pressure.
     ///
-    /// \brief      Calculates dynamic pressure (q)
+    /// \brief      Updates the model with a batch of poses and velocities and calculates the resultant forces of each.
     ///
-    /// \details    Call this function once speed and rho have been set.
-    /// \param[in]  N/A
+    /// \details    Gives the forces, and leaves the state, of calling updateForcesInBody_N() on each pose in turn. Unless
+    ///             this is a subclass, which may override the updates, only the last element goes through it: the
+    ///             others skip the virtual calls and the state, and share a single read of the air density. Allocates
+    ///             nothing.
+    /// \param[in]  posesInWorld_m_rad
+    /// \param[in]  velocitiesInWorld_m_per_s
+    /// \param[in]  propWashes_m_per_s
+    /// \param[in]  controlAngles_rad
+    /// \param[in]  count (Number of elements of each array)
+    /// \param[out] forcesInBody_N
     /// \return     N/A
-    double calculateDynamicPressure_Pa(double velocity_m_per_s);
-
-    ///
-    /// \brief Sets the basis vectors from only the fwd and upward vectors
-    ///
-    /// \details    N/A
-    /// \param[in]  forward Vector3d representing forward vector
-    /// \param[in]  upward Vector3d representing upward vector
-    /// \return     N/A
-    ///
-    void setBasisVectors(
-        ignition::math::Vector3d fwd,
-        ignition::math::Vector3d upward);
-
-    ignition::math::Vector3d transformToLocalVelocity(
-        ignition::math::Pose3d poseInWorld_m_rad,
-        ignition::math::Vector3d velocityInWorld_m_per_s);
-
-    double transformBodyToWindPlanar(ignition::math::Vector3d velocityInBody_m_per_s);
-    double transformBodyToWindLateral(ignition::math::Vector3d velocityInBody_m_per_s);
-
-    // Function to calculate lift.
     ///
-    /// \brief      Calculates value of lift.
-    ///
-    /// \details    N/A
-    /// \param[in]  N/A
-    /// \return     Value for lift.
-    double calculateLift_N(double liftCoefficient, double dynamicPressure_Pa);
-
-    // Function to calculate drag.
-    ///
-    /// \brief      Calculates value of drag.
-    ///
-    /// \details    N/A
-    /// \param[in]  N/A
-    /// \return     Value for drag.
-    double calculateDrag_N(double dragCoefficient, double dynamicPressure_Pa);
-
-    // Function to calculate lateral force.
-    ///
-    /// \brief      Calculates lateral force.
-    ///
-    /// \details    N/A
-    /// \param[in]  N/A
-    /// \return     Value for lift.
-    double calculateLateralForce_N(double lateralDragCoefficient, double lateralVelocity_m_per_s);
-
-    ///
-    /// /brief Calculates alpha and beta angles from wing pose and world velocity.
-    ///
-    /// \details    N/A
-    /// \param[in]  N/A
-    /// \return     N/A
-    ///
-    AeroAngles calculateBodyAttackAngles_deg(ignition::math::Vector3d velocityInBody_m_per_s);
+    virtual void updateForcesInBody_N(
+        const ignition::math::Pose3d *posesInWorld_m_rad,
+        const ignition::math::Vector3d *velocitiesInWorld_m_per_s,
+        const double *propWashes_m_per_s,
+        const double *controlAngles_rad,
+        std::size_t count,
+        ignition::math::Vector3d *forcesInBody_N);
+
+    ///
+    /// \brief      Updates the model as updateForcesInBody_N() and calculates the resultant moment in the same pass.
+    /// \details    As AerodynamicModelT::updateWrenchInBody(), with the force and moment at the center of pressure.
+    /// \param[in]  poseInWorld_m_rad
+    /// \param[in]  velocityInWorld_m_per_s
+    /// \param[in]  propWash_m_per_s
+    /// \param[in]  controlAngle_rad
+    /// \return     Force and moment in body
+    ///
+    virtual AeroWrench updateWrenchInBody(
+        const ignition::math::Pose3d &poseInWorld_m_rad,
+        const ignition::math::Vector3d &velocityInWorld_m_per_s,
+        double propWash_m_per_s,
+        double controlAngle_rad);
 
+  protected:
     ///
-    /// \brief      Function to calculate force vector with direction.
-    ///
-    /// \details    N/A
-    /// \param[in]  lift_N
-    /// \param[in]  drag_N
-    /// \param[in]  lateralForce_N
-    /// \param[in]  angleOfAttack_deg,
-    /// \param[in]  sideSlipAngle_deg,
-    /// \return     N/A
+    /// \brief      Calculates the forces of a resolved flow, with the angle of attack in degrees to look up the airfoil
+    ///             and in radians to rotate the forces by.
+    /// \details    Called by every update from a pose or from the planar and lateral velocities and angles, so that a
+    ///             subclass can extend them, as for evaluating aerodynamics under prop wash.
+    /// \param[in]  planarVelocity_m_per_s
+    /// \param[in]  lateralVelocity_m_per_s
+    /// \param[in]  angleOfAttack_deg
+    /// \param[in]  angleOfAttack_rad
+    /// \param[in]  sideSlipAngle_deg
+    /// \return     Force in body
     ///
-    ignition::math::Vector3d rotateForcesToBody(
-        double lift_N, double drag_N, double lateralForce_N,
-        double angleOfAttack_deg, double sideSlipAngle_deg);
-
-    double invertAttackAngle_deg(double angleOfAttack_deg);
-
-    AeroAngles correctAttackAnglesForDirectionAndControl_deg(
-        AeroAngles bodyAttackAngles_deg,
-        double controlAngle_rad,
-        double planarVelocity_m_per_s);
+    virtual ignition::math::Vector3d updateForcesInBodyFromFlow_N(
+        double planarVelocity_m_per_s,
+        double lateralVelocity_m_per_s,
+        double angleOfAttack_deg,
+        double angleOfAttack_rad,
+        double sideSlipAngle_deg);
 
   private:
-    /// \brief Forward vector
-    ignition::math::Vector3d vecFwd;
-
-    /// \brief Upward vector
-    ignition::math::Vector3d vecUpwd;
-
-    /// \brief Port vector
-    ignition::math::Vector3d vecPort;
-
-    Airfoil _airfoil;
-
-    AerodynamicState _state;
+    typedef AerodynamicModelT<IPhysicsEnvironment, Airfoil> Model;
 
-    IPhysicsEnvironment *_environment;
+    /// \brief Whether this is an AerodynamicModel itself, rather than a subclass which may override its updates.
+    bool isUnextended() const;
 };
 }  // namespace avionics_sim
@@ -0,0 +1,930 @@
+/**
+ * @brief       AerodynamicModelT
+ * @file        AerodynamicModelT.hpp
+ * @copyright   Copyright (c) 2021, Swift Engineering Inc.
+ * @license     Licensed under the MIT license. See LICENSE for details.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <ignition/math.hh>
+#include "AerodynamicState.hpp"
+#include "Airfoil.hpp"
+#include "Coordinate_Utils.hpp"
+#include "EnvironmentSnapshot.hpp"
+#include "Math_util.hpp"
+
+namespace avionics_sim {
+
+struct AeroAngles {
+    double attackAngle_deg;
+    double sideSlipAngle_deg;
+};
+
+///
+/// \brief      Force of an airfoil on the body, and its moment about the origin of the body.
+///
+struct AeroWrench {
+    ignition::math::Vector3d force_N;
+    ignition::math::Vector3d moment_N_m;
+};
+
+///
+/// \brief      Options of an aerodynamic model, shared by every AerodynamicModelT.
+///
+struct AerodynamicModelOptions {
+    ///
+    /// \brief      How much of the AerodynamicState an update keeps.
+    ///
+    enum StateCapture {
+        STATE_CAPTURE_NONE =    0,  ///< Nothing is kept, so updates skip the bookkeeping.
+        STATE_CAPTURE_FORCES =  1,  ///< Only lift_N, drag_N, lateralForce_N, force_N and moment_N_m are kept.
+        STATE_CAPTURE_FULL =    2   ///< The whole state is rebuilt on every update. The default.
+    };
+
+    ///
+    /// \brief      How the angles of attack and side slip are taken from the velocity.
+    ///
+    enum AngleMath {
+        ANGLE_MATH_EXACT =  0,  ///< With atan2() and asin(). The default.
+        ANGLE_MATH_FAST =   1   ///< With Math_util::fast_atan2() and fast_asin(), within 1e-7 rad of them.
+    };
+};
+
+///
+/// \brief      Lift drag model of an airfoil, whose environment and polar are known when the program is compiled.
+///
+/// \details    The whole model is defined here, with no virtual function of its own, so that an update inlines into
+///             its caller down to the air density and the lookup of the polar:
+///
+///             - Environment is any class with a double get_air_density_kg_per_m3(). One implementing
+///               IPhysicsEnvironment and declared final is called without virtual dispatch; IPhysicsEnvironment
+///               itself is called through it, as AerodynamicModel does.
+///             - Polar is any class with calculateCoefficients(), calculateCoefficientsWithMoment(),
+///               calculateSideSlipCoefficient(), getArea_m2(), getLateralArea_m2() and getChord_m() as those of
+///               Airfoil, such as Airfoil itself or FixedAirfoil, whose lookups are inline too.
+///
+///             The forces are exactly, bit for bit, those of AerodynamicModel for the same airfoil, basis vectors, air
+///             density and inputs.
+///
+template <typename Environment, typename Polar>
+class AerodynamicModelT : public AerodynamicModelOptions {
+  public:
+    AerodynamicModelT() :
+        vecFwd(ignition::math::Vector3d(0.0, 0.0, 0.0)),
+        vecUpwd(ignition::math::Vector3d(0.0, 0.0, 0.0)),
+        vecPort(ignition::math::Vector3d(0.0, 0.0, 0.0)),
+        _centerOfPressure_m(ignition::math::Vector3d(0.0, 0.0, 0.0)),
+        _stateCapture(STATE_CAPTURE_FULL),
+        _angleMath(ANGLE_MATH_EXACT),
+        _environment(nullptr) {
+    }
+
+    ///
+    /// \brief      Constructor
+    /// \param[in]  airfoil
+    /// \param[in]  environment (Environment of the airfoil, which must outlive the model)
+    ///
+    AerodynamicModelT(const Polar &airfoil, Environment &environment) :
+        _centerOfPressure_m(ignition::math::Vector3d(0.0, 0.0, 0.0)),
+        _airfoil(airfoil),
+        _stateCapture(STATE_CAPTURE_FULL),
+        _angleMath(ANGLE_MATH_EXACT),
+        _environment(&environment) {
+    }
+
+    ///
+    /// \brief      Updates the model with a pose and velocity of the airfoil and calculates the resultant forces.
+    /// \param[in]  poseInWorld_m_rad
+    /// \param[in]  velocityInWorld_m_per_s
+    /// \param[in]  propWash_m_per_s
+    /// \param[in]  controlAngle_rad
+    /// \return     Force in body
+    ///
+    ignition::math::Vector3d updateForcesInBody_N(
+        ignition::math::Pose3d poseInWorld_m_rad,
+        ignition::math::Vector3d velocityInWorld_m_per_s,
+        double propWash_m_per_s,
+        double controlAngle_rad) {
+        return updateForcesInBodyAtDensity_N(poseInWorld_m_rad, velocityInWorld_m_per_s, propWash_m_per_s,
+                                             controlAngle_rad, _environment->get_air_density_kg_per_m3());
+    }
+
+    ///
+    /// \brief      Updates the model as updateForcesInBody_N(), in the air of a snapshot taken for the step rather than
+    ///             of the environment.
+    /// \details    Every surface of a vehicle can then be updated from a single IPhysicsEnvironment::get_snapshot(),
+    ///             with no query of the environment of its own. The forces are those of an environment whose air
+    ///             density is that of the snapshot.
+    /// \param[in]  environment (State of the air)
+    /// \param[in]  poseInWorld_m_rad
+    /// \param[in]  velocityInWorld_m_per_s
+    /// \param[in]  propWash_m_per_s
+    /// \param[in]  controlAngle_rad
+    /// \return     Force in body
+    ///
+    ignition::math::Vector3d updateForcesInBody_N(
+        const EnvironmentSnapshot &environment,
+        const ignition::math::Pose3d &poseInWorld_m_rad,
+        const ignition::math::Vector3d &velocityInWorld_m_per_s,
+        double propWash_m_per_s,
+        double controlAngle_rad) {
+        return updateForcesInBodyAtDensity_N(poseInWorld_m_rad, velocityInWorld_m_per_s, propWash_m_per_s,
+                                             controlAngle_rad, environment.airDensity_kg_per_m3);
+    }
+
+    ///
+    /// \brief      Calculates the forces of a flow already resolved into planar and lateral velocities and angles.
+    /// \param[in]  planarVelocity_m_per_s
+    /// \param[in]  lateralVelocity_m_per_s
+    /// \param[in]  angleOfAttack_deg
+    /// \param[in]  sideSlipAngle_deg
+    /// \return     Force in body
+    ///
+    ignition::math::Vector3d updateForcesInBody_N(
+        double planarVelocity_m_per_s,
+        double lateralVelocity_m_per_s,
+        double angleOfAttack_deg,
+        double sideSlipAngle_deg) {
+        return updateForcesInBodyFromFlow_N(planarVelocity_m_per_s, lateralVelocity_m_per_s, angleOfAttack_deg,
+                                            DEG2RAD(angleOfAttack_deg), sideSlipAngle_deg);
+    }
+
+    ///
+    /// \brief      Updates the model with a velocity and a rotation of the world into the body, and calculates the
+    ///             resultant forces.
+    ///
+    /// \details    The same as updating with the pose the rotation was built from by
+    ///             Coordinate_Utils::project_rotation_global(), so that surfaces sharing a pose can share one rotation
+    ///             per step rather than each rebuilding it. The state keeps no pose.
+    /// \param[in]  worldToBody
+    /// \param[in]  velocityInWorld_m_per_s
+    /// \param[in]  propWash_m_per_s
+    /// \param[in]  controlAngle_rad
+    /// \return     Force in body
+    ///
+    ignition::math::Vector3d updateForcesInBody_N(
+        const ignition::math::Matrix3d &worldToBody,
+        ignition::math::Vector3d velocityInWorld_m_per_s,
+        double propWash_m_per_s,
+        double controlAngle_rad) {
+        return updateForcesInBodyAtDensity_N(worldToBody, velocityInWorld_m_per_s, propWash_m_per_s, controlAngle_rad,
+                                             _environment->get_air_density_kg_per_m3());
+    }
+
+    ///
+    /// \brief      Updates the model with a velocity and a rotation of the world into the body, in the air of a
+    ///             snapshot taken for the step rather than of the environment.
+    /// \param[in]  environment (State of the air)
+    /// \param[in]  worldToBody
+    /// \param[in]  velocityInWorld_m_per_s
+    /// \param[in]  propWash_m_per_s
+    /// \param[in]  controlAngle_rad
+    /// \return     Force in body
+    ///
+    ignition::math::Vector3d updateForcesInBody_N(
+        const EnvironmentSnapshot &environment,
+        const ignition::math::Matrix3d &worldToBody,
+        const ignition::math::Vector3d &velocityInWorld_m_per_s,
+        double propWash_m_per_s,
+        double controlAngle_rad) {
+        return updateForcesInBodyAtDensity_N(worldToBody, velocityInWorld_m_per_s, propWash_m_per_s, controlAngle_rad,
+                                             environment.airDensity_kg_per_m3);
+    }
+
+    ///
+    /// \brief      Updates the model as updateForcesInBody_N() and calculates the resultant moment in the same pass.
+    ///
+    /// \details    The force is exactly that of updateForcesInBody_N(). The moment, about the origin of the body, is
+    ///             that of the force at the center of pressure, plus the pitching moment of the airfoil about the
+    ///             port vector, from the same lookup of its polar and the same dynamic pressure.
+    /// \param[in]  poseInWorld_m_rad
+    /// \param[in]  velocityInWorld_m_per_s
+    /// \param[in]  propWash_m_per_s
+    /// \param[in]  controlAngle_rad
+    /// \return     Force and moment in body
+    ///
+    AeroWrench updateWrenchInBody(
+        const ignition::math::Pose3d &poseInWorld_m_rad,
+        const ignition::math::Vector3d &velocityInWorld_m_per_s,
+        double propWash_m_per_s,
+        double controlAngle_rad) {
+        AeroWrench wrench;
+        wrench.force_N = updateForcesInBodyAtDensity_N(poseInWorld_m_rad, velocityInWorld_m_per_s, propWash_m_per_s,
+                         controlAngle_rad, _environment->get_air_density_kg_per_m3(), &wrench.moment_N_m);
+        return wrench;
+    }
+
+    ///
+    /// \brief      Updates the model as updateWrenchInBody(), in the air of a snapshot taken for the step.
+    ///
+    AeroWrench updateWrenchInBody(
+        const EnvironmentSnapshot &environment,
+        const ignition::math::Pose3d &poseInWorld_m_rad,
+        const ignition::math::Vector3d &velocityInWorld_m_per_s,
+        double propWash_m_per_s,
+        double controlAngle_rad) {
+        AeroWrench wrench;
+        wrench.force_N = updateForcesInBodyAtDensity_N(poseInWorld_m_rad, velocityInWorld_m_per_s, propWash_m_per_s,
+                         controlAngle_rad, environment.airDensity_kg_per_m3, &wrench.moment_N_m);
+        return wrench;
+    }
+
+    ///
+    /// \brief      Updates the model as updateWrenchInBody(), from a rotation of the world into the body.
+    ///
+    AeroWrench updateWrenchInBody(
+        const ignition::math::Matrix3d &worldToBody,
+        const ignition::math::Vector3d &velocityInWorld_m_per_s,
+        double propWash_m_per_s,
+        double controlAngle_rad) {
+        AeroWrench wrench;
+        wrench.force_N = updateForcesInBodyAtDensity_N(worldToBody, velocityInWorld_m_per_s, propWash_m_per_s,
+                         controlAngle_rad, _environment->get_air_density_kg_per_m3(), &wrench.moment_N_m);
+        return wrench;
+    }
+
+    ///
+    /// \brief      Updates the model as updateWrenchInBody(), from a rotation of the world into the body, in the air
+    ///             of a snapshot taken for the step.
+    ///
+    AeroWrench updateWrenchInBody(
+        const EnvironmentSnapshot &environment,
+        const ignition::math::Matrix3d &worldToBody,
+        const ignition::math::Vector3d &velocityInWorld_m_per_s,
+        double propWash_m_per_s,
+        double controlAngle_rad) {
+        AeroWrench wrench;
+        wrench.force_N = updateForcesInBodyAtDensity_N(worldToBody, velocityInWorld_m_per_s, propWash_m_per_s,
+                         controlAngle_rad, environment.airDensity_kg_per_m3, &wrench.moment_N_m);
+        return wrench;
+    }
+
+    ///
+    /// \brief      Updates the model with a batch of poses and velocities and calculates the resultant forces of each.
+    ///
+    /// \details    Gives the forces, and leaves the state, of calling updateForcesInBody_N() on each pose in turn. Only
+    ///             the last element keeps the state, though, and all share a single read of the air density. Allocates
+    ///             nothing.
+    /// \param[in]  posesInWorld_m_rad
+    /// \param[in]  velocitiesInWorld_m_per_s
+    /// \param[in]  propWashes_m_per_s
+    /// \param[in]  controlAngles_rad
+    /// \param[in]  count (Number of elements of each array)
+    /// \param[out] forcesInBody_N
+    /// \return     N/A
+    ///
+    void updateForcesInBody_N(
+        const ignition::math::Pose3d *posesInWorld_m_rad,
+        const ignition::math::Vector3d *velocitiesInWorld_m_per_s,
+        const double *propWashes_m_per_s,
+        const double *controlAngles_rad,
+        std::size_t count,
+        ignition::math::Vector3d *forcesInBody_N) {
+        if (count == 0) {
+            return;
+        }
+
+        double airDensity_kg_per_m3 = _environment->get_air_density_kg_per_m3();
+
+        for (std::size_t i = 0; i + 1 < count; i++) {
+            ignition::math::Vector3d velocityInBody_m_per_s = transformToLocalVelocity(posesInWorld_m_rad[i],
+                    velocitiesInWorld_m_per_s[i]);
+            double planarVelocity_m_per_s;
+            double lateralVelocity_m_per_s;
+            double angleOfAttack_rad;
+            double sideSlipAngle_rad;
+
+            resolveFlow(_bodyToSurface, _angleMath, velocityInBody_m_per_s, propWashes_m_per_s[i],
+                        controlAngles_rad[i], &planarVelocity_m_per_s, &lateralVelocity_m_per_s, &angleOfAttack_rad,
+                        &sideSlipAngle_rad);
+
+            forcesInBody_N[i] = calculateForcesInBody_N(planarVelocity_m_per_s, lateralVelocity_m_per_s,
+                                RAD2DEG(angleOfAttack_rad), angleOfAttack_rad, RAD2DEG(sideSlipAngle_rad),
+                                airDensity_kg_per_m3, STATE_CAPTURE_NONE);
+        }
+
+        // The last one updates the state, as it would have been left by updating with each in turn.
+        std::size_t last = count - 1;
+        forcesInBody_N[last] = updateForcesInBodyAtDensity_N(
+                                   posesInWorld_m_rad[last],
+                                   velocitiesInWorld_m_per_s[last],
+                                   propWashes_m_per_s[last],
+                                   controlAngles_rad[last],
+                                   airDensity_kg_per_m3);
+    }
+
+    ///
+    /// \brief      Selects how much of the state later updates keep.
+    ///
+    /// \details    The forces calculated are the same at every level. Fields a level does not keep are reset to those
+    ///             of a new AerodynamicState here and stay so.
+    /// \param[in]  capture
+    /// \return     N/A
+    ///
+    void setStateCapture(StateCapture capture) {
+        if (capture != _stateCapture) {
+            _state = AerodynamicState();
+        }
+
+        _stateCapture = capture;
+    }
+
+    StateCapture getStateCapture() const {
+        return _stateCapture;
+    }
+
+    ///
+    /// \brief      Gets the state of the last update, as far as the capture level keeps it.
+    ///
+    AerodynamicState getState() const {
+        return _state;
+    }
+
+    ///
+    /// \brief      Selects how later updates take the angles of attack and side slip from the velocity.
+    /// \param[in]  angleMath
+    /// \return     N/A
+    ///
+    void setAngleMath(AngleMath angleMath) {
+        _angleMath = angleMath;
+    }
+
+    AngleMath getAngleMath() const {
+        return _angleMath;
+    }
+
+    double calculateAttackAngleWithControl(
+        double controlAngle_rad,
+        double angleOfAttackBody_deg,
+        double planarVelocity_m_per_s) {
+
+        double angleOfAttack_deg = angleOfAttackBody_deg + RAD2DEG(controlAngle_rad);
+
+        if (planarVelocity_m_per_s < 0) {
+            double alphaInNominal_deg = angleOfAttackBody_deg -
+                                        RAD2DEG(M_PI) *  ignition::math::sgn(angleOfAttackBody_deg);
+            double combinedNominal_deg = alphaInNominal_deg + RAD2DEG(controlAngle_rad);
+
+            angleOfAttack_deg = combinedNominal_deg - RAD2DEG(M_PI) *  ignition::math::sgn(combinedNominal_deg);
+        }
+
+        return angleOfAttack_deg;
+    }
+
+    // Function to calculate dynamic pressure.
+    ///
+    /// \brief      Calculates dynamic pressure (q)
+    ///
+    /// \details    Call this function once speed and rho have been set.
+    /// \param[in]  N/A
+    /// \return     N/A
+    double calculateDynamicPressure_Pa(double velocity_m_per_s) {
+        return 0.5 * _environment->get_air_density_kg_per_m3() * velocity_m_per_s * velocity_m_per_s;
+    }
+
+    ///
+    /// \brief      Calculates dynamic pressure (q) in the air of a snapshot rather than of the environment.
+    /// \param[in]  velocity_m_per_s
+    /// \param[in]  environment (State of the air)
+    /// \return     Dynamic pressure
+    ///
+    double calculateDynamicPressure_Pa(double velocity_m_per_s, const EnvironmentSnapshot &environment) {
+        return 0.5 * environment.airDensity_kg_per_m3 * velocity_m_per_s * velocity_m_per_s;
+    }
+
+    ///
+    /// \brief Sets the basis vectors from only the fwd and upward vectors
+    ///
+    /// \details    N/A
+    /// \param[in]  forward Vector3d representing forward vector
+    /// \param[in]  upward Vector3d representing upward vector
+    /// \return     N/A
+    ///
+    void setBasisVectors(
+        ignition::math::Vector3d forward,
+        ignition::math::Vector3d upward) {
+        vecFwd = forward;
+        vecUpwd = upward;
+
+        // Eliminate any NaN values.
+        vecFwd.Correct();
+        vecUpwd.Correct();
+
+        vecPort =  vecFwd.Cross(vecUpwd);
+
+        _bodyToSurface = ignition::math::Matrix3d(
+                             vecUpwd.X(), vecUpwd.Y(), vecUpwd.Z(),
+                             vecFwd.X(), vecFwd.Y(), vecFwd.Z(),
+                             vecPort.X(), vecPort.Y(), vecPort.Z());
+        _surfaceToBody = _bodyToSurface.Transposed();
+    }
+
+    ///
+    /// \brief      Sets where the forces of the airfoil act, for the moments of updateWrenchInBody().
+    /// \param[in]  centerOfPressureInBody_m (Center of pressure, from the origin of the body, in body)
+    /// \return     N/A
+    ///
+    void setCenterOfPressure(const ignition::math::Vector3d &centerOfPressureInBody_m) {
+        _centerOfPressure_m = centerOfPressureInBody_m;
+    }
+
+    ignition::math::Vector3d getCenterOfPressure() const {
+        return _centerOfPressure_m;
+    }
+
+    ignition::math::Vector3d transformToLocalVelocity(
+        ignition::math::Pose3d poseInWorld_m_rad,
+        ignition::math::Vector3d velocityInWorld_m_per_s) {
+
+        ignition::math::Vector3d velocityInBody_m_per_s;
+
+        avionics_sim::Coordinate_Utils::project_vector_global(
+            poseInWorld_m_rad,
+            velocityInWorld_m_per_s,
+            &velocityInBody_m_per_s);
+
+        return velocityInBody_m_per_s;
+    }
+
+    ignition::math::Vector3d transformToLocalVelocity(
+        const ignition::math::Matrix3d &worldToBody,
+        const ignition::math::Vector3d &velocityInWorld_m_per_s) {
+        return worldToBody * velocityInWorld_m_per_s;
+    }
+
+    static double transformBodyToWindPlanar(ignition::math::Vector3d velocityInBody_m_per_s) {
+        ignition::math::Vector3d planarVelocity_m_per_s = ignition::math::Vector3d(
+                    velocityInBody_m_per_s.X(),
+                    0,
+                    velocityInBody_m_per_s.Z());
+
+        float directionInBody = ignition::math::sgn(velocityInBody_m_per_s.Z());
+
+        return directionInBody * planarVelocity_m_per_s.Length();
+    }
+
+    static double transformBodyToWindLateral(ignition::math::Vector3d velocityInBody_m_per_s) {
+        return -velocityInBody_m_per_s.Y();
+    }
+
+    // Function to calculate lift.
+    ///
+    /// \brief      Calculates value of lift.
+    ///
+    /// \details    N/A
+    /// \param[in]  N/A
+    /// \return     Value for lift.
+    double calculateLift_N(double liftCoefficient, double dynamicPressure_Pa) {
+        return liftCoefficient * dynamicPressure_Pa * _airfoil.getArea_m2();
+    }
+
+    // Function to calculate drag.
+    ///
+    /// \brief      Calculates value of drag.
+    ///
+    /// \details    N/A
+    /// \param[in]  N/A
+    /// \return     Value for drag.
+    double calculateDrag_N(double dragCoefficient, double dynamicPressure_Pa) {
+        return dragCoefficient * dynamicPressure_Pa * _airfoil.getArea_m2();
+    }
+
+    // Function to calculate lateral force.
+    ///
+    /// \brief      Calculates lateral force.
+    ///
+    /// \details    N/A
+    /// \param[in]  N/A
+    /// \return     Value for lift.
+    double calculateLateralForce_N(double lateralDragCoefficient, double dynamicPressureLateral_Pa) {
+        return dynamicPressureLateral_Pa * lateralDragCoefficient * _airfoil.getLateralArea_m2();
+    }
+
+    ///
+    /// /brief Calculates alpha and beta angles from wing pose and world velocity.
+    ///
+    /// \details    N/A
+    /// \param[in]  N/A
+    /// \return     N/A
+    ///
+    AeroAngles calculateBodyAttackAngles_deg(ignition::math::Vector3d velocityInBody_m_per_s) {
+        double angleOfAttack_rad;
+        double sideSlipAngle_rad;
+
+        calculateBodyAttackAngles_rad(_bodyToSurface, _angleMath, velocityInBody_m_per_s, &angleOfAttack_rad,
+                                      &sideSlipAngle_rad);
+
+        AeroAngles attackAngles_deg = {RAD2DEG(angleOfAttack_rad), RAD2DEG(sideSlipAngle_rad)};
+        return attackAngles_deg;
+    }
+
+    ///
+    /// \brief      Function to calculate force vector with direction.
+    ///
+    /// \details    N/A
+    /// \param[in]  lift_N
+    /// \param[in]  drag_N
+    /// \param[in]  lateralForce_N
+    /// \param[in]  angleOfAttack_deg,
+    /// \param[in]  sideSlipAngle_deg,
+    /// \return     N/A
+    ///
+    ignition::math::Vector3d rotateForcesToBody(
+        double lift_N, double drag_N, double lateralForce_N,
+        double angleOfAttack_deg, double sideSlipAngle_deg) {
+        return rotateForcesToBody_rad(lift_N, drag_N, lateralForce_N, DEG2RAD(angleOfAttack_deg),
+                                      ignition::math::sgn(sideSlipAngle_deg));
+    }
+
+    double invertAttackAngle_deg(double angleOfAttack_deg) {
+        return angleOfAttack_deg - RAD2DEG(M_PI) *  ignition::math::sgn(angleOfAttack_deg);
+    }
+
+    AeroAngles correctAttackAnglesForDirectionAndControl_deg(
+        AeroAngles bodyAttackAngles_deg,
+        double controlAngle_rad,
+        double planarVelocity_m_per_s) {
+
+        AeroAngles attackAngles_deg = bodyAttackAngles_deg;
+
+        if (planarVelocity_m_per_s < 0) {
+            attackAngles_deg.attackAngle_deg = invertAttackAngle_deg(bodyAttackAngles_deg.attackAngle_deg);
+        }
+
+        attackAngles_deg.attackAngle_deg = RAD2DEG(controlAngle_rad) + attackAngles_deg.attackAngle_deg;
+
+        if (planarVelocity_m_per_s < 0) {
+            attackAngles_deg.attackAngle_deg = invertAttackAngle_deg(attackAngles_deg.attackAngle_deg);
+        }
+
+        return attackAngles_deg;
+    }
+
+    ///
+    /// \brief      Takes the angles of calculateBodyAttackAngles_deg() in radians.
+    /// \param[in]  bodyToSurface (Rotation of the body into the surface, whose rows are its upward, forward and port
+    ///             vectors)
+    /// \param[in]  angleMath (How the angles are taken)
+    /// \param[in]  velocityInBody_m_per_s
+    /// \param[out] angleOfAttack_rad
+    /// \param[out] sideSlipAngle_rad
+    /// \return     N/A
+    ///
+    static void calculateBodyAttackAngles_rad(const ignition::math::Matrix3d &bodyToSurface, AngleMath angleMath,
+            const ignition::math::Vector3d &velocityInBody_m_per_s, double *angleOfAttack_rad,
+            double *sideSlipAngle_rad) {
+        // Calculate velocity in each direction, along the upward, forward and port vectors.
+        ignition::math::Vector3d velocityInSurface_m_per_s = bodyToSurface * velocityInBody_m_per_s;
+        double u = velocityInSurface_m_per_s.X();
+        double v = velocityInSurface_m_per_s.Z();
+        double w = velocityInSurface_m_per_s.Y();
+
+        if (angleMath == ANGLE_MATH_FAST) {
+            *angleOfAttack_rad = Math_util::fast_atan2(-u, w);
+            *sideSlipAngle_rad = Math_util::fast_asin(-v / velocityInBody_m_per_s.Length());
+        } else {
+            *angleOfAttack_rad = atan2(-u, w);
+            *sideSlipAngle_rad = asin(-v / velocityInBody_m_per_s.Length());
+        }
+    }
+
+    ///
+    /// \brief      Resolves the flow over an airfoil, as the first steps of updateForcesInBody_N() after transforming
+    ///             the velocity.
+    /// \details    Static, so that AerodynamicSurfaceSet resolves the flow over its surfaces the same way.
+    /// \param[in]  bodyToSurface (Rotation of the body into the surface, whose rows are its upward, forward and port
+    ///             vectors)
+    /// \param[in]  angleMath (How the angles are taken)
+    /// \param[in]  velocityInBody_m_per_s
+    /// \param[in]  propWash_m_per_s
+    /// \param[in]  controlAngle_rad
+    /// \param[out] planarVelocity_m_per_s
+    /// \param[out] lateralVelocity_m_per_s
+    /// \param[out] angleOfAttack_rad (Corrected for the direction of the flow and the control angle)
+    /// \param[out] sideSlipAngle_rad
+    /// \return     N/A
+    ///
+    static void resolveFlow(
+        const ignition::math::Matrix3d &bodyToSurface,
+        AngleMath angleMath,
+        const ignition::math::Vector3d &velocityInBody_m_per_s,
+        double propWash_m_per_s,
+        double controlAngle_rad,
+        double *planarVelocity_m_per_s,
+        double *lateralVelocity_m_per_s,
+        double *angleOfAttack_rad,
+        double *sideSlipAngle_rad) {
+        double planar_m_per_s = transformBodyToWindPlanar(velocityInBody_m_per_s);
+        double lateral_m_per_s = transformBodyToWindLateral(velocityInBody_m_per_s);
+
+        double attackAngle_rad;
+        double sideSlip_rad;
+
+        calculateBodyAttackAngles_rad(bodyToSurface, angleMath, velocityInBody_m_per_s, &attackAngle_rad,
+                                      &sideSlip_rad);
+
+        bool isPropWashDominating = false;
+
+        if (propWash_m_per_s > planar_m_per_s) {
+            planar_m_per_s = std::min(propWash_m_per_s, planar_m_per_s + propWash_m_per_s);
+
+            isPropWashDominating = (planar_m_per_s > 0);
+        }
+
+        if (isPropWashDominating) {
+            lateral_m_per_s = 0;
+            attackAngle_rad = 0;
+            sideSlip_rad = 0;
+        }
+
+        // As correctAttackAnglesForDirectionAndControl_deg(), without leaving radians.
+        if (planar_m_per_s < 0) {
+            attackAngle_rad = attackAngle_rad - M_PI * ignition::math::sgn(attackAngle_rad);
+        }
+
+        attackAngle_rad = controlAngle_rad + attackAngle_rad;
+
+        if (planar_m_per_s < 0) {
+            attackAngle_rad = attackAngle_rad - M_PI * ignition::math::sgn(attackAngle_rad);
+        }
+
+        *planarVelocity_m_per_s = planar_m_per_s;
+        *lateralVelocity_m_per_s = lateral_m_per_s;
+        *angleOfAttack_rad = attackAngle_rad;
+        *sideSlipAngle_rad = sideSlip_rad;
+    }
+
+  protected:
+    ///
+    /// \brief      Calculates the forces of a resolved flow as the update from the planar and lateral velocities and
+    ///             angles, with the angle of attack in radians too, which the forces are rotated by.
+    /// \param[in]  planarVelocity_m_per_s
+    /// \param[in]  lateralVelocity_m_per_s
+    /// \param[in]  angleOfAttack_deg
+    /// \param[in]  angleOfAttack_rad
+    /// \param[in]  sideSlipAngle_deg
+    /// \return     Force in body
+    ///
+    ignition::math::Vector3d updateForcesInBodyFromFlow_N(
+        double planarVelocity_m_per_s,
+        double lateralVelocity_m_per_s,
+        double angleOfAttack_deg,
+        double angleOfAttack_rad,
+        double sideSlipAngle_deg) {
+        return calculateForcesInBody_N(
+                   planarVelocity_m_per_s,
+                   lateralVelocity_m_per_s,
+                   angleOfAttack_deg,
+                   angleOfAttack_rad,
+                   sideSlipAngle_deg,
+                   _environment->get_air_density_kg_per_m3(),
+                   _stateCapture);
+    }
+
+    ///
+    /// \brief      Resolves the flow of an update from a pose, as the first steps of updateForcesInBody_N(), keeping
+    ///             the pose and velocities in the state as selected by setStateCapture().
+    /// \details    Lets a subclass take the rest of the update elsewhere, from the outputs of resolveFlow().
+    /// \param[in]  poseInWorld_m_rad
+    /// \param[in]  velocityInWorld_m_per_s
+    /// \param[in]  propWash_m_per_s
+    /// \param[in]  controlAngle_rad
+    /// \param[out] planarVelocity_m_per_s
+    /// \param[out] lateralVelocity_m_per_s
+    /// \param[out] angleOfAttack_rad (Corrected for the direction of the flow and the control angle)
+    /// \param[out] sideSlipAngle_rad
+    /// \return     N/A
+    ///
+    void resolveFlowFromPose(
+        const ignition::math::Pose3d &poseInWorld_m_rad,
+        const ignition::math::Vector3d &velocityInWorld_m_per_s,
+        double propWash_m_per_s,
+        double controlAngle_rad,
+        double *planarVelocity_m_per_s,
+        double *lateralVelocity_m_per_s,
+        double *angleOfAttack_rad,
+        double *sideSlipAngle_rad) {
+        if (_stateCapture == STATE_CAPTURE_FULL) {
+            _state = AerodynamicState();
+            _state.poseWorld_m_rad = poseInWorld_m_rad;
+            _state.velocityWorld_m_per_s = velocityInWorld_m_per_s;
+        }
+
+        ignition::math::Vector3d velocityInBody_m_per_s = transformToLocalVelocity(poseInWorld_m_rad,
+                velocityInWorld_m_per_s);
+
+        resolveFlowFromBody(velocityInBody_m_per_s, propWash_m_per_s, controlAngle_rad, planarVelocity_m_per_s,
+                            lateralVelocity_m_per_s, angleOfAttack_rad, sideSlipAngle_rad);
+    }
+
+    ///
+    /// \brief      Calculates the force of a resolved flow, as the last steps of updateForcesInBody_N().
+    /// \details    The angle of attack is taken in degrees to look up the airfoil, and in radians to rotate the forces,
+    ///             so that neither is converted back from the other.
+    /// \param[in]  planarVelocity_m_per_s
+    /// \param[in]  lateralVelocity_m_per_s
+    /// \param[in]  angleOfAttack_deg
+    /// \param[in]  angleOfAttack_rad
+    /// \param[in]  sideSlipAngle_deg
+    /// \param[in]  airDensity_kg_per_m3
+    /// \param[in]  capture (How much of the state to keep)
+    /// \param[out] moment_N_m (Moment in body, as updateWrenchInBody(), or null for the force alone)
+    /// \return     Force in body
+    ///
+    ignition::math::Vector3d calculateForcesInBody_N(
+        double planarVelocity_m_per_s,
+        double lateralVelocity_m_per_s,
+        double angleOfAttack_deg,
+        double angleOfAttack_rad,
+        double sideSlipAngle_deg,
+        double airDensity_kg_per_m3,
+        StateCapture capture,
+        ignition::math::Vector3d *moment_N_m = nullptr) {
+        double dynamicPressurePlanar_Pa = 0.5 * airDensity_kg_per_m3 * planarVelocity_m_per_s * planarVelocity_m_per_s;
+        double dynamicPressureLateral_Pa = 0.5 * airDensity_kg_per_m3 * lateralVelocity_m_per_s *
+                                           lateralVelocity_m_per_s;
+
+        AeroCoefficients coefficients = moment_N_m ? _airfoil.calculateCoefficientsWithMoment(angleOfAttack_deg) :
+                                        _airfoil.calculateCoefficients(angleOfAttack_deg);
+        double lateralDragCoeff = _airfoil.calculateSideSlipCoefficient(sideSlipAngle_deg);
+
+        double lift_N = calculateLift_N(coefficients.lift, dynamicPressurePlanar_Pa);
+        double drag_N = calculateDrag_N(coefficients.drag, dynamicPressurePlanar_Pa);
+        double lateralForce_N = calculateLateralForce_N(lateralDragCoeff, dynamicPressureLateral_Pa);
+
+        ignition::math::Vector3d force_N = rotateForcesToBody_rad(
+                                               lift_N, drag_N, lateralForce_N,
+                                               angleOfAttack_rad, ignition::math::sgn(sideSlipAngle_deg));
+
+        if (moment_N_m) {
+            // The force acts at the center of pressure, and the airfoil pitches about the port vector.
+            double pitchingMoment_N_m = coefficients.moment * dynamicPressurePlanar_Pa * _airfoil.getArea_m2() *
+                                        _airfoil.getChord_m();
+
+            *moment_N_m = _centerOfPressure_m.Cross(force_N) + vecPort * pitchingMoment_N_m;
+        }
+
+        if (capture == STATE_CAPTURE_FULL) {
+            _state.angleOfAttack_deg = angleOfAttack_deg;
+            _state.sideSlipAngle_deg = sideSlipAngle_deg;
+
+            _state.planarVelocity_m_per_s = planarVelocity_m_per_s;
+            _state.lateralVelocity_m_per_s = lateralVelocity_m_per_s;
+
+            _state.dynamicPressurePlanar_Pa = dynamicPressurePlanar_Pa;
+            _state.dynamicPressureLateral_Pa = dynamicPressureLateral_Pa;
+
+            _state.liftCoeff = coefficients.lift;
+            _state.dragCoeff = coefficients.drag;
+            _state.lateralDragCoeff = lateralDragCoeff;
+            _state.momentCoeff = coefficients.moment;
+        }
+
+        if (capture != STATE_CAPTURE_NONE) {
+            _state.lift_N = lift_N;
+            _state.drag_N = drag_N;
+            _state.lateralForce_N = lateralForce_N;
+            _state.force_N = force_N;
+            _state.moment_N_m = moment_N_m ? *moment_N_m : ignition::math::Vector3d::Zero;
+        }
+
+        return force_N;
+    }
+
+  private:
+    ///
+    /// \brief      Updates the model from a pose, as updateForcesInBody_N() does once it has the air density.
+    /// \details    Calculates the moment too, as updateWrenchInBody(), unless moment_N_m is null.
+    ///
+    ignition::math::Vector3d updateForcesInBodyAtDensity_N(
+        const ignition::math::Pose3d &poseInWorld_m_rad,
+        const ignition::math::Vector3d &velocityInWorld_m_per_s,
+        double propWash_m_per_s,
+        double controlAngle_rad,
+        double airDensity_kg_per_m3,
+        ignition::math::Vector3d *moment_N_m = nullptr) {
+        double planarVelocity_m_per_s;
+        double lateralVelocity_m_per_s;
+        double angleOfAttack_rad;
+        double sideSlipAngle_rad;
+
+        resolveFlowFromPose(poseInWorld_m_rad, velocityInWorld_m_per_s, propWash_m_per_s, controlAngle_rad,
+                            &planarVelocity_m_per_s, &lateralVelocity_m_per_s, &angleOfAttack_rad, &sideSlipAngle_rad);
+
+        return calculateForcesInBody_N(
+                   planarVelocity_m_per_s,
+                   lateralVelocity_m_per_s,
+                   RAD2DEG(angleOfAttack_rad),
+                   angleOfAttack_rad,
+                   RAD2DEG(sideSlipAngle_rad),
+                   airDensity_kg_per_m3,
+                   _stateCapture,
+                   moment_N_m);
+    }
+
+    /// \brief Updates the model from a rotation, as the update from a pose above.
+    ignition::math::Vector3d updateForcesInBodyAtDensity_N(
+        const ignition::math::Matrix3d &worldToBody,
+        const ignition::math::Vector3d &velocityInWorld_m_per_s,
+        double propWash_m_per_s,
+        double controlAngle_rad,
+        double airDensity_kg_per_m3,
+        ignition::math::Vector3d *moment_N_m = nullptr) {
+        if (_stateCapture == STATE_CAPTURE_FULL) {
+            _state = AerodynamicState();
+            _state.velocityWorld_m_per_s = velocityInWorld_m_per_s;
+        }
+
+        ignition::math::Vector3d velocityInBody_m_per_s = transformToLocalVelocity(worldToBody,
+                velocityInWorld_m_per_s);
+
+        double planarVelocity_m_per_s;
+        double lateralVelocity_m_per_s;
+        double angleOfAttack_rad;
+        double sideSlipAngle_rad;
+
+        resolveFlowFromBody(velocityInBody_m_per_s, propWash_m_per_s, controlAngle_rad, &planarVelocity_m_per_s,
+                            &lateralVelocity_m_per_s, &angleOfAttack_rad, &sideSlipAngle_rad);
+
+        return calculateForcesInBody_N(
+                   planarVelocity_m_per_s,
+                   lateralVelocity_m_per_s,
+                   RAD2DEG(angleOfAttack_rad),
+                   angleOfAttack_rad,
+                   RAD2DEG(sideSlipAngle_rad),
+                   airDensity_kg_per_m3,
+                   _stateCapture,
+                   moment_N_m);
+    }
+
+    /// \brief Resolves the flow from the velocity in body onwards, keeping that velocity in the state.
+    void resolveFlowFromBody(
+        const ignition::math::Vector3d &velocityInBody_m_per_s,
+        double propWash_m_per_s,
+        double controlAngle_rad,
+        double *planarVelocity_m_per_s,
+        double *lateralVelocity_m_per_s,
+        double *angleOfAttack_rad,
+        double *sideSlipAngle_rad) {
+        resolveFlow(_bodyToSurface, _angleMath, velocityInBody_m_per_s, propWash_m_per_s, controlAngle_rad,
+                    planarVelocity_m_per_s, lateralVelocity_m_per_s, angleOfAttack_rad, sideSlipAngle_rad);
+
+        if (_stateCapture == STATE_CAPTURE_FULL) {
+            _state.velocityBody_m_per_s = velocityInBody_m_per_s;
+        }
+    }
+
+    /// \brief As rotateForcesToBody(), from the angle of attack in radians and the sign of the side slip angle.
+    ignition::math::Vector3d rotateForcesToBody_rad(double lift_N, double drag_N, double lateralForce_N,
+            double angleOfAttack_rad, double lateralDirection) {
+        // Computed together, as a single sincos.
+        double sinAttackAngle = sin(angleOfAttack_rad);
+        double cosAttackAngle = cos(angleOfAttack_rad);
+
+        double rotated_lift_N = (lift_N * cosAttackAngle) + (drag_N * sinAttackAngle);
+        double rotated_drag_N = (lift_N * sinAttackAngle) - (drag_N * cosAttackAngle);
+
+        double oriented_lateral_N = lateralDirection * lateralForce_N;
+
+        // Add the forces together, as rotated_lift_N * vecUpwd + rotated_drag_N * vecFwd
+        // + oriented_lateral_N * vecPort.
+        ignition::math::Vector3d force_N =
+            _surfaceToBody * ignition::math::Vector3d(rotated_lift_N, rotated_drag_N, oriented_lateral_N);
+
+        return force_N;
+    }
+
+    /// \brief Forward vector
+    ignition::math::Vector3d vecFwd;
+
+    /// \brief Upward vector
+    ignition::math::Vector3d vecUpwd;
+
+    /// \brief Port vector
+    ignition::math::Vector3d vecPort;
+
+    /// \brief Rotation of the body into the surface, whose rows are vecUpwd, vecFwd and vecPort
+    ignition::math::Matrix3d _bodyToSurface;
+
+    /// \brief Rotation of the surface into the body, the transpose of _bodyToSurface
+    ignition::math::Matrix3d _surfaceToBody;
+
+    /// \brief Center of pressure, from the origin of the body, in body
+    ignition::math::Vector3d _centerOfPressure_m;
+
+    Polar _airfoil;
+
+    AerodynamicState _state;
+
+    StateCapture _stateCapture;
+
+    AngleMath _angleMath;
+
+    Environment *_environment;
+};
+
+}  // namespace avionics_sim
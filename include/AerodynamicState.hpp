@@ -50,12 +50,16 @@ class AerodynamicState {
     Property <double> liftCoeff;
     Property <double> dragCoeff;
     Property <double> lateralDragCoeff;
+    Property <double> momentCoeff;
 
     Property <double> lift_N;
     Property <double> drag_N;
     Property <double> lateralForce_N;
 
     Property <ignition::math::Vector3d> force_N;
+
+    /// \brief Moment about the origin of the body, left zero by updates of the forces alone
+    Property <ignition::math::Vector3d> moment_N_m;
 };
 
 }  // namespace avionics_sim
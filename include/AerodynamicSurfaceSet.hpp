@@ -0,0 +1,143 @@
+/**
+ * @brief       AerodynamicSurfaceSet
+ * @file        AerodynamicSurfaceSet.hpp
+ * @copyright   Copyright (c) 2021, Swift Engineering Inc.
+ * @license     Licensed under the MIT license. See LICENSE for details.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <ignition/math.hh>
+#include "AerodynamicModelT.hpp"
+#include "Airfoil.hpp"
+#include "EnvironmentSnapshot.hpp"
+#include "IPhysicsEnvironment.hpp"
+
+namespace avionics_sim {
+
+///
+/// \brief      Aerodynamic surfaces of a vehicle, updated together.
+///
+/// \details    Holds what an AerodynamicModel holds for each surface, but by field rather than by surface: the basis
+///             vectors and areas of every surface are in arrays of their own, alongside the airfoils whose tables they
+///             look up. updateForcesInBody_N() then takes the whole vehicle in a few passes over those arrays, with no
+///             virtual call or AerodynamicState per surface, and its force assembly runs over plain arrays of doubles
+///             the compiler can vectorize. The flow over each surface is resolved by AerodynamicModelT::resolveFlow(),
+///             as in the model.
+///
+///             Each force is exactly, bit for bit, the one AerodynamicModel::updateForcesInBody_N() returns for the
+///             same airfoil, basis vectors, environment and inputs, when the model takes its angles as the set does.
+///
+class AerodynamicSurfaceSet {
+  public:
+    ///
+    /// \brief      Constructor
+    /// \param[in]  environment (Environment of the vehicle, which must outlive the set)
+    ///
+    explicit AerodynamicSurfaceSet(IPhysicsEnvironment &environment);
+
+    ///
+    /// \brief      Adds a surface to the set.
+    /// \details    The basis vectors are taken as by AerodynamicModel::setBasisVectors().
+    /// \param[in]  airfoil
+    /// \param[in]  forward Vector3d representing forward vector
+    /// \param[in]  upward Vector3d representing upward vector
+    /// \return     Index of the surface, in the order surfaces were added
+    ///
+    std::size_t addSurface(Airfoil airfoil, ignition::math::Vector3d forward, ignition::math::Vector3d upward);
+
+    ///
+    /// \brief      Gets the number of surfaces in the set.
+    ///
+    std::size_t size() const;
+
+    ///
+    /// \brief      Gets the airfoil of a surface, to read its telemetry.
+    /// \param[in]  surface (Index of the surface)
+    ///
+    Airfoil &getAirfoil(std::size_t surface);
+
+    ///
+    /// \brief      Selects how later updates take the angles of every surface, as AerodynamicModelT::setAngleMath().
+    /// \param[in]  angleMath
+    /// \return     N/A
+    ///
+    void setAngleMath(AerodynamicModelOptions::AngleMath angleMath);
+
+    AerodynamicModelOptions::AngleMath getAngleMath() const;
+
+    ///
+    /// \brief      Updates every surface with its pose and velocity and calculates the resultant forces.
+    /// \details    Each array holds one element per surface, in the order surfaces were added. The air density is
+    ///             read from the environment once per call. Allocates nothing.
+    /// \param[in]  posesInWorld_m_rad
+    /// \param[in]  velocitiesInWorld_m_per_s
+    /// \param[in]  propWashes_m_per_s
+    /// \param[in]  controlAngles_rad
+    /// \param[out] forcesInBody_N
+    /// \return     N/A
+    ///
+    void updateForcesInBody_N(
+        const ignition::math::Pose3d *posesInWorld_m_rad,
+        const ignition::math::Vector3d *velocitiesInWorld_m_per_s,
+        const double *propWashes_m_per_s,
+        const double *controlAngles_rad,
+        ignition::math::Vector3d *forcesInBody_N);
+
+    ///
+    /// \brief      Updates every surface as updateForcesInBody_N(), in the air of a snapshot taken for the step rather
+    ///             than of the environment, which is not queried.
+    /// \param[in]  environment (State of the air)
+    /// \param[in]  posesInWorld_m_rad
+    /// \param[in]  velocitiesInWorld_m_per_s
+    /// \param[in]  propWashes_m_per_s
+    /// \param[in]  controlAngles_rad
+    /// \param[out] forcesInBody_N
+    /// \return     N/A
+    ///
+    void updateForcesInBody_N(
+        const EnvironmentSnapshot &environment,
+        const ignition::math::Pose3d *posesInWorld_m_rad,
+        const ignition::math::Vector3d *velocitiesInWorld_m_per_s,
+        const double *propWashes_m_per_s,
+        const double *controlAngles_rad,
+        ignition::math::Vector3d *forcesInBody_N);
+
+  private:
+    /// \brief Updates every surface, as updateForcesInBody_N() does once it has the air density.
+    void updateForcesInBodyAtDensity_N(
+        double airDensity_kg_per_m3,
+        const ignition::math::Pose3d *posesInWorld_m_rad,
+        const ignition::math::Vector3d *velocitiesInWorld_m_per_s,
+        const double *propWashes_m_per_s,
+        const double *controlAngles_rad,
+        ignition::math::Vector3d *forcesInBody_N);
+
+    IPhysicsEnvironment *_environment;
+
+    std::vector<Airfoil> _airfoils;
+
+    /// \brief Components of the forward, upward and port vectors of each surface.
+    std::vector<double> _fwdX, _fwdY, _fwdZ;
+    std::vector<double> _upwdX, _upwdY, _upwdZ;
+    std::vector<double> _portX, _portY, _portZ;
+
+    /// \brief Rotation of the body into each surface, whose rows are its upward, forward and port vectors.
+    std::vector<ignition::math::Matrix3d> _bodyToSurface;
+
+    std::vector<double> _area_m2;
+    std::vector<double> _lateralArea_m2;
+
+    AerodynamicModelOptions::AngleMath _angleMath;
+
+    /// \brief Per surface values of the update in progress, kept between calls to spare allocating them.
+    std::vector<double> _planarVelocity_m_per_s;
+    std::vector<double> _lateralVelocity_m_per_s;
+    std::vector<double> _lateralDirection;
+    std::vector<double> _liftCoeff, _dragCoeff, _lateralDragCoeff;
+    std::vector<double> _cosAttackAngle, _sinAttackAngle;
+};
+
+}  // namespace avionics_sim
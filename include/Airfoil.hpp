@@ -11,6 +11,7 @@
 
 #include <string>
 #include <ignition/math.hh>
+#include "FixedLookupTable.hpp"
 #include "LookupTable.hpp"
 
 namespace avionics_sim {
@@ -19,6 +20,20 @@ namespace avionics_sim {
 static const char _ANGLE_OF_ATTACK_ID[] = "alpha";
 static const char _CL_ID[] = "CL";
 static const char _CD_ID[] = "CD";
+static const char _CM_ID[] = "CM";
+
+struct AeroCoefficients {
+    double lift;
+    double drag;
+    double moment;  ///< Pitching moment, positive nose up, when asked for and the polar has it, else 0.
+};
+
+///
+/// \brief      Fixed airfoil polar, for airframes whose polars never change.
+/// \details    Columns are the angles of attack in degrees, then the lift and drag coefficients.
+///
+template <std::size_t Rows>
+using AirfoilTable = FixedLookupTable<Rows, 3>;
 
 class Airfoil {
   public:
@@ -30,23 +45,238 @@ class Airfoil {
         const std::vector<double> &cls,
         const std::vector<double> &cds);
 
+    ///
+    /// \brief      Constructs an airfoil whose polar has pitching moment coefficients too.
+    /// \details    The pitching moment is taken about the quarter chord, or whichever point the coefficients were
+    ///             measured about, which is then the center of pressure set on the model.
+    /// \param[in]  area_m2
+    /// \param[in]  lateralArea_m2
+    /// \param[in]  chord_m (Reference chord of the pitching moment coefficients)
+    /// \param[in]  angleOfAttacks_deg
+    /// \param[in]  cls
+    /// \param[in]  cds
+    /// \param[in]  cms (Pitching moment coefficients, positive nose up)
+    ///
+    Airfoil(
+        double area_m2,
+        double lateralArea_m2,
+        double chord_m,
+        const std::vector<double> &angleOfAttacks_deg,
+        const std::vector<double> &cls,
+        const std::vector<double> &cds,
+        const std::vector<double> &cms);
+
+    ///
+    /// \brief      Constructs an airfoil whose coefficients are looked up from a fixed polar.
+    /// \details    The polar is used in place rather than copied, so it must outlive the airfoil and any copy of it;
+    ///             it is meant to be a constexpr table at namespace scope. Lookups then need no allocation, hashing or
+    ///             search loop, and give exactly the results of an airfoil constructed from the same values as vectors.
+    /// \param[in]  area_m2
+    /// \param[in]  lateralArea_m2
+    /// \param[in]  table (Polar of the airfoil)
+    ///
+    template <std::size_t Rows>
+    Airfoil(double area_m2, double lateralArea_m2, const AirfoilTable<Rows> &table) :
+        Airfoil() {
+        _area_m2 = area_m2;
+        _lateralArea_m2 = lateralArea_m2;
+        _fixedTable = &table;
+        _fixedCoefficients = &fixedCoefficients<Rows>;
+    }
+
     double calculateLiftCoefficient(double angleOfAttack_deg);
     double calculateDragCoefficient(double angleOfAttack_deg);
+
+    ///
+    /// \brief      Calculates the lift and drag coefficients together.
+    /// \details    Both coefficients are interpolated from a single search of the angle of attack table.
+    /// \param[in]  angleOfAttack_deg
+    /// \return     Lift and drag coefficients
+    ///
+    AeroCoefficients calculateCoefficients(double angleOfAttack_deg);
+
+    ///
+    /// \brief      Calculates the lift, drag and pitching moment coefficients together.
+    /// \details    From the same single search as calculateCoefficients(), whose lift and drag these are exactly. The
+    ///             pitching moment is 0 if the polar has none.
+    /// \param[in]  angleOfAttack_deg
+    /// \return     Lift, drag and pitching moment coefficients
+    ///
+    AeroCoefficients calculateCoefficientsWithMoment(double angleOfAttack_deg);
     double calculateSideSlipCoefficient(double angleOfAttack_deg);
 
     double getArea_m2();
     double getLateralArea_m2();
 
+    ///
+    /// \brief      Gets the reference chord of the pitching moment, which is 0 if the polar has none.
+    ///
+    double getChord_m();
+
+    ///
+    /// \brief      Gets the counts of the angles of attack looked up against the polar.
+    /// \details    Counts each lookup, so calculateCoefficients() counts once where calculateLiftCoefficient() and
+    ///             calculateDragCoefficient() count once each, from a fixed polar as from vectors. Lets how often the
+    ///             airfoil runs off its polar be read at run time.
+    /// \return     Counts since construction or resetTelemetry(), which stay empty when
+    ///             AVIONICS_SIM_INTERP_TELEMETRY is 0
+    ///
+    const Bilinear_interp::Telemetry &getTelemetry() const;
+
+    ///
+    /// \brief      Clears the counts of the angles of attack looked up.
+    ///
+    void resetTelemetry();
+
   protected:
     double _area_m2;
     double _lateralArea_m2;
+    double _chord_m = 0;
     LookupTable _aeroLUT_deg = LookupTable({
         _ANGLE_OF_ATTACK_ID, _CL_ID, _CD_ID
     }, {{0}, {0}, {0}});
 
+    /// \brief Columns of _aeroLUT_deg, resolved once at construction.
+    LookupTable::ColumnHandle _angleOfAttackColumn;
+    LookupTable::ColumnHandle _clColumn;
+    LookupTable::ColumnHandle _cdColumn;
+    LookupTable::ColumnHandle _cmColumn;
+
+    /// \brief Whether _aeroLUT_deg has a pitching moment column, _cmColumn being resolved only if so.
+    bool _hasMomentCoefficients = false;
+
+    /// \brief Where the previous angle of attack lookup landed, as successive lookups on a surface are close together.
+    Bilinear_interp::Cursor _angleOfAttackCursor;
+
+    ///
+    /// \brief      Resolves the column handles of _aeroLUT_deg and resets the cursor.
+    /// \details    Must be called whenever _aeroLUT_deg is (re)assigned.
+    ///
+    void resolveColumns();
+
   private:
+    /// \brief Looks up the coefficients from a fixed polar of Rows rows, passed as table, counting the lookup.
+    template <std::size_t Rows>
+    static AeroCoefficients fixedCoefficients(const void *table, double angleOfAttack_deg,
+            Bilinear_interp::Telemetry *telemetry) {
+        static const std::size_t columns[] = {1, 2};
+        double values[2];
+        const AirfoilTable<Rows> *polar = static_cast<const AirfoilTable<Rows> *>(table);
+
+        telemetry->record(angleOfAttack_deg, polar->columns[0][0], polar->columns[0][Rows - 1]);
+        polar->lookup(angleOfAttack_deg, 0, columns, 2, values);
+
+        AeroCoefficients coefficients = {values[0], values[1], 0.0};
+        return coefficients;
+    }
+
+    /// \brief Fixed polar used in place of _aeroLUT_deg, or null if there is none.
+    const void *_fixedTable;
+
+    /// \brief fixedCoefficients() instantiated for the number of rows of _fixedTable.
+    AeroCoefficients (*_fixedCoefficients)(const void *table, double angleOfAttack_deg,
+                                           Bilinear_interp::Telemetry *telemetry);
+
+    /// \brief Counts of the lookups from _fixedTable, which holds none of its own.
+    Bilinear_interp::Telemetry _fixedTelemetry;
+
     // Until a range of values are provided for coefficient of lateral force, a value of 0.1 will be presumed.
     constexpr static double _sideSlipCoefficient = 0.1;
 };
 
+///
+/// \brief      Airfoil of a fixed polar, whose lookups are defined here so that they inline into AerodynamicModelT.
+/// \details    Gives exactly the coefficients, areas and telemetry of an Airfoil constructed from the same polar, which
+///             is used in place likewise, so must outlive the airfoil and any copy of it.
+///
+template <std::size_t Rows>
+class FixedAirfoil {
+  public:
+    FixedAirfoil() :
+        _area_m2(0),
+        _lateralArea_m2(0),
+        _table(nullptr) {
+    }
+
+    ///
+    /// \brief      Constructor
+    /// \param[in]  area_m2
+    /// \param[in]  lateralArea_m2
+    /// \param[in]  table (Polar of the airfoil)
+    ///
+    FixedAirfoil(double area_m2, double lateralArea_m2, const AirfoilTable<Rows> &table) :
+        _area_m2(area_m2),
+        _lateralArea_m2(lateralArea_m2),
+        _table(&table) {
+    }
+
+    ///
+    /// \brief      Calculates the lift and drag coefficients together, from a single search of the polar.
+    /// \param[in]  angleOfAttack_deg
+    /// \return     Lift and drag coefficients
+    ///
+    AeroCoefficients calculateCoefficients(double angleOfAttack_deg) {
+        static const std::size_t columns[] = {1, 2};
+        double values[2];
+
+        _telemetry.record(angleOfAttack_deg, _table->columns[0][0], _table->columns[0][Rows - 1]);
+        _table->lookup(angleOfAttack_deg, 0, columns, 2, values);
+
+        AeroCoefficients coefficients = {values[0], values[1], 0.0};
+        return coefficients;
+    }
+
+    ///
+    /// \brief      Calculates the coefficients as calculateCoefficients(), as a fixed polar has no pitching moment.
+    ///
+    AeroCoefficients calculateCoefficientsWithMoment(double angleOfAttack_deg) {
+        return calculateCoefficients(angleOfAttack_deg);
+    }
+
+    double calculateSideSlipCoefficient(double sideSlipAngle_deg) {
+        (void)sideSlipAngle_deg;
+        return _sideSlipCoefficient;
+    }
+
+    double getArea_m2() const {
+        return _area_m2;
+    }
+
+    double getLateralArea_m2() const {
+        return _lateralArea_m2;
+    }
+
+    double getChord_m() const {
+        return 0.0;
+    }
+
+    ///
+    /// \brief      Gets the counts of the angles of attack looked up against the polar, as Airfoil::getTelemetry().
+    ///
+    const Bilinear_interp::Telemetry &getTelemetry() const {
+        return _telemetry;
+    }
+
+    ///
+    /// \brief      Clears the counts of the angles of attack looked up.
+    ///
+    void resetTelemetry() {
+        _telemetry = Bilinear_interp::Telemetry();
+    }
+
+  private:
+    double _area_m2;
+    double _lateralArea_m2;
+
+    const AirfoilTable<Rows> *_table;
+
+    Bilinear_interp::Telemetry _telemetry;
+
+    // As Airfoil, a value of 0.1 is presumed until a range of values are provided for coefficient of lateral force.
+    constexpr static double _sideSlipCoefficient = 0.1;
+};
+
+template <std::size_t Rows>
+constexpr double FixedAirfoil<Rows>::_sideSlipCoefficient;
+
 }  // namespace avionics_sim
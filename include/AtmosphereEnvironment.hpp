@@ -0,0 +1,47 @@
+/**
+ * @brief       AtmosphereEnvironment
+ * @file        AtmosphereEnvironment.hpp
+ * @copyright   Copyright (c) 2021, Swift Engineering Inc.
+ * @license     Licensed under the MIT license. See LICENSE for details.
+ */
+
+#pragma once
+
+#include "EnvironmentSnapshot.hpp"
+#include "IPhysicsEnvironment.hpp"
+#include "US_1976_atmosphere.hpp"
+
+namespace avionics_sim {
+
+///
+/// \brief      Physics environment of the US 1976 atmosphere, at the height of a vehicle.
+///
+/// \details    Each get_air_density_kg_per_m3() searches the layers of the atmosphere and evaluates its pressure
+///             again, where get_snapshot() does so once for the whole state of the air.
+///
+class AtmosphereEnvironment : public IPhysicsEnvironment {
+  public:
+    ///
+    /// \brief      Constructor
+    /// \param[in]  geometricHeight_m (Height above mean sea level)
+    ///
+    explicit AtmosphereEnvironment(double geometricHeight_m = 0.0);
+
+    ///
+    /// \brief      Sets the height of the vehicle.
+    /// \param[in]  geometricHeight_m (Height above mean sea level)
+    /// \return     N/A
+    ///
+    void set_geometric_height_m(double geometricHeight_m);
+
+    double get_geometric_height_m() const;
+
+    virtual double get_air_density_kg_per_m3();
+
+    virtual EnvironmentSnapshot get_snapshot();
+
+  private:
+    Geopotential_height _height;
+};
+
+}  // namespace avionics_sim
@@ -8,10 +8,24 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
 #include <vector>
 #include <string>
 
+#include "TableRegistry.hpp"
+
+// Whether interpolators count their queries against the bounds of their tables. Set to 0 through the CMake option
+// of the same name to compile the counting out.
+#ifndef AVIONICS_SIM_INTERP_TELEMETRY
+#define AVIONICS_SIM_INTERP_TELEMETRY 1
+#endif
+
 namespace avionics_sim {
+class TableFile;
+
 class Bilinear_interp {
   public:
     // INTERP_SUCCESS             Indicates that interpolation was a success.
@@ -30,6 +44,138 @@ class Bilinear_interp {
         INTERP_ERROR_NO_LUT =         -2  ///< Interpolation failed due to no LUT being loaded in the class.
     };
 
+    ///
+    /// \brief      Bracketing interval of a 1D query, as located by findBracket().
+    ///
+    /// \details    Any y data sharing the x breakpoints the bracket was found on can be interpolated from it with
+    ///             interpolateBracket(), so the search only needs to be done once per query. When the query was
+    ///             clamped, lower and upper are the same index and the weight is 0.
+    ///
+    struct Bracket {
+        std::size_t lower;  ///< Index of the lower bounding breakpoint.
+        std::size_t upper;  ///< Index of the upper bounding breakpoint.
+        double weight;      ///< Position of the query within the interval, from 0 (lower) to 1 (upper).
+    };
+
+    ///
+    /// \brief      Spacing of a set of breakpoints, as found by detectUniformGrid().
+    ///
+    /// \details    When the breakpoints are evenly spaced the interval holding a query can be computed directly from
+    ///             (x - x0) * invDx instead of being searched for. Otherwise isUniform is false and searches fall back
+    ///             to a binary search.
+    ///
+    struct UniformGrid {
+        bool isUniform;  ///< True if the breakpoints are evenly spaced within UNIFORM_GRID_TOLERANCE.
+        double x0;       ///< First breakpoint.
+        double invDx;    ///< Reciprocal of the spacing between breakpoints.
+    };
+
+    ///
+    /// \brief      Remembers where the previous search on a set of breakpoints ended.
+    ///
+    /// \details    Queries from a simulation loop tend to land in the same or a neighbouring interval as the query
+    ///             before them. Passing the same cursor to every search on a table lets the search start from the last
+    ///             interval and gallop outwards, which finds a nearby interval in a step or two and a distant one in
+    ///             logarithmic time. A cursor must only be used with the breakpoints it was first used on.
+    ///
+    struct Cursor {
+        Cursor() : index(0) {}
+
+        std::size_t index;  ///< Index of the upper bounding breakpoint found by the previous search.
+    };
+
+    ///
+    /// \brief      Line through an interval of a 1D LUT, as computed by computeSegments().
+    ///
+    /// \details    Lets the interval be evaluated as slope * x + intercept, a single multiply-add, without the division
+    ///             that finding the weight of a bracket takes. The result agrees with interpolateBracket() to within
+    ///             rounding rather than exactly.
+    ///
+    struct Segment {
+        double slope;      ///< Change in y per unit change in x.
+        double intercept;  ///< Value of the line at x = 0.
+    };
+
+    ///
+    /// \brief      Cubic through an interval of a 1D LUT, as computed by computeMonotoneCubic().
+    ///
+    /// \details    The interval is evaluated as ((c3 * t + c2) * t + c1) * t + c0 with t = x - x0, so that it needs
+    ///             neither the breakpoints nor the y values of the LUT, only the segment itself.
+    ///
+    struct CubicSegment {
+        double x0;  ///< Lower breakpoint of the interval.
+        double c0;  ///< Value at x0.
+        double c1;  ///< Slope at x0.
+        double c2;  ///< Coefficient of t^2.
+        double c3;  ///< Coefficient of t^3.
+    };
+
+    ///
+    /// \brief      Location of the value that get1DLUTelementsFromString() or get2DLUTelementsFromString() could not
+    ///             parse.
+    ///
+    /// \details    Both indices count from 0. The row is always 0 for a one dimensional string.
+    ///
+    struct ParseError {
+        std::size_t row;     ///< Index of the semicolon separated row holding the value.
+        std::size_t column;  ///< Index of the value within its row.
+    };
+
+    ///
+    /// \brief      Read-only view of contiguous LUT values, such as y values or a single row of x or z values.
+    ///
+    /// \details    Does not own the values, which must outlive the view. Converts implicitly from std::vector<double>
+    ///             so that either can be passed where a view is expected.
+    ///
+    class View {
+      public:
+        View() : first(nullptr), count(0) {}
+        View(const double *values, std::size_t size) : first(values), count(size) {}
+        View(const std::vector<double> &values) :  // NOLINT(runtime/explicit)
+            first(values.data()), count(values.size()) {}
+
+        const double *begin() const { return first; }
+        const double *end() const { return first + count; }
+        const double *data() const { return first; }
+        std::size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+        double operator[](std::size_t i) const { return first[i]; }
+        double front() const { return first[0]; }
+        double back() const { return first[count - 1]; }
+
+      private:
+        const double *first;
+        std::size_t count;
+    };
+
+    ///
+    /// \brief      Read-only view of a 2D table stored row after row in a single array.
+    ///
+    /// \details    Row i holds the values from values[offsets[i]] up to values[offsets[i + 1]], so rows may differ in
+    ///             length. Does not own the values or offsets, which must outlive the view.
+    ///
+    class TableView {
+      public:
+        TableView() : values(nullptr), offsets(nullptr), rowCount(0) {}
+        TableView(const double *values, const std::size_t *offsets, std::size_t rows) :
+            values(values), offsets(offsets), rowCount(rows) {}
+
+        std::size_t size() const { return rowCount; }  ///< Number of rows.
+        bool empty() const { return rowCount == 0; }
+        View operator[](std::size_t row) const {
+            return View(values + offsets[row], offsets[row + 1] - offsets[row]);
+        }
+
+      private:
+        const double *values;
+        const std::size_t *offsets;
+        std::size_t rowCount;
+    };
+
+    /// Largest deviation of any breakpoint from an even spacing, as a fraction of that spacing, for the breakpoints
+    /// to still be treated as uniform.
+    static constexpr double UNIFORM_GRID_TOLERANCE = 1e-6;
+
 
 
     Bilinear_interp();  ///< Default constructor
@@ -61,6 +207,151 @@ class Bilinear_interp {
     static InterpResult interpolate(const std::vector<double> &xv,
                                     const std::vector<double> &yv, double x, double *const y);
 
+    ///
+    /// \brief      Locates the interval of a 1D LUT bracketing x.
+    ///
+    /// \details    Performs the search half of interpolate(), with the same clamping behaviour.
+    /// \param[in]  xv       reference to x values of the LUT
+    /// \param[in]  x        x location to be bracketed
+    /// \param[out] bracket  pointer to bracket to contain the bounding indices and weight.
+    ///
+    /// \return     Returns InterpResult enum containing potential interpolation errors.
+    /// X values must be ascending
+    static InterpResult findBracket(const std::vector<double> &xv, double x, Bracket *const bracket);
+
+    ///
+    /// \brief      Interpolates y values at a bracket previously located by findBracket().
+    ///
+    /// \param[in]  yv       reference to y values of the LUT, of the same length as the x values bracketed.
+    /// \param[in]  bracket  bracket returned by findBracket()
+    ///
+    /// \return     The interpolated y value.
+    static double interpolateBracket(View yv, const Bracket &bracket);
+
+    ///
+    /// \brief      Checks whether a set of breakpoints is evenly spaced.
+    ///
+    /// \details    Breakpoints are uniform when there are at least two, they are ascending, and none lies further than
+    ///             UNIFORM_GRID_TOLERANCE spacings from x0 + i * dx.
+    /// \param[in]  xv    reference to x values of the LUT
+    ///
+    /// \return     The grid description to pass to findBracket() or interpolate().
+    static UniformGrid detectUniformGrid(View xv);
+
+    ///
+    /// \brief      Checks whether a set of breakpoints is evenly spaced.
+    ///
+    /// \param[in]  xv    reference to x values of the LUT
+    ///
+    /// \return     The grid description to pass to findBracket() or interpolate().
+    static UniformGrid detectUniformGrid(const std::vector<double> &xv);
+
+    ///
+    /// \brief      Locates the interval of a 1D LUT bracketing x, using the direct index of a uniform grid.
+    ///
+    /// \details    Gives exactly the same bracket and result as findBracket() without a grid, in constant time when
+    ///             the grid is uniform. Otherwise, the search starts from the cursor if one is given.
+    /// \param[in]      xv       reference to x values of the LUT
+    /// \param[in]      grid     grid of xv, as returned by detectUniformGrid(xv)
+    /// \param[in]      x        x location to be bracketed
+    /// \param[out]     bracket  pointer to bracket to contain the bounding indices and weight.
+    /// \param[in,out]  cursor   optional pointer to the cursor of a sequence of searches on xv.
+    ///
+    /// \return     Returns InterpResult enum containing potential interpolation errors.
+    static InterpResult findBracket(View xv, const UniformGrid &grid, double x,
+                                    Bracket *const bracket, Cursor *const cursor = nullptr);
+
+    ///
+    /// \brief      Performs a 1D interpolation, using the direct index of a uniform grid.
+    ///
+    /// \param[in]      xv      reference to x values of the LUT
+    /// \param[in]      grid    grid of xv, as returned by detectUniformGrid(xv)
+    /// \param[in]      yv      reference to y values of the LUT
+    /// \param[in]      x       x location to be used in calculation of y
+    /// \param          y       pointer to y variable to contain interpolation output.
+    /// \param[in,out]  cursor  optional pointer to the cursor of a sequence of searches on xv.
+    ///
+    /// \return      Returns InterpResult enum containing potential interpolation errors.
+    static InterpResult interpolate(View xv, const UniformGrid &grid, View yv, double x, double *const y,
+                                    Cursor *const cursor = nullptr);
+
+    ///
+    /// \brief      Computes the line through each interval of a 1D LUT.
+    ///
+    /// \details    Appends one segment per y value to segments: the line from each breakpoint to the next, and a flat
+    ///             line at the last breakpoint. An interval of zero width also gets a flat line.
+    /// \param[in]  xv        reference to x values of the LUT
+    /// \param[in]  yv        reference to y values of the LUT
+    /// \param[out] segments  pointer to vector to append the segments to.
+    ///
+    static void computeSegments(View xv, View yv, std::vector<Segment> *const segments);
+
+    ///
+    /// \brief      Locates the interval of a 1D LUT bracketing x, without computing the weight.
+    ///
+    /// \details    Performs findBracket() except that the weight is left 0, for the bracket to be evaluated with
+    ///             interpolateSegment().
+    /// \param[in]      xv       reference to x values of the LUT
+    /// \param[in]      grid     grid of xv, as returned by detectUniformGrid(xv)
+    /// \param[in]      x        x location to be bracketed
+    /// \param[out]     bracket  pointer to bracket to contain the bounding indices.
+    /// \param[in,out]  cursor   optional pointer to the cursor of a sequence of searches on xv.
+    ///
+    /// \return     Returns InterpResult enum containing potential interpolation errors.
+    static InterpResult findInterval(View xv, const UniformGrid &grid, double x,
+                                     Bracket *const bracket, Cursor *const cursor = nullptr);
+
+    ///
+    /// \brief      Interpolates y values at a bracket previously located by findInterval(), from their segments.
+    ///
+    /// \param[in]  yv        reference to y values of the LUT, of the same length as the x values bracketed.
+    /// \param[in]  segments  segments of the LUT, as computed by computeSegments(xv, yv).
+    /// \param[in]  bracket   bracket returned by findInterval()
+    /// \param[in]  x         x location the bracket was located for.
+    ///
+    /// \return     The interpolated y value, which is exactly the y value of the bracket if it was clamped.
+    static double interpolateSegment(View yv, const Segment *const segments, const Bracket &bracket, double x);
+
+    ///
+    /// \brief      Computes a monotone cubic through each interval of a 1D LUT.
+    ///
+    /// \details    Fits a piecewise cubic Hermite curve through the breakpoints, with the slope at each breakpoint
+    ///             chosen as by Fritsch and Carlson so that the curve is monotone wherever the data are: it never
+    ///             overshoots the y values on either side of an interval, and is flat at a local extremum of the data.
+    ///             The curve and its slope are continuous, so a sparse table gives a smooth result where linear
+    ///             interpolation would need many more breakpoints. Appends one segment per y value to segments, with a
+    ///             flat segment at the last breakpoint and for any interval of zero width.
+    /// \param[in]  xv        reference to x values of the LUT
+    /// \param[in]  yv        reference to y values of the LUT
+    /// \param[out] segments  pointer to vector to append the segments to.
+    ///
+    static void computeMonotoneCubic(View xv, View yv, std::vector<CubicSegment> *const segments);
+
+    ///
+    /// \brief      Interpolates y values at a bracket previously located by findInterval(), from their cubic segments.
+    ///
+    /// \param[in]  segments  segments of the LUT, as computed by computeMonotoneCubic(xv, yv).
+    /// \param[in]  bracket   bracket returned by findInterval()
+    /// \param[in]  x         x location the bracket was located for.
+    ///
+    /// \return     The interpolated y value, which is exactly the y value of the bracket if it was clamped.
+    static double interpolateCubic(const CubicSegment *const segments, const Bracket &bracket, double x);
+
+    ///
+    /// \brief      Performs a 1D monotone cubic interpolation.
+    ///
+    /// \details    Clamps to the nearest available data if x is out of bounds, as interpolate() does.
+    /// \param[in]      xv        reference to x values of the LUT
+    /// \param[in]      grid      grid of xv, as returned by detectUniformGrid(xv)
+    /// \param[in]      segments  segments of the LUT, as computed by computeMonotoneCubic(xv, yv).
+    /// \param[in]      x         x location to be used in calculation of y
+    /// \param          y         pointer to y variable to contain interpolation output.
+    /// \param[in,out]  cursor    optional pointer to the cursor of a sequence of searches on xv.
+    ///
+    /// \return      Returns InterpResult enum containing potential interpolation errors.
+    static InterpResult interpolateCubic(View xv, const UniformGrid &grid, const CubicSegment *const segments,
+                                         double x, double *const y, Cursor *const cursor = nullptr);
+
 
 
     // Function to perfrom 2D (Bilinear) interpolation.
@@ -98,34 +389,199 @@ class Bilinear_interp {
     /// X and Y values must be ascending
     InterpResult interpolate2D(double x, double y, double *const z);
 
+    ///
+    /// \brief      Performs 2D interpolations on LUT for many independent query points at once.
+    ///
+    /// \details    Gives bit-identical results to calling interpolate2D(x[i], y[i], &z[i]) for every point, as long as
+    ///             the library is not built to contract multiplies and adds into fused multiply-adds. When the y values
+    ///             and every row of x values are uniform and the processor has AVX2, four points are searched and
+    ///             interpolated at a time. Otherwise the points are interpolated one after the other.
+    /// \param[in]      x        x locations of the query points
+    /// \param[in]      y        y locations of the query points, as many as there are x locations
+    /// \param[out]     z        pointer to an array of x.size() values to contain the interpolation outputs.
+    /// \param[out]     results  optional pointer to an array of x.size() values to contain the result of each point.
+    ///
+    /// \return     Returns INTERP_ERROR_NO_LUT if no LUT is loaded, otherwise INTERP_WARN_OUT_OF_BOUNDS if any point
+    ///             was clamped and INTERP_SUCCESS if none were.
+    /// X and Y values must be ascending
+    InterpResult interpolate2D(View x, View y, double *const z, InterpResult *const results = nullptr) const;
+
+    ///
+    /// \brief      Chooses whether interpolate2D() evaluates precomputed lines rather than weights.
+    ///
+    /// \details    When enabled, the segments of every row and the reciprocal spacing of the y values are computed now
+    ///             and whenever values are next set, so that interpolating a point takes no division. Results then
+    ///             agree with those of the default to within rounding rather than exactly. The batched interpolate2D()
+    ///             interpolates one point at a time, so as to stay identical to interpolate2D(x, y, z).
+    ///
+    /// \param[in]  enable  Whether to precompute the segments.
+    ///
+    void setPrecomputedSlopes(bool enable);
+
+    ///
+    /// \brief      Precision at which interpolate2D() reads the z values.
+    ///
+    enum StorageMode {
+        STORAGE_DOUBLE,   ///< Double precision, as given. The default.
+        STORAGE_FLOAT32,  ///< Single precision, half the bytes of double.
+        STORAGE_FIXED16   ///< 16 bit integers scaled to the range of the values, a quarter of the bytes of double.
+    };
+
+    ///
+    /// \brief      Error of a storage mode against the double precision table, as reported by setStorage().
+    ///
+    /// \details    An interpolation is a weighted average of stored values, so its error never exceeds maxValueError
+    ///             by more than rounding. maxInterpolationError is measured by interpolating both tables at every
+    ///             breakpoint of every row, and midway between each row and the next.
+    ///
+    struct StorageError {
+        double maxValueError;          ///< Largest absolute difference of a stored z value from the value given.
+        double maxInterpolationError;  ///< Largest absolute difference of an interpolation from the double table's.
+    };
+
+    ///
+    /// \brief      Chooses the precision at which interpolate2D() reads the z values.
+    ///
+    /// \details    A compact copy of the z values is made now and whenever values are next set, and read in place of
+    ///             the double values, so that interpolations over a large table touch a half or a quarter of the
+    ///             memory. Arithmetic is still done in double precision. The double values are kept for viewZ() and
+    ///             getZ(), and for the copy to be remade. The batched interpolate2D() interpolates one point at a time
+    ///             when not in STORAGE_DOUBLE, and precomputed slopes, while enabled, are evaluated in place of either.
+    ///
+    /// \param[in]  mode   Precision to store the z values at.
+    /// \param[out] error  Optional pointer to contain the error of the mode against the double values, if set.
+    ///
+    /// \return     A bool indicating whether the mode was set. STORAGE_FIXED16 fails, leaving STORAGE_DOUBLE set, if
+    ///             any z value is infinite or NaN; should such values be set later, the mode reverts to STORAGE_DOUBLE.
+    ///
+    bool setStorage(StorageMode mode, StorageError *const error = nullptr);
+
+    ///
+    /// \brief      Gets the precision at which interpolate2D() reads the z values.
+    ///
+    StorageMode getStorage() const;
+
+    ///
+    /// \brief      Gets the error of the storage mode against the double values, as of the values last set.
+    ///
+    /// \return     The error, which is 0 in STORAGE_DOUBLE.
+    ///
+    StorageError getStorageError() const;
+
+    ///
+    /// \brief      Counts of the queries made of one axis of a LUT, against the bounds of its breakpoints.
+    ///
+    /// \details    Kept by the interpolators holding a table, so that how often a table runs off its data can be read
+    ///             at run time rather than from the result of every call. Counted without branching on the query.
+    ///             A NaN query, which is clamped to the first breakpoint, counts as a low clamp and is left out of
+    ///             minQuery and maxQuery, so that hits + lowClamps + highClamps is the number of queries. Counters
+    ///             are not synchronised, so an interpolator queried from several threads at once needs a copy per
+    ///             thread, as a Cursor does. When AVIONICS_SIM_INTERP_TELEMETRY is 0, record() does nothing and the
+    ///             counts stay as constructed.
+    ///
+    struct Telemetry {
+        Telemetry() :
+            hits(0),
+            lowClamps(0),
+            highClamps(0),
+            minQuery(std::numeric_limits<double>::infinity()),
+            maxQuery(-std::numeric_limits<double>::infinity()) {}
+
+        ///
+        /// \brief      Counts a query of breakpoints running from first to last.
+        ///
+        void record(double x, double first, double last) {
+#if AVIONICS_SIM_INTERP_TELEMETRY
+            bool low = !(x >= first);
+            bool high = !low & (x > last);
+
+            hits += !low & !high;
+            lowClamps += low;
+            highClamps += high;
+            minQuery = x < minQuery ? x : minQuery;
+            maxQuery = x > maxQuery ? x : maxQuery;
+#else
+            (void)x;
+            (void)first;
+            (void)last;
+#endif
+        }
+
+        std::uint64_t hits;        ///< Queries within the breakpoints.
+        std::uint64_t lowClamps;   ///< Queries below the first breakpoint, clamped to it.
+        std::uint64_t highClamps;  ///< Queries above the last breakpoint, clamped to it.
+        double minQuery;           ///< Smallest query seen, or infinity if none.
+        double maxQuery;           ///< Largest query seen, or -infinity if none.
+    };
+
+    ///
+    /// \brief      Counts of the queries made of interpolate2D(), as returned by getTelemetry().
+    ///
+    /// \details    A query counts against x as clamped if it was clamped on any row it was interpolated from, and as a
+    ///             low clamp should it lie below one row and above the other.
+    ///
+    struct Telemetry2D {
+        Telemetry x;  ///< Queries of the x breakpoints of the rows interpolated from.
+        Telemetry y;  ///< Queries of the y values.
+    };
+
+    ///
+    /// \brief      Gets the counts of the queries made of interpolate2D() since construction or resetTelemetry().
+    ///
+    /// \details    Queries made with precomputed slopes, in any storage mode, and through the batched interpolate2D()
+    ///             are all counted. Copies of the interpolator carry on from the counts of the original.
+    ///
+    /// \return     The counts, which stay empty when AVIONICS_SIM_INTERP_TELEMETRY is 0.
+    ///
+    Telemetry2D getTelemetry() const;
+
+    ///
+    /// \brief      Clears the counts of the queries made of interpolate2D().
+    ///
+    void resetTelemetry();
+
+    ///
+    /// \brief      Names the instruction set used by the batched interpolate2D() on this processor.
+    ///
+    /// \return     "avx2" or "scalar".
+    ///
+    static const char *batchInstructionSet();
+
 
 
     // Static helper functions to load data elements into vectors.
     ///
     /// \brief      Gets a one dimensional vector of LUT elements from a string.
     /// \details    Takes a string containing comma separated values representing values
-    ///            withing a LUT.
+    ///            withing a LUT. Each value is read as sscanf("%lf") would read it: leading whitespace is
+    ///            skipped and anything following the number up to the next comma is ignored. The string is
+    ///            parsed in a single pass without temporary copies, and outputVect is left unchanged on failure.
     ///
     /// \param[in]  inputVals The input string to be processed.
     /// \param[out] outputVect A pointer to std::vector<double> containing the LUT elements.
+    /// \param[out] error Optional location of the first value which could not be parsed, set on failure only.
     ///
     /// \return     A bool indicating whether the parsing was a success.
     ///
     static bool get1DLUTelementsFromString(const std::string &inputVals,
-                                           std::vector<double> *const outputVect);
+                                           std::vector<double> *const outputVect,
+                                           ParseError *const error = nullptr);
 
     ///
     /// \brief      Gets a two dimensional vector of LUT elements from a string.
     /// \details    Takes a string containing semicolon separated rows of comma separated
-    ///            values representing points on a 2D LUT.
+    ///            values representing points on a 2D LUT. Values are read as by get1DLUTelementsFromString().
+    ///            A trailing semicolon does not start another row.
     ///
     /// \param[in]  inputVals  The input string to be processed.
     /// \param[out] outputVect A pointer to std::vector<std::vector<<double>> containing the 2D LUT elements.
+    /// \param[out] error Optional location of the first value which could not be parsed, set on failure only.
     ///
     /// \return     A bool indicating whether the parsing was a success.
     ///
     static bool get2DLUTelementsFromString(const std::string &inputVals,
-                                           std::vector<std::vector<double>> *const outputVect);
+                                           std::vector<std::vector<double>> *const outputVect,
+                                           ParseError *const error = nullptr);
 
 
 
@@ -184,6 +640,20 @@ class Bilinear_interp {
     ///
     void setZVals(const std::vector<std::vector<double>> &zv);
 
+    ///
+    /// \brief      Sets the x, y and z vals to the arrays named "x", "y" and "z" of a table file.
+    ///
+    /// \details    The values are used in place within the mapped file rather than copied, and the file stays mapped
+    ///             until they are next set. Only the start of each row is copied. The grids of arrays not flagged as
+    ///             uniform by the file are not searched for.
+    ///
+    /// \param[in]  file   Mapped table file, as returned by TableFile::open().
+    ///
+    /// \return A bool indicating whether the operation was a success. A failure is returned, and nothing is set, if the
+    ///         file is null, has no array of one of the names or its "y" array has other than one row.
+    ///
+    bool setTableFile(const std::shared_ptr<const TableFile> &file);
+
     ///
     /// \brief      Gets the x vals vector.
     ///
@@ -211,11 +681,167 @@ class Bilinear_interp {
     ///
     bool getZ(std::vector<std::vector<double>> *const zVect);
 
+    ///
+    /// \brief      Views the x vals without copying them.
+    ///
+    /// \return     View of the x values, valid until they are next set. Has no rows if they have not been set.
+    ///
+    TableView viewX() const;
+
+    ///
+    /// \brief      Views the y vals without copying them.
+    ///
+    /// \return     View of the y values, valid until they are next set. Is empty if they have not been set.
+    ///
+    View viewY() const;
+
+    ///
+    /// \brief      Views the z vals without copying them.
+    ///
+    /// \return     View of the z values, valid until they are next set. Has no rows if they have not been set.
+    ///
+    TableView viewZ() const;
+
   private:
-    /// \brief Vectors to hold LUT data.
-    /// Holds 2D LUT values for X and Z points
-    std::vector< std::vector<double> > xVals, zVals;
-    std::vector<double> yVals;  ///< Holds Y values for LUT data.
+    ///
+    /// \brief      Index of the first breakpoint not less than x, as std::lower_bound would return.
+    ///
+    /// \details    For a uniform grid the index is computed directly and then stepped onto the exact answer. Otherwise
+    ///             the search gallops out from the cursor if one is given, and is a binary search if not.
+    ///
+    static std::size_t lowerBound(View xv, const UniformGrid &grid, double x, Cursor *const cursor);
+
+    ///
+    /// \brief      Index of the first breakpoint not less than x, searching outwards from a cursor.
+    ///
+    static std::size_t huntLowerBound(View xv, double x, Cursor *const cursor);
+
+    ///
+    /// \brief      Bracketing rows and intervals of a 2D query, as located by findBracket2D().
+    ///
+    struct Bracket2D {
+        std::size_t lowerRow;  ///< Row of the table below the query.
+        std::size_t upperRow;  ///< Row of the table above the query, the same as lowerRow if there is only one.
+        Bracket lower;         ///< Interval of the query within lowerRow.
+        Bracket upper;         ///< Interval of the query within upperRow.
+        double weight;         ///< Position of the query between the rows, from 0 (lower) to 1 (upper).
+        bool twoRows;          ///< False if the query lies on or beyond the first or last row.
+    };
+
+    ///
+    /// \brief      Performs the 2D interpolation of interpolate2D() with a grid for every row of x and for y.
+    ///
+    /// \details    Rows is either std::vector<std::vector<double>> or TableView. ZRows is the same, or rows of z values
+    ///             stored at a lower precision and read as doubles. xGrids may be null when no grids are known for the
+    ///             rows of x.
+    ///
+    template <typename Rows, typename ZRows>
+    static InterpResult interpolate2D(const Rows &xv, const UniformGrid *const xGrids,
+                                      View yv, const UniformGrid &yGrid, const ZRows &zv,
+                                      double x, double y, double *const z, Telemetry2D *const counts = nullptr);
+
+    ///
+    /// \brief      Performs the search half of interpolate2D(), counting the query in counts if not null.
+    ///
+    template <typename Rows>
+    static InterpResult findBracket2D(const Rows &xv, const UniformGrid *const xGrids,
+                                      View yv, const UniformGrid &yGrid, double x, double y,
+                                      Bracket2D *const bracket, Telemetry2D *const counts);
+
+    ///
+    /// \brief      Performs interpolate2D() on a LUT that is set, from the z values of the storage mode, counting the
+    ///             query in counts if not null.
+    ///
+    InterpResult interpolate2DStored(double x, double y, double *const z, Telemetry2D *const counts) const;
+
+    ///
+    /// \brief      Performs interpolate2D() from the precomputed segments, counting the query in counts.
+    ///
+    InterpResult interpolate2DSegments(double x, double y, double *const z, Telemetry2D *const counts) const;
+
+    ///
+    /// \brief      Interpolates a row of z from its precomputed segments.
+    ///
+    InterpResult interpolateRowSegments(std::size_t row, double x, double *const z) const;
+
+    ///
+    /// \brief      Recomputes rowSegments and yInvSpacing from the values set, or clears them if not enabled.
+    ///
+    void updateSegments();
+
+    ///
+    /// \brief      Remakes the compact copy of the z values and measures its error, or clears it in STORAGE_DOUBLE.
+    ///
+    void updateStorage();
+
+    ///
+    /// \brief      Stores the rows of x and z in tableValues.
+    ///
+    /// \details    Both are copied into a new set of values, interned in the TableRegistry, before it replaces the
+    ///             old one, so either may be a view of the current tableValues.
+    ///
+    void storeTable(TableView xv, TableView zv);
+
+    ///
+    /// \brief      Detects the grids of the rows of x, or marks them all as unknown if mayBeUniform is false.
+    ///
+    void detectXGrids(bool mayBeUniform);
+
+    /// \brief Start of the 2D LUT values, within tableValues or the mapped file.
+    const double *tableData() const;
+
+    /// \brief Releases the mapped file once no values are used from it.
+    void releaseUnusedTableFile();
+
+    /// \brief Holds the 2D LUT values for X points, row after row, followed by those for Z points in the same way.
+    /// Keeping both in one allocation places the rows an interpolation reads close together in memory. Shared through
+    /// the TableRegistry with copies and with other interpolators of the same table; null until values are set.
+    TableRegistry::Table tableValues;
+
+    /// Start of each row of X and of Z within tableValues, followed by the end of the last row.
+    std::vector<std::size_t> xRowOffsets, zRowOffsets;
+
+    TableRegistry::Table yVals;  ///< Holds Y values for LUT data, shared as tableValues is.
+
+    /// Grids of each row of xVals and of yVals, detected when the values are set.
+    std::vector<UniformGrid> xGrids;
+    UniformGrid yGrid;
+
+    /// First breakpoint, reciprocal spacing and last breakpoint of each row of xVals, row after row, for the batched
+    /// interpolate2D() to look up by row. Empty unless every row is uniform.
+    std::vector<double> uniformRowGrids;
+
+    /// Whether setPrecomputedSlopes() is enabled.
+    bool usePrecomputedSlopes;
+
+    /// Segments of each row of z against the same row of x, row r starting at zRowOffsets[r] - zRowOffsets[0]. Empty
+    /// unless precomputed slopes are enabled.
+    std::vector<Segment> rowSegments;
+
+    /// Reciprocal of the spacing following each y value. Empty unless precomputed slopes are enabled.
+    std::vector<double> yInvSpacing;
+
+    /// Precision set by setStorage().
+    StorageMode storageMode;
+
+    /// z values in single precision, row r starting at zRowOffsets[r] - zRowOffsets[0]. Empty unless in
+    /// STORAGE_FLOAT32.
+    std::vector<float> zFloat32;
+
+    /// z values as zFixed16Offset + zFixed16Scale * q, laid out as zFloat32. Empty unless in STORAGE_FIXED16.
+    std::vector<std::int16_t> zFixed16;
+    double zFixed16Scale, zFixed16Offset;
+
+    /// Error of storageMode, as of the values last set.
+    StorageError storageError;
+
+    /// Counts of the queries made of interpolate2D(), updated by the batched interpolate2D() although const.
+    mutable Telemetry2D telemetry;
+
+    /// Table file the values below are used from in place of tableValues and yVals, shared with any copies.
+    std::shared_ptr<const TableFile> tableFile;
+    const double *mappedTableValues;  ///< Used in place of tableValues when not null.
+    View mappedYVals;                 ///< Used in place of yVals when not null.
 
     /// Bools to keep track of which LUT data values have been added.
     bool haveXVals, haveYVals, haveZVals;
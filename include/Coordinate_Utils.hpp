@@ -25,6 +25,19 @@ class Coordinate_Utils {
     static int project_vector_global(ignition::math::Pose3d targetFrame, ignition::math::Vector3d vec,
                                      ignition::math::Vector3d *const res);
 
+    /**
+     * @brief This function builds the rotation which projects vectors from one coordinate system into another.
+     *
+     * @details Its rows are the forward, right and upward unit vectors of the target frame, so that multiplying a
+     * vector by it gives exactly what project_vector_global() gives for that vector. Frames shared by many vectors
+     * can then be projected onto with a single matrix-vector product each.
+     *
+     * @param targetFrame a Pose3d containing the target frame to project vectors onto.
+     * @param res Matrix3d to contain the rotation into the target coordinate frame.
+     * @return int reserved for future use. Always returns 0.
+     */
+    static int project_rotation_global(ignition::math::Pose3d targetFrame, ignition::math::Matrix3d *const res);
+
     static ignition::math::Quaterniond QuatFromBasis(ignition::math::Vector3d forward, ignition::math::Vector3d up);
 };
 }  // namespace avionics_sim
@@ -0,0 +1,32 @@
+/**
+ * @brief       EnvironmentSnapshot
+ * @file        EnvironmentSnapshot.hpp
+ * @copyright   Copyright (c) 2021, Swift Engineering Inc.
+ * @license     Licensed under the MIT license. See LICENSE for details.
+ */
+
+#pragma once
+
+#include <limits>
+
+namespace avionics_sim {
+
+///
+/// \brief      State of the air around a vehicle, taken once per step and passed to each of its surfaces.
+///
+/// \details    Values an environment cannot tell are NaN.
+///
+struct EnvironmentSnapshot {
+    EnvironmentSnapshot() :
+        airDensity_kg_per_m3(std::numeric_limits<double>::quiet_NaN()),
+        staticPressure_Pa(std::numeric_limits<double>::quiet_NaN()),
+        temperature_K(std::numeric_limits<double>::quiet_NaN()),
+        speedOfSound_m_per_s(std::numeric_limits<double>::quiet_NaN()) {}
+
+    double airDensity_kg_per_m3;    ///< Density of the air.
+    double staticPressure_Pa;       ///< Static pressure of the air.
+    double temperature_K;           ///< Temperature of the air.
+    double speedOfSound_m_per_s;    ///< Speed of sound in the air.
+};
+
+}  // namespace avionics_sim
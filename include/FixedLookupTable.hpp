@@ -0,0 +1,107 @@
+/**
+ * @brief       FixedLookupTable
+ * @file        FixedLookupTable.hpp
+ * @copyright   Copyright (c) 2021, Swift Engineering Inc.
+ * @license     Licensed under the MIT license. See LICENSE for details.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+namespace avionics_sim {
+
+///
+/// \brief      Finds the first of Count ascending breakpoints, from first, which is not less than x.
+///
+/// \details    The same search as std::lower_bound(), with the halving of the range worked out when the program is
+///             compiled, so that it is a fixed sequence of log2(Count) comparisons with no loop.
+///
+template <std::size_t Count>
+struct FixedLowerBound {
+    static constexpr std::size_t find(const double *xv, std::size_t first, double x) {
+        return xv[first + Count / 2] < x ? FixedLowerBound<Count - Count / 2 - 1>::find(xv, first + Count / 2 + 1, x)
+                                         : FixedLowerBound<Count / 2>::find(xv, first, x);
+    }
+};
+
+template <>
+struct FixedLowerBound<0> {
+    static constexpr std::size_t find(const double *, std::size_t first, double) { return first; }
+};
+
+///
+/// \brief      LUT with a number of rows and columns fixed at compile time, for tables which never change.
+///
+/// \details    An aggregate of one array per column, so that a table declared constexpr is initialised when the program
+///             is compiled and lives in read-only data shared by every process running it, with no allocation or
+///             hashing at run time:
+///
+///                 constexpr FixedLookupTable<4, 2> table = {{{-10.0, 0.0, 5.0, 15.0}, {-0.8, 0.1, 0.6, 1.2}}};
+///
+///             Columns are addressed by index rather than by name. Lookups interpolate linearly and clamp to the
+///             nearest breakpoint out of bounds, with exactly the same arithmetic and results as LookupTable, and can
+///             themselves be evaluated at compile time. The source column must be ascending.
+///
+template <std::size_t Rows, std::size_t Columns>
+struct FixedLookupTable {
+    static_assert(Rows >= 1, "A table needs at least one row");
+
+    double columns[Columns][Rows];  ///< Values of each column.
+
+    ///
+    /// \brief      Lookup function
+    /// \param[in]  valA (value input to source table)
+    /// \param[in]  fromA (Index of source table)
+    /// \param[in]  inB (Index of destination table)
+    /// \return     Interpolated value
+    ///
+    constexpr double lookup(double valA, std::size_t fromA, std::size_t inB) const {
+        return valA >= columns[fromA][0] ?
+               (valA <= columns[fromA][Rows - 1] ?
+                interpolateAt(columns[fromA], columns[inB], valA,
+                              FixedLowerBound<Rows>::find(columns[fromA], 0, valA)) :
+                columns[inB][Rows - 1]) :
+               columns[inB][0];
+    }
+
+    ///
+    /// \brief      Lookup of several destination tables at once
+    /// \details    Locates valA within the source table once and interpolates every requested destination table
+    ///             from that same interval.
+    /// \param[in]  valA (value input to source table)
+    /// \param[in]  fromA (Index of source table)
+    /// \param[in]  inB (Array of indices of destination tables)
+    /// \param[in]  count (Number of destination tables in inB)
+    /// \param[out] valB (Array of at least count values to contain the interpolated values, in the order of inB)
+    /// \return     N/A
+    ///
+    void lookup(double valA, std::size_t fromA, const std::size_t *const inB, std::size_t count,
+                double *const valB) const {
+        const double *const xv = columns[fromA];
+
+        if (valA >= xv[0] && valA <= xv[Rows - 1]) {
+            std::size_t upper = FixedLowerBound<Rows>::find(xv, 0, valA);
+
+            for (std::size_t i = 0; i < count; i++) {
+                valB[i] = interpolateAt(xv, columns[inB[i]], valA, upper);
+            }
+        } else {
+            // Clamped, or a NaN, which LookupTable also clamps to the first row.
+            std::size_t row = valA > xv[Rows - 1] ? Rows - 1 : 0;
+
+            for (std::size_t i = 0; i < count; i++) {
+                valB[i] = columns[inB[i]][row];
+            }
+        }
+    }
+
+  private:
+    /// \brief Interpolates yv between upper - 1 and upper, or takes its first value if x is exactly on the first row.
+    static constexpr double interpolateAt(const double *xv, const double *yv, double x, std::size_t upper) {
+        return upper == 0 ? yv[0] : (x - xv[upper - 1]) / (xv[upper] - xv[upper - 1]) * (yv[upper] - yv[upper - 1]) +
+               yv[upper - 1];
+    }
+};
+
+}  // namespace avionics_sim
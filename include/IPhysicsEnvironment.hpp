@@ -9,6 +9,8 @@
 
 #pragma once
 
+#include "EnvironmentSnapshot.hpp"
+
 namespace avionics_sim {
 
 class IPhysicsEnvironment {
@@ -16,6 +18,19 @@ class IPhysicsEnvironment {
     virtual ~IPhysicsEnvironment() {}
 
     virtual double get_air_density_kg_per_m3() = 0;
+
+    ///
+    /// \brief      Takes the state of the air at once, to be passed to every surface of a vehicle for a step rather
+    ///             than each querying the environment.
+    /// \details    Holds get_air_density_kg_per_m3() and NaN for the rest, unless overridden by an environment which
+    ///             can tell more, or tell it for less than separate queries would cost.
+    /// \return     State of the air
+    ///
+    virtual EnvironmentSnapshot get_snapshot() {
+        EnvironmentSnapshot snapshot;
+        snapshot.airDensity_kg_per_m3 = get_air_density_kg_per_m3();
+        return snapshot;
+    }
 };
 
 }  // namespace avionics_sim
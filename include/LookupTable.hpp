@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -16,14 +17,26 @@
 #include <assert.h>
 
 #include "Bilinear_interp.hpp"
+#include "TableFile.hpp"
+#include "TableRegistry.hpp"
 
 namespace avionics_sim {
 
 class LookupTable {
   public:
+    ///
+    /// \brief      Resolved reference to a column of the table.
+    /// \details    Obtained once from resolveColumn() so that repeated lookups do not need to hash the column name.
+    ///             A handle stays valid for the table it was resolved from and for any copy of that table.
+    ///
+    struct ColumnHandle {
+        std::size_t index;  ///< Position of the column within the table.
+    };
+
     ///
     /// \brief      Constructor
-    /// \details    Creates instance of lookup table.
+    /// \details    Creates instance of lookup table. The columns are held in the TableRegistry, so that tables built
+    ///             from the same values, and copies of a table, share them rather than each holding their own.
     /// \param[in]  colNames (std::vector containing the names of the LUTs)
     /// \param[in]  cols (std::vector of std::vector<double> containing LUT values)
     /// \return     Instance of lookup table
@@ -31,6 +44,25 @@ class LookupTable {
     LookupTable(std::vector<std::string> colNames,
                 std::vector<std::vector<double>> cols);
 
+    ///
+    /// \brief      Constructor
+    /// \details    Creates instance of lookup table whose columns are the arrays of a table file, under the names of
+    ///             the arrays. The values are used in place within the mapped file rather than copied, and the file
+    ///             stays mapped for as long as the table or any copy of it exists. Throws std::invalid_argument if the
+    ///             file is null or any of its arrays has other than one row.
+    /// \param[in]  file (Mapped table file, as returned by TableFile::open())
+    /// \return     Instance of lookup table
+    ///
+    explicit LookupTable(const std::shared_ptr<const TableFile> &file);
+
+    ///
+    /// \brief      Resolves a column name to a handle
+    /// \details    Throws std::out_of_range if no column of that name exists.
+    /// \param[in]  colName (Name of the column)
+    /// \return     Handle to be passed to lookup()
+    ///
+    ColumnHandle resolveColumn(const std::string &colName) const;
+
     ///
     /// \brief      Lookup function
     /// \details    Retrieves lookup
@@ -39,11 +71,110 @@ class LookupTable {
     /// \param[in]  inB (Destination table)
     /// \return     Interpolated value
     ///
-    double lookup(double valA, std::string fromA, std::string inB);
+    double lookup(double valA, const std::string &fromA, const std::string &inB) const;
+
+    ///
+    /// \brief      Lookup function using resolved column handles
+    /// \details    Performs no allocation or hashing; intended for use in the simulation loop.
+    /// \param[in]      valA (value input to source table)
+    /// \param[in]      fromA (Handle of source table)
+    /// \param[in]      inB (Handle of destination table)
+    /// \param[in,out]  cursor (Optional cursor remembering the previous lookup from the same source table)
+    /// \return         Interpolated value
+    ///
+    double lookup(double valA, ColumnHandle fromA, ColumnHandle inB,
+                  Bilinear_interp::Cursor *const cursor = nullptr) const;
+
+    ///
+    /// \brief      Lookup of several destination tables at once
+    /// \details    Locates valA within the source table once and interpolates every requested destination table
+    ///             from that same interval.
+    /// \param[in]      valA (value input to source table)
+    /// \param[in]      fromA (Handle of source table)
+    /// \param[in]      inB (Array of handles of destination tables)
+    /// \param[in]      count (Number of destination tables in inB)
+    /// \param[out]     valB (Array of at least count values to contain the interpolated values, in the order of inB)
+    /// \param[in,out]  cursor (Optional cursor remembering the previous lookup from the same source table)
+    /// \return         N/A
+    ///
+    void lookup(double valA, ColumnHandle fromA, const ColumnHandle *const inB, std::size_t count,
+                double *const valB, Bilinear_interp::Cursor *const cursor = nullptr) const;
+
+    ///
+    /// \brief      Precomputes the line through each interval of every column against a source column
+    /// \details    Lookups from fromA then evaluate the line of the interval found, a single multiply-add, rather
+    ///             than dividing to find the weight of the query within the interval. Their results agree with those
+    ///             of other lookups to within rounding rather than exactly. Replaces any monotone cubic set up for
+    ///             fromA by precomputeMonotoneCubic().
+    /// \param[in]  fromA (Handle of source table)
+    /// \return     N/A
+    ///
+    void precomputeSlopes(ColumnHandle fromA);
+
+    ///
+    /// \brief      Switches lookups from a source column to monotone cubic interpolation
+    /// \details    Computes the coefficients of a monotone cubic through every column against fromA, as
+    ///             Bilinear_interp::computeMonotoneCubic() does, once here rather than on each lookup. Lookups from
+    ///             fromA then give a curve whose slope is continuous across breakpoints and which does not overshoot
+    ///             the data, so a sparser column gives the accuracy of a denser linear one. Replaces any slopes
+    ///             precomputed for fromA by precomputeSlopes(), and is itself replaced by a later call to that.
+    /// \param[in]  fromA (Handle of source table)
+    /// \return     N/A
+    ///
+    void precomputeMonotoneCubic(ColumnHandle fromA);
+
+    ///
+    /// \brief      Gets the counts of the lookups made from a source column
+    /// \details    Counts every lookup from fromA, by name or handle, singly or of several destination tables, since
+    ///             construction or resetTelemetry(), so that how often lookups run off the table can be read at run
+    ///             time. Copies of the table carry on from the counts of the original.
+    /// \param[in]  fromA (Handle of source table)
+    /// \return     Counts of the lookups, which stay empty when AVIONICS_SIM_INTERP_TELEMETRY is 0
+    ///
+    const Bilinear_interp::Telemetry &getTelemetry(ColumnHandle fromA) const;
+
+    ///
+    /// \brief      Clears the counts of the lookups made from every column
+    /// \return     N/A
+    ///
+    void resetTelemetry();
 
   private:
-    /// \brief Hash table containing LUTs.
-    std::unordered_map<std::string, std::vector<double>> lutMap;
+    /// \brief Number of columns.
+    std::size_t columnCount() const {
+        return tableFile ? mappedColumns.size() : columns.size();
+    }
+
+    /// \brief Values of the column at index, within columns or the mapped file.
+    Bilinear_interp::View column(std::size_t index) const {
+        return tableFile ? mappedColumns[index] : Bilinear_interp::View(*columns[index]);
+    }
+
+    /// \brief Hash table mapping column names to their position in columns.
+    std::unordered_map<std::string, std::size_t> columnIndices;
+
+    /// \brief LUT columns, addressed by ColumnHandle::index, shared through the TableRegistry.
+    std::vector<TableRegistry::Table> columns;
+
+    /// \brief Spacing of each column, for when it is used as the source table.
+    std::vector<Bilinear_interp::UniformGrid> grids;
+
+    /// \brief Table file the columns are used from in place of columns, shared with any copies.
+    std::shared_ptr<const TableFile> tableFile;
+
+    /// \brief LUT columns within tableFile, addressed by ColumnHandle::index.
+    std::vector<Bilinear_interp::View> mappedColumns;
+
+    /// \brief Segments of every column against each source column, addressed as segments[fromA.index][inB.index].
+    /// Empty for a source column whose slopes have not been precomputed.
+    std::vector<std::vector<std::vector<Bilinear_interp::Segment>>> segments;
+
+    /// \brief Cubic segments of every column against each source column, addressed as
+    /// cubicSegments[fromA.index][inB.index]. Empty for a source column not switched to cubic interpolation.
+    std::vector<std::vector<std::vector<Bilinear_interp::CubicSegment>>> cubicSegments;
+
+    /// \brief Counts of the lookups made from each source column, addressed by ColumnHandle::index.
+    mutable std::vector<Bilinear_interp::Telemetry> telemetry;
 };
 
 }  // namespace avionics_sim
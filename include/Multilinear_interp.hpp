@@ -0,0 +1,177 @@
+/**
+ * @brief       Multilinear_interp
+ * @file        Multilinear_interp.hpp
+ * @copyright   Copyright (c) 2021, Swift Engineering Inc.
+ * @license     Licensed under the MIT license. See LICENSE for details.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include "Bilinear_interp.hpp"
+
+namespace avionics_sim {
+
+///
+/// \brief      Interpolates a LUT of any number of dimensions, fixed at compile time, over a rectilinear grid.
+///
+/// \details    The table has one ascending set of breakpoints per axis, such as angle of attack, Mach number and
+///             control deflection, and one value for every combination of breakpoints. The values are stored in one
+///             array with the last axis varying fastest, so the 2^Rank corners around a query are found from the
+///             bracket along each axis and a precomputed stride rather than by nested lookups.
+///
+///             Each axis is bracketed and clamped as Bilinear_interp::findBracket() does, and the corners are blended
+///             from the last axis to the first with the same arithmetic as Bilinear_interp. A rank 2 table therefore
+///             gives the same results as a Bilinear_interp whose rows of x values are all the same, with the first axis
+///             as y and the second as x.
+///
+template <std::size_t Rank>
+class Multilinear_interp {
+    static_assert(Rank >= 1, "A table needs at least one axis");
+
+  public:
+    typedef Bilinear_interp::InterpResult InterpResult;
+
+    /// Number of table values around a query which are blended together.
+    static const std::size_t CORNERS = std::size_t(1) << Rank;
+
+    Multilinear_interp() : haveTable(false) {}  ///< Default constructor
+
+    ///
+    /// \brief      Constructs an interpolation object with the table passed at construction.
+    ///
+    /// \details    Has no table if the arguments are not accepted by setTable().
+    /// \param[in]  axes    Breakpoints of each axis, each ascending.
+    /// \param[in]  values  Table values, with the last axis varying fastest.
+    ///
+    Multilinear_interp(const std::array<std::vector<double>, Rank> &axes, const std::vector<double> &values) :
+        haveTable(false) {
+        setTable(axes, values);
+    }
+
+    ///
+    /// \brief      Sets the table.
+    ///
+    /// \param[in]  axes    Breakpoints of each axis, each ascending.
+    /// \param[in]  values  Table values, with the last axis varying fastest, as many as the product of the numbers of
+    ///                     breakpoints.
+    ///
+    /// \return     A bool indicating whether the operation was a success. A failure is returned, and the table left as
+    ///             it was, if an axis has no breakpoints or the number of values does not match them.
+    ///
+    bool setTable(const std::array<std::vector<double>, Rank> &axes, const std::vector<double> &values) {
+        std::size_t size = 1;
+        std::array<std::size_t, Rank> newStrides;
+
+        for (std::size_t d = Rank; d-- > 0;) {
+            if (axes[d].empty()) {
+                return false;
+            }
+
+            newStrides[d] = size;
+            size *= axes[d].size();
+        }
+
+        if (values.size() != size) {
+            return false;
+        }
+
+        axisVals = axes;
+        tableVals = values;
+        strides = newStrides;
+
+        for (std::size_t d = 0; d < Rank; d++) {
+            grids[d] = Bilinear_interp::detectUniformGrid(axisVals[d]);
+        }
+
+        haveTable = true;
+
+        return true;
+    }
+
+    ///
+    /// \brief      Performs a multilinear interpolation of the table.
+    ///
+    /// \details    Clamps to the nearest available data along any axis on which the query is out of bounds.
+    /// \param[in]      point    Location of the query along each axis.
+    /// \param[out]     value    pointer to value to contain interpolation output.
+    /// \param[in,out]  cursors  optional pointer to Rank cursors, one for the searches along each axis.
+    ///
+    /// \return     Returns INTERP_ERROR_NO_LUT if no table is set, otherwise INTERP_WARN_OUT_OF_BOUNDS if the query was
+    ///             clamped along any axis and INTERP_SUCCESS if it was not.
+    ///
+    InterpResult interpolate(const std::array<double, Rank> &point, double *const value,
+                             Bilinear_interp::Cursor *const cursors = nullptr) const {
+        if (!haveTable) {
+            return InterpResult::INTERP_ERROR_NO_LUT;
+        }
+
+        InterpResult errorState = InterpResult::INTERP_SUCCESS;
+        std::array<Bilinear_interp::Bracket, Rank> brackets;
+        std::size_t base = 0;
+
+        for (std::size_t d = 0; d < Rank; d++) {
+            if (Bilinear_interp::findBracket(axisVals[d], grids[d], point[d], &brackets[d],
+                                             cursors ? &cursors[d] : nullptr) != InterpResult::INTERP_SUCCESS) {
+                errorState = InterpResult::INTERP_WARN_OUT_OF_BOUNDS;
+            }
+
+            base += brackets[d].lower * strides[d];
+        }
+
+        // Corner i is above the query along axis d when bit Rank - 1 - d of i is set, so that corners differing only
+        // along the last axis are next to each other.
+        std::array<double, CORNERS> corners;
+
+        for (std::size_t i = 0; i < CORNERS; i++) {
+            std::size_t index = base;
+
+            for (std::size_t d = 0; d < Rank; d++) {
+                if ((i >> (Rank - 1 - d)) & 1) {
+                    index += (brackets[d].upper - brackets[d].lower) * strides[d];
+                }
+            }
+
+            corners[i] = tableVals[index];
+        }
+
+        // Blend out the last remaining axis until a single value is left.
+        for (std::size_t d = Rank, count = CORNERS; d-- > 0;) {
+            count /= 2;
+
+            for (std::size_t i = 0; i < count; i++) {
+                corners[i] = brackets[d].weight * (corners[2 * i + 1] - corners[2 * i]) + corners[2 * i];
+            }
+        }
+
+        *value = corners[0];
+
+        return errorState;
+    }
+
+    ///
+    /// \brief      Gets the breakpoints of an axis.
+    ///
+    /// \return     View of the breakpoints, valid until the table is next set.
+    ///
+    Bilinear_interp::View axis(std::size_t d) const { return axisVals[d]; }
+
+    ///
+    /// \brief      Gets the table values.
+    ///
+    /// \return     View of the values with the last axis varying fastest, valid until the table is next set.
+    ///
+    Bilinear_interp::View values() const { return tableVals; }
+
+  private:
+    std::array<std::vector<double>, Rank> axisVals;        ///< Breakpoints of each axis.
+    std::array<Bilinear_interp::UniformGrid, Rank> grids;  ///< Grid of each axis, detected when the table is set.
+    std::array<std::size_t, Rank> strides;                 ///< Step in tableVals between breakpoints of each axis.
+    std::vector<double> tableVals;                         ///< Table values, with the last axis varying fastest.
+    bool haveTable;                                        ///< Whether a table has been set.
+};
+
+}  // namespace avionics_sim
@@ -0,0 +1,139 @@
+/**
+ * @brief       TableFile class. Read-only, memory mapped binary file of LUT values.
+ * @file        TableFile.hpp
+ * @copyright   Copyright (c) 2021, Swift Engineering Inc.
+ * @license     Licensed under the MIT license. See LICENSE for details.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Bilinear_interp.hpp"
+
+namespace avionics_sim {
+
+///
+/// \brief      Binary file of named LUT arrays, mapped into memory rather than read.
+///
+/// \details    Every process mapping the same file shares the page cache pages holding its values, and tables are
+///             used in place without being parsed or copied. An array is a set of rows of doubles, such as the x, y
+///             or z values of a Bilinear_interp or a column of a LookupTable.
+///
+///             The file, in the byte order of the host that wrote it, is laid out as:
+///             - a 64 byte header: the magic "AVSIMLUT", a byte order mark, the format version, the file size, an
+///               FNV-1a checksum of everything after the header, the number of arrays, and the offset and number of
+///               the values;
+///             - one 64 byte entry per array: its null terminated name, flags, number of rows, and the offset of its
+///               row starts;
+///             - for each array, the index of the start of each row within the values, followed by the end of the
+///               last row, as 64 bit integers;
+///             - the values of every array, as doubles starting on a 64 byte boundary.
+///
+class TableFile {
+  public:
+    /// Version of the format written, and the only one read.
+    static const std::uint32_t VERSION = 1;
+
+    /// Longest array name that can be stored.
+    static const std::size_t MAX_NAME_LENGTH = 39;
+
+    /// Flags stored with each array.
+    enum ArrayFlags : std::uint32_t {
+        ARRAY_UNIFORM_ROWS = 1  ///< Every row is evenly spaced, as detected by Bilinear_interp::detectUniformGrid().
+    };
+
+    ///
+    /// \brief      Array held in a mapped file.
+    ///
+    struct Array {
+        std::string name;            ///< Name the array was written under.
+        std::uint32_t flags;         ///< Combination of ArrayFlags.
+        std::size_t rowCount;        ///< Number of rows.
+        const std::size_t *offsets;  ///< rowCount + 1 indices of the start of each row within data().
+    };
+
+    /// \brief Name and rows of an array to be written.
+    typedef std::pair<std::string, std::vector<std::vector<double>>> ArrayData;
+
+    ///
+    /// \brief      Maps a table file into memory.
+    ///
+    /// \details    Checks the header, the layout of every array and the checksum before returning, so the tables of a
+    ///             file which opens successfully can be used without further checks.
+    /// \param[in]  path   Path of the file.
+    /// \param[out] error  Optional description of why the file could not be opened, set on failure only.
+    ///
+    /// \return     The mapped file, which stays mapped until the last pointer to it is released, or a null pointer if
+    ///             the file could not be opened or is not a valid table file.
+    ///
+    static std::shared_ptr<const TableFile> open(const std::string &path, std::string *const error = nullptr);
+
+    ///
+    /// \brief      Writes a table file.
+    ///
+    /// \details    The file is written beside path, under a name unique to the write, and then renamed over it, so a
+    ///             file being replaced is never seen half written by processes mapping it, and writers of the same path
+    ///             never share a temporary file.
+    /// \param[in]  path    Path of the file.
+    /// \param[in]  arrays  Names and rows of the arrays, in the order they are to be stored.
+    /// \param[out] error   Optional description of why the file could not be written, set on failure only.
+    ///
+    /// \return     A bool indicating whether the file was written.
+    ///
+    static bool write(const std::string &path, const std::vector<ArrayData> &arrays,
+                      std::string *const error = nullptr);
+
+    ///
+    /// \brief      Converts LUT strings into a table file.
+    ///
+    /// \details    Each string is parsed with Bilinear_interp::get2DLUTelementsFromString(), so that a one
+    ///             dimensional string becomes an array of one row.
+    /// \param[in]  path        Path of the file.
+    /// \param[in]  lutStrings  Names of the arrays and the strings holding their values.
+    /// \param[out] error       Optional description of why the file could not be written, set on failure only.
+    ///
+    /// \return     A bool indicating whether the file was written.
+    ///
+    static bool writeFromStrings(const std::string &path,
+                                 const std::vector<std::pair<std::string, std::string>> &lutStrings,
+                                 std::string *const error = nullptr);
+
+    ~TableFile();
+
+    TableFile(const TableFile &) = delete;
+    TableFile &operator=(const TableFile &) = delete;
+
+    ///
+    /// \brief      Finds an array by name.
+    ///
+    /// \return     The array, or a null pointer if the file holds none of that name.
+    ///
+    const Array *find(const std::string &name) const;
+
+    /// \brief Arrays of the file, in the order they were written.
+    const std::vector<Array> &arrays() const { return arrayList; }
+
+    /// \brief Values of every array, which the offsets of each array index into.
+    const double *data() const { return values; }
+
+    /// \brief Views the rows of an array of this file in place.
+    Bilinear_interp::TableView rows(const Array &array) const {
+        return Bilinear_interp::TableView(values, array.offsets, array.rowCount);
+    }
+
+  private:
+    TableFile();
+
+    void *mapping;            ///< Start of the mapped file.
+    std::size_t mappingSize;  ///< Length of the mapping in bytes.
+    const double *values;     ///< Start of the values within the mapping.
+    std::vector<Array> arrayList;
+};
+
+}  // namespace avionics_sim
@@ -0,0 +1,97 @@
+/**
+ * @brief       TableRegistry class. Process-wide store of immutable LUT values shared between tables.
+ * @file        TableRegistry.hpp
+ * @copyright   Copyright (c) 2021, Swift Engineering Inc.
+ * @license     Licensed under the MIT license. See LICENSE for details.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace avionics_sim {
+
+///
+/// \brief      Deduplicates the values of LUTs across every table in the process.
+///
+/// \details    Tables hand their values to intern() and keep the reference returned instead of a vector of their own.
+///             Values identical, bit for bit, to those of a table already registered are not stored again: both tables
+///             refer to the same immutable copy, so a fleet of vehicles loading the same polars holds them once, and
+///             copying a table copies a reference rather than its values. The values are released when the last
+///             reference to them goes, and may be interned from any thread.
+///
+class TableRegistry {
+  public:
+    /// \brief Shared, immutable values of a table.
+    typedef std::shared_ptr<const std::vector<double>> Table;
+
+    ///
+    /// \brief      Memory held by the registry.
+    ///
+    struct Usage {
+        std::size_t tableCount;      ///< Number of distinct sets of values held.
+        std::size_t tableBytes;      ///< Bytes of the values held, each distinct set counted once.
+        std::size_t referenceCount;  ///< Number of references to the values held, from tables and their copies.
+        std::size_t unsharedBytes;   ///< Bytes the references would hold between them were they each a copy.
+    };
+
+    ///
+    /// \brief      Gets the registry of the process.
+    ///
+    /// \details    Never destroyed, so that tables with static storage duration can release their values at exit.
+    ///
+    static TableRegistry &instance();
+
+    ///
+    /// \brief      Gets the shared copy of a set of values.
+    ///
+    /// \param[in]  values  Values of the table, moved into the registry if not already held.
+    ///
+    /// \return     Reference to the values held, which are the same object for every identical set interned while any
+    ///             reference to them remains.
+    ///
+    Table intern(std::vector<double> values);
+
+    ///
+    /// \brief      Measures the memory held by the registry.
+    ///
+    /// \return     The usage at the time of the call.
+    ///
+    Usage usage() const;
+
+    ///
+    /// \brief      Hashes a set of values by their bytes.
+    ///
+    /// \param[in]  values  Values to hash.
+    ///
+    /// \return     64 bit FNV-1a hash of the bytes of the values.
+    ///
+    static std::uint64_t contentHash(const std::vector<double> &values);
+
+  private:
+    /// \brief Entry for a set of values held.
+    struct Entry {
+        const std::vector<double> *values;               ///< Values, for the entry to be found once released.
+        std::weak_ptr<const std::vector<double>> table;  ///< Reference to the values, expired once released.
+    };
+
+    TableRegistry() {}
+    TableRegistry(const TableRegistry &) = delete;
+    TableRegistry &operator=(const TableRegistry &) = delete;
+
+    /// \brief Removes the entry of values whose last reference has gone, and deletes them.
+    void release(std::uint64_t hash, const std::vector<double> *values);
+
+    /// \brief Guards entries.
+    mutable std::mutex mutex;
+
+    /// \brief Values held, by their contentHash().
+    std::unordered_multimap<std::uint64_t, Entry> entries;
+};
+
+}  // namespace avionics_sim
@@ -21,6 +21,7 @@
 // https://ntrs.nasa.gov/archive/nasa/casi.ntrs.nasa.gov/19760017709.pdf
 
 #include <cstddef>
+#include "EnvironmentSnapshot.hpp"
 
 namespace avionics_sim {
 
@@ -100,6 +101,14 @@ class US_1976_atmosphere {
     // kg/m^3
     static double get_mass_density_kg_per_m3(const double geopot_height);
 
+    // NASA-TM-X-74335 eq 50
+    // m/s
+    static double get_speed_of_sound_m_per_s(const double geopot_height);
+
+    // Density, pressure, temperature and speed of sound from a single search of the layers and evaluation of the
+    // pressure, each exactly as the functions above give it
+    static EnvironmentSnapshot get_snapshot(const double geopot_height);
+
     static constexpr double CONSTANTS_STATIC_AIR_PRESSURE_AT_SEA_LEVEL = 101325;    // Pa
     static constexpr double CONSTANTS_AIR_DENSITY_SEA_LEVEL_15C = 1.225;            // kg/m^3
     static constexpr float CONSTANTS_AIR_GAS_CONST = 287.1f;                        // J/(kg*K)
@@ -119,6 +128,9 @@ class US_1976_atmosphere {
     constexpr static double GMR = g_0 * M_0 / R_star * 1000.0;  // g_o' * M_0 / R* in g K/s/s, ~34.163195
     constexpr static double MR = M_0 / R_star;  // M_0 / R* in kg K/m, ~0.0034837
 
+    // ratio of specific heats of air - NASA-TM-X-74335 eq 50
+    constexpr static double gamma = 1.40;
+
     // degC/km
     constexpr static double lapse_rate[] = {-6.5, 0, 1.0, 2.8, 0, -2.8, -2.0, 0};
 };
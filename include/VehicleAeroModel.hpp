@@ -0,0 +1,177 @@
+/**
+ * @brief       VehicleAeroModel
+ * @file        VehicleAeroModel.hpp
+ * @copyright   Copyright (c) 2021, Swift Engineering Inc.
+ * @license     Licensed under the MIT license. See LICENSE for details.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <ignition/math.hh>
+#include "AerodynamicModelT.hpp"
+#include "Airfoil.hpp"
+#include "EnvironmentSnapshot.hpp"
+#include "IPhysicsEnvironment.hpp"
+
+namespace avionics_sim {
+
+///
+/// \brief      Aerodynamic surfaces of a whole vehicle, updated together into a single wrench on its body.
+///
+/// \details    Owns a model of each surface and, per update, takes one rotation of the world into the body and one
+///             snapshot of the environment for all of them. Each surface then goes through
+///             AerodynamicModelT::updateWrenchInBody(), inline and with no virtual call, and the wrenches are summed
+///             in the order surfaces were added.
+///
+///             The surfaces can be split between threads with setThreadCount(), each taking a contiguous run of them.
+///             As each wrench is the same whichever thread calculates it, and the sum is taken afterwards in that
+///             order on the calling thread, the result is exactly, bit for bit, the same for any number of threads.
+///             Waking threads costs microseconds, though, so they only pay off for hundreds of surfaces.
+///
+class VehicleAeroModel {
+  public:
+    /// \brief Model of each surface.
+    typedef AerodynamicModelT<IPhysicsEnvironment, Airfoil> Surface;
+
+    ///
+    /// \brief      Constructor
+    /// \param[in]  environment (Environment of the vehicle, which must outlive the model)
+    ///
+    explicit VehicleAeroModel(IPhysicsEnvironment &environment);
+
+    ///
+    /// \brief      Destructor
+    /// \details    Stops the threads of setThreadCount().
+    ///
+    ~VehicleAeroModel();
+
+    VehicleAeroModel(const VehicleAeroModel &) = delete;
+    VehicleAeroModel &operator=(const VehicleAeroModel &) = delete;
+
+    ///
+    /// \brief      Adds a surface to the vehicle.
+    /// \details    The basis vectors are taken as by AerodynamicModelT::setBasisVectors(). The surface keeps no state,
+    ///             unless raised through getSurface().
+    /// \param[in]  airfoil
+    /// \param[in]  forward Vector3d representing forward vector
+    /// \param[in]  upward Vector3d representing upward vector
+    /// \param[in]  centerOfPressureInBody_m (Where the forces of the surface act, from the origin of the body)
+    /// \return     Index of the surface, in the order surfaces were added
+    ///
+    std::size_t addSurface(Airfoil airfoil, ignition::math::Vector3d forward, ignition::math::Vector3d upward,
+                           ignition::math::Vector3d centerOfPressureInBody_m);
+
+    ///
+    /// \brief      Gets the number of surfaces of the vehicle.
+    ///
+    std::size_t size() const;
+
+    ///
+    /// \brief      Gets the model of a surface, to set its options or read its state and telemetry between updates.
+    /// \param[in]  surface (Index of the surface)
+    ///
+    Surface &getSurface(std::size_t surface);
+
+    ///
+    /// \brief      Gets the wrench of a surface in the last update.
+    /// \param[in]  surface (Index of the surface)
+    ///
+    const AeroWrench &getSurfaceWrench(std::size_t surface) const;
+
+    ///
+    /// \brief      Selects how many threads later updates split the surfaces between.
+    /// \details    The calling thread is one of them, so 1, the default, starts none and 0 is taken as 1.
+    /// \param[in]  threadCount
+    /// \return     N/A
+    ///
+    void setThreadCount(std::size_t threadCount);
+
+    std::size_t getThreadCount() const;
+
+    ///
+    /// \brief      Updates every surface and calculates the resultant wrench on the body.
+    /// \details    Each array holds one element per surface, in the order surfaces were added. The environment is
+    ///             queried once per call. Allocates nothing.
+    ///
+    ///             An exception thrown by a surface is rethrown here, on the calling thread, once every thread has
+    ///             finished with the arrays. Should several threads throw, that of the calling thread is rethrown,
+    ///             else that of the first other thread to finish.
+    /// \param[in]  poseInWorld_m_rad (Pose of the body)
+    /// \param[in]  velocitiesInWorld_m_per_s (Velocity of each surface)
+    /// \param[in]  propWashes_m_per_s
+    /// \param[in]  controlAngles_rad
+    /// \return     Force and moment in body, about its origin
+    ///
+    AeroWrench updateWrenchInBody(
+        const ignition::math::Pose3d &poseInWorld_m_rad,
+        const ignition::math::Vector3d *velocitiesInWorld_m_per_s,
+        const double *propWashes_m_per_s,
+        const double *controlAngles_rad);
+
+    ///
+    /// \brief      Updates every surface as updateWrenchInBody(), in the air of a snapshot taken for the step rather
+    ///             than of the environment, which is not queried.
+    /// \param[in]  environment (State of the air)
+    /// \param[in]  poseInWorld_m_rad (Pose of the body)
+    /// \param[in]  velocitiesInWorld_m_per_s (Velocity of each surface)
+    /// \param[in]  propWashes_m_per_s
+    /// \param[in]  controlAngles_rad
+    /// \return     Force and moment in body, about its origin
+    ///
+    AeroWrench updateWrenchInBody(
+        const EnvironmentSnapshot &environment,
+        const ignition::math::Pose3d &poseInWorld_m_rad,
+        const ignition::math::Vector3d *velocitiesInWorld_m_per_s,
+        const double *propWashes_m_per_s,
+        const double *controlAngles_rad);
+
+  private:
+    /// \brief Calculates the wrenches of the run of surfaces of a thread, from the inputs of the update in progress.
+    void updateRun(std::size_t run);
+
+    /// \brief Waits for updates after generation and calculates the wrenches of its run, until the threads are stopped.
+    void runWorker(std::size_t run, std::size_t generation);
+
+    /// \brief Stops and joins the threads of setThreadCount().
+    void stopWorkers();
+
+    IPhysicsEnvironment *_environment;
+
+    std::vector<Surface> _surfaces;
+
+    /// \brief Wrench of each surface in the last update, kept between calls to spare allocating them.
+    std::vector<AeroWrench> _surfaceWrenches;
+
+    /// \brief Inputs of the update in progress, read by every thread.
+    EnvironmentSnapshot _snapshot;
+    ignition::math::Matrix3d _worldToBody;
+    const ignition::math::Vector3d *_velocitiesInWorld_m_per_s;
+    const double *_propWashes_m_per_s;
+    const double *_controlAngles_rad;
+
+    /// \brief Threads other than the calling one, the first taking the second run of surfaces.
+    std::vector<std::thread> _workers;
+
+    std::mutex _mutex;
+    std::condition_variable _updateStarted;
+    std::condition_variable _runsFinished;
+
+    /// \brief Count of the updates started, by which each thread tells a new one from the last.
+    std::size_t _generation;
+
+    /// \brief Runs of the update in progress which other threads have yet to finish.
+    std::size_t _pendingRuns;
+
+    /// \brief First exception thrown by another thread in the update in progress, for the caller to rethrow.
+    std::exception_ptr _workerException;
+
+    bool _stopping;
+};
+
+}  // namespace avionics_sim
@@ -27,11 +27,13 @@ AerodynamicState::AerodynamicState() {
     liftCoeff = 0.0;
     dragCoeff = 0.0;
     lateralDragCoeff = 0.0;
+    momentCoeff = 0.0;
 
     lift_N = 0.0;
     drag_N = 0.0;
     lateralForce_N = 0.0;
     force_N = ignition::math::Vector3d(0.0, 0.0, 0.0);
+    moment_N_m = ignition::math::Vector3d(0.0, 0.0, 0.0);
 }
 
 
@@ -47,7 +49,8 @@ void AerodynamicState::print() {
             << "CD: " << dragCoeff << '\n'
             << "Lift[N]: " <<  lift_N << '\n'
             << "Drag[N]: " << drag_N << '\n'
-            << "Force[N]: " << force_N << '\n';
+            << "Force[N]: " << force_N << '\n'
+            << "Moment[Nm]: " << moment_N_m << '\n';
 }
 
 }  // namespace avionics_sim
@@ -0,0 +1,165 @@
+/**
+ * @brief       AerodynamicSurfaceSet
+ * @file        AerodynamicSurfaceSet.cpp
+ * @copyright   Copyright (c) 2021, Swift Engineering Inc.
+ * @license     Licensed under the MIT license. See LICENSE for details.
+ */
+
+#include "AerodynamicSurfaceSet.hpp"
+#include "Coordinate_Utils.hpp"
+#include "Math_util.hpp"
+
+#include <cmath>
+
+namespace avionics_sim {
+
+namespace {
+
+/// \brief Model whose flow each surface is resolved as.
+typedef AerodynamicModelT<IPhysicsEnvironment, Airfoil> SurfaceModel;
+
+}  // namespace
+
+AerodynamicSurfaceSet::AerodynamicSurfaceSet(IPhysicsEnvironment &environment) :
+    _environment(&environment),
+    _angleMath(AerodynamicModelOptions::ANGLE_MATH_EXACT) {
+}
+
+std::size_t AerodynamicSurfaceSet::addSurface(Airfoil airfoil, ignition::math::Vector3d forward,
+        ignition::math::Vector3d upward) {
+    // Eliminate any NaN values.
+    forward.Correct();
+    upward.Correct();
+
+    ignition::math::Vector3d port = forward.Cross(upward);
+
+    _airfoils.push_back(airfoil);
+
+    _fwdX.push_back(forward.X());
+    _fwdY.push_back(forward.Y());
+    _fwdZ.push_back(forward.Z());
+    _upwdX.push_back(upward.X());
+    _upwdY.push_back(upward.Y());
+    _upwdZ.push_back(upward.Z());
+    _portX.push_back(port.X());
+    _portY.push_back(port.Y());
+    _portZ.push_back(port.Z());
+    _bodyToSurface.push_back(ignition::math::Matrix3d(
+                                 upward.X(), upward.Y(), upward.Z(),
+                                 forward.X(), forward.Y(), forward.Z(),
+                                 port.X(), port.Y(), port.Z()));
+
+    _area_m2.push_back(airfoil.getArea_m2());
+    _lateralArea_m2.push_back(airfoil.getLateralArea_m2());
+
+    _planarVelocity_m_per_s.push_back(0.0);
+    _lateralVelocity_m_per_s.push_back(0.0);
+    _lateralDirection.push_back(0.0);
+    _liftCoeff.push_back(0.0);
+    _dragCoeff.push_back(0.0);
+    _lateralDragCoeff.push_back(0.0);
+    _cosAttackAngle.push_back(0.0);
+    _sinAttackAngle.push_back(0.0);
+
+    return _airfoils.size() - 1;
+}
+
+std::size_t AerodynamicSurfaceSet::size() const {
+    return _airfoils.size();
+}
+
+Airfoil &AerodynamicSurfaceSet::getAirfoil(std::size_t surface) {
+    return _airfoils[surface];
+}
+
+void AerodynamicSurfaceSet::setAngleMath(AerodynamicModelOptions::AngleMath angleMath) {
+    _angleMath = angleMath;
+}
+
+AerodynamicModelOptions::AngleMath AerodynamicSurfaceSet::getAngleMath() const {
+    return _angleMath;
+}
+
+void AerodynamicSurfaceSet::updateForcesInBody_N(
+    const ignition::math::Pose3d *posesInWorld_m_rad,
+    const ignition::math::Vector3d *velocitiesInWorld_m_per_s,
+    const double *propWashes_m_per_s,
+    const double *controlAngles_rad,
+    ignition::math::Vector3d *forcesInBody_N) {
+    updateForcesInBodyAtDensity_N(_environment->get_air_density_kg_per_m3(), posesInWorld_m_rad,
+                                  velocitiesInWorld_m_per_s, propWashes_m_per_s, controlAngles_rad, forcesInBody_N);
+}
+
+void AerodynamicSurfaceSet::updateForcesInBody_N(
+    const EnvironmentSnapshot &environment,
+    const ignition::math::Pose3d *posesInWorld_m_rad,
+    const ignition::math::Vector3d *velocitiesInWorld_m_per_s,
+    const double *propWashes_m_per_s,
+    const double *controlAngles_rad,
+    ignition::math::Vector3d *forcesInBody_N) {
+    updateForcesInBodyAtDensity_N(environment.airDensity_kg_per_m3, posesInWorld_m_rad, velocitiesInWorld_m_per_s,
+                                  propWashes_m_per_s, controlAngles_rad, forcesInBody_N);
+}
+
+void AerodynamicSurfaceSet::updateForcesInBodyAtDensity_N(
+    double airDensity_kg_per_m3,
+    const ignition::math::Pose3d *posesInWorld_m_rad,
+    const ignition::math::Vector3d *velocitiesInWorld_m_per_s,
+    const double *propWashes_m_per_s,
+    const double *controlAngles_rad,
+    ignition::math::Vector3d *forcesInBody_N) {
+    const std::size_t count = size();
+
+    // The steps of AerodynamicModel::updateForcesInBody_N(), in the same order, as anything else would round
+    // differently. First those which rotate, resolve the flow or look up tables, one surface at a time.
+    for (std::size_t i = 0; i < count; i++) {
+        ignition::math::Vector3d velocityInBody_m_per_s;
+
+        Coordinate_Utils::project_vector_global(posesInWorld_m_rad[i], velocitiesInWorld_m_per_s[i],
+                                                &velocityInBody_m_per_s);
+
+        double planarVelocity_m_per_s;
+        double lateralVelocity_m_per_s;
+        double angleOfAttack_rad;
+        double sideSlipAngle_rad;
+
+        SurfaceModel::resolveFlow(_bodyToSurface[i], _angleMath, velocityInBody_m_per_s, propWashes_m_per_s[i],
+                                  controlAngles_rad[i], &planarVelocity_m_per_s, &lateralVelocity_m_per_s,
+                                  &angleOfAttack_rad, &sideSlipAngle_rad);
+
+        double sideSlipAngle_deg = RAD2DEG(sideSlipAngle_rad);
+        AeroCoefficients coefficients = _airfoils[i].calculateCoefficients(RAD2DEG(angleOfAttack_rad));
+
+        _planarVelocity_m_per_s[i] = planarVelocity_m_per_s;
+        _lateralVelocity_m_per_s[i] = lateralVelocity_m_per_s;
+        _lateralDirection[i] = ignition::math::sgn(sideSlipAngle_deg);
+        _liftCoeff[i] = coefficients.lift;
+        _dragCoeff[i] = coefficients.drag;
+        _lateralDragCoeff[i] = _airfoils[i].calculateSideSlipCoefficient(sideSlipAngle_deg);
+        _cosAttackAngle[i] = cos(angleOfAttack_rad);
+        _sinAttackAngle[i] = sin(angleOfAttack_rad);
+    }
+
+    // Then the forces, which are arithmetic on the arrays alone.
+    for (std::size_t i = 0; i < count; i++) {
+        double dynamicPressurePlanar_Pa = 0.5 * airDensity_kg_per_m3 * _planarVelocity_m_per_s[i] *
+                                          _planarVelocity_m_per_s[i];
+        double dynamicPressureLateral_Pa = 0.5 * airDensity_kg_per_m3 * _lateralVelocity_m_per_s[i] *
+                                           _lateralVelocity_m_per_s[i];
+
+        double lift_N = _liftCoeff[i] * dynamicPressurePlanar_Pa * _area_m2[i];
+        double drag_N = _dragCoeff[i] * dynamicPressurePlanar_Pa * _area_m2[i];
+        double lateralForce_N = dynamicPressureLateral_Pa * _lateralDragCoeff[i] * _lateralArea_m2[i];
+
+        double rotated_lift_N = (lift_N * _cosAttackAngle[i]) + (drag_N * _sinAttackAngle[i]);
+        double rotated_drag_N = (lift_N * _sinAttackAngle[i]) - (drag_N * _cosAttackAngle[i]);
+        double oriented_lateral_N = _lateralDirection[i] * lateralForce_N;
+
+        forcesInBody_N[i].Set(
+            rotated_lift_N * _upwdX[i] + rotated_drag_N * _fwdX[i] + oriented_lateral_N * _portX[i],
+            rotated_lift_N * _upwdY[i] + rotated_drag_N * _fwdY[i] + oriented_lateral_N * _portY[i],
+            rotated_lift_N * _upwdZ[i] + rotated_drag_N * _fwdZ[i] + oriented_lateral_N * _portZ[i]);
+    }
+}
+
+}  // namespace avionics_sim
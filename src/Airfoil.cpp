@@ -17,7 +17,10 @@ Airfoil::Airfoil() :
     _ANGLE_OF_ATTACK_ID, _CL_ID, _CD_ID
 }, {
     {0}, {0}, {0}
-}) {
+}),
+_fixedTable(nullptr),
+_fixedCoefficients(nullptr) {
+    resolveColumns();
 }
 
 Airfoil::Airfoil(
@@ -25,22 +28,92 @@ Airfoil::Airfoil(
     double lateralArea_m2,
     const std::vector<double> &angleOfAttacks_deg,
     const std::vector<double> &cls,
-    const std::vector<double> &cds) {
+    const std::vector<double> &cds) :
+    _fixedTable(nullptr),
+    _fixedCoefficients(nullptr) {
 
     _area_m2 = area_m2;
     _lateralArea_m2 = lateralArea_m2;
     _aeroLUT_deg = LookupTable(
     {_ANGLE_OF_ATTACK_ID, _CL_ID, _CD_ID}, {angleOfAttacks_deg, cls, cds});
+    resolveColumns();
+}
+
+Airfoil::Airfoil(
+    double area_m2,
+    double lateralArea_m2,
+    double chord_m,
+    const std::vector<double> &angleOfAttacks_deg,
+    const std::vector<double> &cls,
+    const std::vector<double> &cds,
+    const std::vector<double> &cms) :
+    _fixedTable(nullptr),
+    _fixedCoefficients(nullptr) {
+
+    _area_m2 = area_m2;
+    _lateralArea_m2 = lateralArea_m2;
+    _chord_m = chord_m;
+    _aeroLUT_deg = LookupTable(
+    {_ANGLE_OF_ATTACK_ID, _CL_ID, _CD_ID, _CM_ID}, {angleOfAttacks_deg, cls, cds, cms});
+    _hasMomentCoefficients = true;
+    resolveColumns();
+}
+
+void Airfoil::resolveColumns() {
+    _angleOfAttackColumn = _aeroLUT_deg.resolveColumn(_ANGLE_OF_ATTACK_ID);
+    _clColumn = _aeroLUT_deg.resolveColumn(_CL_ID);
+    _cdColumn = _aeroLUT_deg.resolveColumn(_CD_ID);
+
+    if (_hasMomentCoefficients) {
+        _cmColumn = _aeroLUT_deg.resolveColumn(_CM_ID);
+    }
+
+    _angleOfAttackCursor = Bilinear_interp::Cursor();
 }
 
 double Airfoil::calculateLiftCoefficient(double angleOfAttack_deg) {
-    return _aeroLUT_deg.lookup(angleOfAttack_deg, _ANGLE_OF_ATTACK_ID, _CL_ID);
+    if (_fixedTable) {
+        return _fixedCoefficients(_fixedTable, angleOfAttack_deg, &_fixedTelemetry).lift;
+    }
+
+    return _aeroLUT_deg.lookup(angleOfAttack_deg, _angleOfAttackColumn, _clColumn, &_angleOfAttackCursor);
 }
 
 double Airfoil::calculateDragCoefficient(double angleOfAttack_deg) {
-    return _aeroLUT_deg.lookup(angleOfAttack_deg, _ANGLE_OF_ATTACK_ID, _CD_ID);
+    if (_fixedTable) {
+        return _fixedCoefficients(_fixedTable, angleOfAttack_deg, &_fixedTelemetry).drag;
+    }
+
+    return _aeroLUT_deg.lookup(angleOfAttack_deg, _angleOfAttackColumn, _cdColumn, &_angleOfAttackCursor);
+}
+
+AeroCoefficients Airfoil::calculateCoefficients(double angleOfAttack_deg) {
+    if (_fixedTable) {
+        return _fixedCoefficients(_fixedTable, angleOfAttack_deg, &_fixedTelemetry);
+    }
+
+    const LookupTable::ColumnHandle columns[] = {_clColumn, _cdColumn};
+    double values[2];
+
+    _aeroLUT_deg.lookup(angleOfAttack_deg, _angleOfAttackColumn, columns, 2, values, &_angleOfAttackCursor);
+
+    AeroCoefficients coefficients = {values[0], values[1], 0.0};
+    return coefficients;
 }
 
+AeroCoefficients Airfoil::calculateCoefficientsWithMoment(double angleOfAttack_deg) {
+    if (!_hasMomentCoefficients) {
+        return calculateCoefficients(angleOfAttack_deg);
+    }
+
+    const LookupTable::ColumnHandle columns[] = {_clColumn, _cdColumn, _cmColumn};
+    double values[3];
+
+    _aeroLUT_deg.lookup(angleOfAttack_deg, _angleOfAttackColumn, columns, 3, values, &_angleOfAttackCursor);
+
+    AeroCoefficients coefficients = {values[0], values[1], values[2]};
+    return coefficients;
+}
 
 double Airfoil::calculateSideSlipCoefficient(double sideSlipAngle_deg) {
     return _sideSlipCoefficient;
@@ -54,4 +127,17 @@ double Airfoil::getLateralArea_m2() {
     return _lateralArea_m2;
 }
 
+double Airfoil::getChord_m() {
+    return _chord_m;
+}
+
+const Bilinear_interp::Telemetry &Airfoil::getTelemetry() const {
+    return _fixedTable ? _fixedTelemetry : _aeroLUT_deg.getTelemetry(_angleOfAttackColumn);
+}
+
+void Airfoil::resetTelemetry() {
+    _fixedTelemetry = Bilinear_interp::Telemetry();
+    _aeroLUT_deg.resetTelemetry();
+}
+
 }  // namespace avionics_sim
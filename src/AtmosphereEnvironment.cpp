@@ -0,0 +1,32 @@
+/**
+ * @brief       AtmosphereEnvironment
+ * @file        AtmosphereEnvironment.cpp
+ * @copyright   Copyright (c) 2021, Swift Engineering Inc.
+ * @license     Licensed under the MIT license. See LICENSE for details.
+ */
+
+#include "AtmosphereEnvironment.hpp"
+
+namespace avionics_sim {
+
+AtmosphereEnvironment::AtmosphereEnvironment(double geometricHeight_m) :
+    _height(Geopotential_height::from_geomet_height(geometricHeight_m)) {
+}
+
+void AtmosphereEnvironment::set_geometric_height_m(double geometricHeight_m) {
+    _height = Geopotential_height::from_geomet_height(geometricHeight_m);
+}
+
+double AtmosphereEnvironment::get_geometric_height_m() const {
+    return _height.get_geomet_height();
+}
+
+double AtmosphereEnvironment::get_air_density_kg_per_m3() {
+    return US_1976_atmosphere::get_mass_density_kg_per_m3(_height.get_geopot_height());
+}
+
+EnvironmentSnapshot AtmosphereEnvironment::get_snapshot() {
+    return US_1976_atmosphere::get_snapshot(_height.get_geopot_height());
+}
+
+}  // namespace avionics_sim
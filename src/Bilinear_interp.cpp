@@ -7,143 +7,780 @@
  */
 
 #include "Bilinear_interp.hpp"
+#include "TableFile.hpp"
 
-#include <sstream>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
 #include <cstdlib>
 #include <iostream>
 #include <fstream>
+#include <utility>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define BILINEAR_INTERP_AVX2
+#include <immintrin.h>
+#endif
 
 
 namespace avionics_sim {
-Bilinear_interp::Bilinear_interp() {
+constexpr double Bilinear_interp::UNIFORM_GRID_TOLERANCE;
+
+// Grid of breakpoints which have not been checked for even spacing. Searches on it use std::lower_bound.
+static const Bilinear_interp::UniformGrid unknownGrid = {false, 0.0, 0.0};
+
+#if defined(BILINEAR_INTERP_AVX2)
+// Layout of a table whose Y values and rows of X values are all uniform, as read by the AVX2 batch kernel.
+struct UniformBatchTable {
+    const double *values;             // Values of X and Z, row after row
+    const long long *xRowOffsets;     // Start of each row of X in values, followed by the end of the last
+    const long long *zRowOffsets;     // Start of each row of Z in values
+    const double *rowGrids;           // First breakpoint, reciprocal spacing and last breakpoint of each row of X
+    const double *yv;
+    long long yLast;                  // Index of the last Y value
+    double y0;
+    double invDy;
+};
+
+// Vectorised lowerBound() on uniform breakpoints, for four queries q whose breakpoints run from base[start] to
+// base[start + last]. The answer is found if it is the interval the uniform spacing gives or the one after; lanes
+// where it is not are cleared in *found. Also gives the breakpoints at the answer and before it, where there is one.
+__attribute__((target("avx2"), always_inline))
+static inline __m256i lowerBoundUniformAvx2(const double *const base, __m256i start, __m256i last, __m256d x0,
+        __m256d invDx, __m256d q, __m256i *const found, __m256d *const lowerValue, __m256d *const upperValue) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi64x(1);
+    const __m256i all = _mm256_set1_epi64x(-1);
+
+    // Same clamping as lowerBound(), in a range that converts to an integer.
+    __m256d position = _mm256_mul_pd(_mm256_sub_pd(q, x0), invDx);
+    position = _mm256_min_pd(_mm256_max_pd(position, _mm256_setzero_pd()), _mm256_set1_pd(1 << 30));
+    __m256i i = _mm256_cvtepi32_epi64(_mm256_cvttpd_epi32(position));
+    i = _mm256_blendv_epi8(i, last, _mm256_cmpgt_epi64(i, last));
+
+    // Breakpoints at i and either side of it, or at i where there is none on that side.
+    __m256i hasBelow = _mm256_cmpgt_epi64(i, zero);
+    __m256i hasAbove = _mm256_cmpgt_epi64(last, i);
+    __m256i index = _mm256_add_epi64(start, i);
+    __m256d below = _mm256_i64gather_pd(base, _mm256_sub_epi64(index, _mm256_and_si256(hasBelow, one)), 8);
+    __m256d at = _mm256_i64gather_pd(base, index, 8);
+    __m256d above = _mm256_i64gather_pd(base, _mm256_add_epi64(index, _mm256_and_si256(hasAbove, one)), 8);
+
+    // The answer is i if the breakpoint below is less than q, or i + 1 if the breakpoint at i is.
+    __m256i atNotLess = _mm256_castpd_si256(_mm256_cmp_pd(at, q, _CMP_GE_OQ));
+    __m256i belowLess = _mm256_castpd_si256(_mm256_cmp_pd(below, q, _CMP_LT_OQ));
+    __m256i aboveNotLess = _mm256_castpd_si256(_mm256_cmp_pd(above, q, _CMP_GE_OQ));
+    __m256i atAnswer = _mm256_and_si256(atNotLess, _mm256_or_si256(_mm256_andnot_si256(hasBelow, all), belowLess));
+    __m256i aboveAnswer = _mm256_and_si256(_mm256_andnot_si256(atNotLess, hasAbove), aboveNotLess);
+
+    *found = _mm256_or_si256(atAnswer, aboveAnswer);
+    *lowerValue = _mm256_blendv_pd(below, at, _mm256_castsi256_pd(aboveAnswer));
+    *upperValue = _mm256_blendv_pd(at, above, _mm256_castsi256_pd(aboveAnswer));
+    return _mm256_add_epi64(i, _mm256_and_si256(aboveAnswer, one));
+}
+
+// Vectorised findBracket() on uniform rows of X, giving the indices of the bracketing Z values in values.
+__attribute__((target("avx2"), always_inline))
+static inline void findBracketUniformAvx2(const UniformBatchTable &table, __m256i row, __m256d x,
+        __m256i *const zLower, __m256i *const zUpper, __m256d *const weight, __m256i *const belowFirst,
+        __m256i *const beyondLast, __m256i *const found) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi64x(1);
+
+    __m256i gridIndex = _mm256_add_epi64(_mm256_add_epi64(row, row), row);
+    __m256d front = _mm256_i64gather_pd(table.rowGrids, gridIndex, 8);
+    __m256d invDx = _mm256_i64gather_pd(table.rowGrids, _mm256_add_epi64(gridIndex, one), 8);
+    __m256d back = _mm256_i64gather_pd(table.rowGrids, _mm256_add_epi64(gridIndex, _mm256_set1_epi64x(2)), 8);
+
+    __m256i xStart = _mm256_i64gather_epi64(table.xRowOffsets, row, 8);
+    __m256i last = _mm256_sub_epi64(_mm256_i64gather_epi64(table.xRowOffsets, _mm256_add_epi64(row, one), 8),
+                                    _mm256_add_epi64(xStart, one));
+    __m256i zStart = _mm256_i64gather_epi64(table.zRowOffsets, row, 8);
+
+    __m256i notBelow = _mm256_castpd_si256(_mm256_cmp_pd(x, front, _CMP_GE_OQ));
+    __m256i notAbove = _mm256_castpd_si256(_mm256_cmp_pd(x, back, _CMP_LE_OQ));
+    __m256i inRange = _mm256_and_si256(notBelow, notAbove);
+
+    // Within the row, exactly on the first breakpoint gives a bracket of it alone.
+    __m256i searchFound;
+    __m256d x_l, x_u;
+    __m256i upper = lowerBoundUniformAvx2(table.values, xStart, last, front, invDx, x, &searchFound, &x_l, &x_u);
+    __m256i hasLower = _mm256_cmpgt_epi64(upper, zero);
+    __m256i lower = _mm256_sub_epi64(upper, _mm256_and_si256(hasLower, one));
+
+    __m256d w = _mm256_div_pd(_mm256_sub_pd(x, x_l), _mm256_sub_pd(x_u, x_l));
+    w = _mm256_and_pd(w, _mm256_castsi256_pd(_mm256_and_si256(hasLower, inRange)));
+
+    // Beyond the row, clamped to its last or first breakpoint.
+    __m256i beyond = _mm256_andnot_si256(notAbove, notBelow);
+    lower = _mm256_and_si256(notBelow, lower);
+    upper = _mm256_and_si256(notBelow, upper);
+    lower = _mm256_blendv_epi8(lower, last, beyond);
+    upper = _mm256_blendv_epi8(upper, last, beyond);
+
+    *zLower = _mm256_add_epi64(zStart, lower);
+    *zUpper = _mm256_add_epi64(zStart, upper);
+    *weight = w;
+    *belowFirst = _mm256_xor_si256(notBelow, _mm256_set1_epi64x(-1));
+    *beyondLast = beyond;
+    *found = _mm256_or_si256(_mm256_and_si256(searchFound, inRange), _mm256_xor_si256(inRange,
+                             _mm256_set1_epi64x(-1)));
+}
+
+// Number of points the AVX2 batch kernel takes at most.
+static const std::size_t AVX2_CHUNK_SIZE = 64;
+
+// Points of a chunk clamped in each way, bit i for point i.
+struct ChunkBounds {
+    std::uint64_t xBelow;  // Below the first breakpoint of either row interpolated from, or NaN
+    std::uint64_t xAbove;  // Above the last breakpoint of either row interpolated from
+    std::uint64_t yBelow;  // Below the first row, or NaN
+    std::uint64_t yAbove;  // Above the last row
+};
+
+// Performs interpolate2D() for count points, a multiple of four up to AVX2_CHUNK_SIZE, with the same operations in
+// the same order, so that the results are identical. Sets bit i of *needsSearch if point i needs the scalar search
+// instead, in which case its output is not valid, and bit i of *outOfBounds if point i was clamped. Sets the bits of
+// *bounds likewise for each way point i was clamped, for it to be counted in Bilinear_interp::Telemetry.
+//
+// Each step is done for every point before the next, so that the lookups of neighbouring points overlap rather than
+// each point waiting on its own chain of lookups.
+__attribute__((target("avx2")))
+static void interpolateUniformChunkAvx2(const UniformBatchTable &table, const double *const x,
+                                        const double *const y, std::size_t count, double *const z,
+                                        std::uint64_t *const needsSearch, std::uint64_t *const outOfBounds,
+                                        ChunkBounds *const bounds) {
+    const __m256i one = _mm256_set1_epi64x(1);
+    const __m256i all = _mm256_set1_epi64x(-1);
+
+    alignas(32) long long lowerRow[AVX2_CHUNK_SIZE], upperRow[AVX2_CHUNK_SIZE], twoRows[AVX2_CHUNK_SIZE];
+    alignas(32) double rowWeight[AVX2_CHUNK_SIZE];
+    alignas(32) long long lowerRowLower[AVX2_CHUNK_SIZE], lowerRowUpper[AVX2_CHUNK_SIZE];
+    alignas(32) long long upperRowLower[AVX2_CHUNK_SIZE], upperRowUpper[AVX2_CHUNK_SIZE];
+    alignas(32) double lowerRowWeight[AVX2_CHUNK_SIZE], upperRowWeight[AVX2_CHUNK_SIZE];
+
+    std::uint64_t search = 0;
+    std::uint64_t out = 0;
+    ChunkBounds clamped = {0, 0, 0, 0};
+
+    __m256d yFront = _mm256_set1_pd(table.yv[0]);
+    __m256d yBack = _mm256_set1_pd(table.yv[table.yLast]);
+
+    // Rows either side of y, or the first or last row alone
+    for (std::size_t i = 0; i < count; i += 4) {
+        __m256d yq = _mm256_loadu_pd(y + i);
+
+        // Bound y using first and last rows of the table
+        __m256d yBelow = _mm256_cmp_pd(yq, yFront, _CMP_LT_OQ);
+        __m256d yAbove = _mm256_cmp_pd(yq, yBack, _CMP_GT_OQ);
+        __m256d yClamped = _mm256_blendv_pd(_mm256_blendv_pd(yq, yBack, yAbove), yFront, yBelow);
+
+        __m256i found;
+        __m256d y_l, y_u;
+        __m256i iy_u = lowerBoundUniformAvx2(table.yv, _mm256_setzero_si256(), _mm256_set1_epi64x(table.yLast),
+                                             _mm256_set1_pd(table.y0), _mm256_set1_pd(table.invDy), yClamped,
+                                             &found, &y_l, &y_u);
+
+        __m256i onFront = _mm256_castpd_si256(_mm256_cmp_pd(yClamped, yFront, _CMP_EQ_OQ));
+        __m256i onBack = _mm256_castpd_si256(_mm256_cmp_pd(yClamped, yBack, _CMP_EQ_OQ));
+        __m256i between = _mm256_andnot_si256(_mm256_or_si256(onFront, onBack), all);
+        iy_u = _mm256_add_epi64(iy_u, _mm256_and_si256(onFront, one));
+        __m256i lower = _mm256_sub_epi64(iy_u, _mm256_and_si256(_mm256_or_si256(between, onFront), one));
+        lower = _mm256_and_si256(lower, found);  // Keep the rows of points left to the scalar search in the table
+        iy_u = _mm256_and_si256(iy_u, found);
+
+        _mm256_store_si256(reinterpret_cast<__m256i *>(lowerRow + i), lower);
+        _mm256_store_si256(reinterpret_cast<__m256i *>(upperRow + i), _mm256_blendv_epi8(lower, iy_u, between));
+        _mm256_store_si256(reinterpret_cast<__m256i *>(twoRows + i), between);
+
+        // Only used between two rows, where y_l and y_u are the values of the lower and upper rows
+        _mm256_store_pd(rowWeight + i, _mm256_div_pd(_mm256_sub_pd(yq, y_l), _mm256_sub_pd(y_u, y_l)));
+
+        search |= static_cast<std::uint64_t>(_mm256_movemask_pd(_mm256_castsi256_pd(found)) ^ 0xF) << i;
+        out |= static_cast<std::uint64_t>(_mm256_movemask_pd(_mm256_or_pd(yBelow, yAbove))) << i;
+
+        // Counted as a NaN is, as below the first row
+        clamped.yBelow |= static_cast<std::uint64_t>(_mm256_movemask_pd(_mm256_cmp_pd(yq, yFront, _CMP_NGE_UQ))) << i;
+        clamped.yAbove |= static_cast<std::uint64_t>(_mm256_movemask_pd(yAbove)) << i;
+    }
+
+    // Intervals of x within each row
+    for (std::size_t i = 0; i < count; i += 4) {
+        __m256d xq = _mm256_loadu_pd(x + i);
+        __m256i lowerFound, upperFound, lowerBelow, upperBelow, lowerBeyond, upperBeyond, lower, upper;
+        __m256d weight;
+
+        findBracketUniformAvx2(table, _mm256_load_si256(reinterpret_cast<const __m256i *>(lowerRow + i)), xq,
+                               &lower, &upper, &weight, &lowerBelow, &lowerBeyond, &lowerFound);
+        _mm256_store_si256(reinterpret_cast<__m256i *>(lowerRowLower + i), lower);
+        _mm256_store_si256(reinterpret_cast<__m256i *>(lowerRowUpper + i), upper);
+        _mm256_store_pd(lowerRowWeight + i, weight);
+
+        findBracketUniformAvx2(table, _mm256_load_si256(reinterpret_cast<const __m256i *>(upperRow + i)), xq,
+                               &lower, &upper, &weight, &upperBelow, &upperBeyond, &upperFound);
+        _mm256_store_si256(reinterpret_cast<__m256i *>(upperRowLower + i), lower);
+        _mm256_store_si256(reinterpret_cast<__m256i *>(upperRowUpper + i), upper);
+        _mm256_store_pd(upperRowWeight + i, weight);
+
+        __m256i found = _mm256_and_si256(lowerFound, upperFound);
+        search |= static_cast<std::uint64_t>(_mm256_movemask_pd(_mm256_castsi256_pd(found)) ^ 0xF) << i;
+        __m256i below = _mm256_or_si256(lowerBelow, upperBelow);
+        __m256i beyond = _mm256_or_si256(lowerBeyond, upperBeyond);
+        out |= static_cast<std::uint64_t>(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_or_si256(below,
+                                          beyond)))) << i;
+
+        clamped.xBelow |= static_cast<std::uint64_t>(_mm256_movemask_pd(_mm256_castsi256_pd(below))) << i;
+        clamped.xAbove |= static_cast<std::uint64_t>(_mm256_movemask_pd(_mm256_castsi256_pd(beyond))) << i;
+    }
+
+    // Interpolate within each row, then between the rows
+    for (std::size_t i = 0; i < count; i += 4) {
+        __m256i ll = _mm256_load_si256(reinterpret_cast<const __m256i *>(lowerRowLower + i));
+        __m256i lu = _mm256_load_si256(reinterpret_cast<const __m256i *>(lowerRowUpper + i));
+        __m256i ul = _mm256_load_si256(reinterpret_cast<const __m256i *>(upperRowLower + i));
+        __m256i uu = _mm256_load_si256(reinterpret_cast<const __m256i *>(upperRowUpper + i));
+
+        __m256d z_ll = _mm256_i64gather_pd(table.values, ll, 8);
+        __m256d z_lu = _mm256_i64gather_pd(table.values, lu, 8);
+        __m256d z_l = _mm256_add_pd(_mm256_mul_pd(_mm256_load_pd(lowerRowWeight + i), _mm256_sub_pd(z_lu, z_ll)),
+                                    z_ll);
+
+        __m256d z_ul = _mm256_i64gather_pd(table.values, ul, 8);
+        __m256d z_uu = _mm256_i64gather_pd(table.values, uu, 8);
+        __m256d z_u = _mm256_add_pd(_mm256_mul_pd(_mm256_load_pd(upperRowWeight + i), _mm256_sub_pd(z_uu, z_ul)),
+                                    z_ul);
+
+        __m256d z_2 = _mm256_add_pd(_mm256_mul_pd(_mm256_load_pd(rowWeight + i), _mm256_sub_pd(z_u, z_l)), z_l);
+        __m256d between = _mm256_load_pd(reinterpret_cast<const double *>(twoRows + i));
+        _mm256_storeu_pd(z + i, _mm256_blendv_pd(z_l, z_2, between));
+    }
+
+    *needsSearch = search;
+    *outOfBounds = out;
+    *bounds = clamped;
+}
+
+// Counts the points of a chunk in counted against the bounds of one axis, as Bilinear_interp::Telemetry::record() would
+// count them one at a time, from bits set for points below and above the bounds.
+static void countChunk(const double *const q, std::size_t count, std::uint64_t counted, std::uint64_t below,
+                       std::uint64_t above, Bilinear_interp::Telemetry *const telemetry) {
+#if AVIONICS_SIM_INTERP_TELEMETRY
+    above &= ~below;
+    telemetry->hits += __builtin_popcountll(counted & ~below & ~above);
+    telemetry->lowClamps += __builtin_popcountll(counted & below);
+    telemetry->highClamps += __builtin_popcountll(counted & above);
+
+    // Over every point, as those left to the search give the same extremes when counted there.
+    double minQuery = telemetry->minQuery;
+    double maxQuery = telemetry->maxQuery;
+
+    for (std::size_t i = 0; i < count; i++) {
+        minQuery = q[i] < minQuery ? q[i] : minQuery;
+        maxQuery = q[i] > maxQuery ? q[i] : maxQuery;
+    }
+
+    telemetry->minQuery = minQuery;
+    telemetry->maxQuery = maxQuery;
+#else
+    (void)q;
+    (void)count;
+    (void)counted;
+    (void)below;
+    (void)above;
+    (void)telemetry;
+#endif
+}
+#endif
+
+// Whether the batched interpolate2D() can use AVX2 on this processor.
+static bool haveAvx2() {
+#if defined(BILINEAR_INTERP_AVX2)
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+// Copies rows one after the other into values, recording where each starts and where the last ends in offsets.
+static void flattenRows(const std::vector<std::vector<double>> &rows, std::vector<double> *const values,
+                        std::vector<std::size_t> *const offsets) {
+    offsets->push_back(values->size());
+
+    for (const std::vector<double> &row : rows) {
+        values->insert(values->end(), row.begin(), row.end());
+        offsets->push_back(values->size());
+    }
+}
+
+// Interpolates a row of values, held as doubles or at a lower precision, at a bracket of its x values.
+template <typename Row>
+static inline double interpolateRow(const Row &yv, const Bilinear_interp::Bracket &bracket) {
+    double y_l = yv[bracket.lower];
+    double y_u = yv[bracket.upper];
+
+    // Perform linear interpolation
+    return bracket.weight * (y_u - y_l) + y_l;
+}
+
+// Rows of z values stored in single precision, read as doubles.
+struct Float32Rows {
+    struct Row {
+        const float *values;
+        double operator[](std::size_t i) const { return values[i]; }
+    };
+
+    const float *values;
+    const std::size_t *offsets;  // zRowOffsets, whose first entry is the start of values
+
+    Row operator[](std::size_t row) const {
+        Row r = {values + (offsets[row] - offsets[0])};
+        return r;
+    }
+};
+
+// Rows of z values stored as 16 bit integers, read as offset + scale * q.
+struct Fixed16Rows {
+    struct Row {
+        const std::int16_t *values;
+        double scale, offset;
+        double operator[](std::size_t i) const { return offset + scale * values[i]; }
+    };
+
+    const std::int16_t *values;
+    const std::size_t *offsets;  // zRowOffsets, whose first entry is the start of values
+    double scale, offset;
+
+    Row operator[](std::size_t row) const {
+        Row r = {values + (offsets[row] - offsets[0]), scale, offset};
+        return r;
+    }
+};
+
+// Appends the comma separated values running from begin up to end to row, reading each as sscanf("%lf") would. end
+// must point at a semicolon or at the terminating null; strtod stops at either, and at commas, so it never reads past
+// end. On failure, column receives the index of the value which is not a number.
+static bool parseLUTRow(const char *begin, const char *const end, std::vector<double> *const row,
+                        std::size_t *const column) {
+    row->reserve(row->size() + std::count(begin, end, ',') + 1);
+
+    for (std::size_t i = 0; ; i++) {
+        char *next;
+        double value = std::strtod(begin, &next);
+
+        if (next == begin) {
+            *column = i;
+            return false;
+        }
+
+        row->push_back(value);
+
+        // Anything after the number is ignored, as it is by sscanf.
+        begin = std::find(static_cast<const char *>(next), end, ',');
+
+        if (begin == end) {
+            return true;
+        }
+
+        begin++;
+    }
+}
+
+Bilinear_interp::Bilinear_interp() :
+    usePrecomputedSlopes(false), storageMode(STORAGE_DOUBLE), zFixed16Scale(0.0), zFixed16Offset(0.0), storageError(),
+    mappedTableValues(nullptr) {
     haveXVals = false;
     haveYVals = false;
     haveZVals = false;
+
+    yGrid = unknownGrid;
 }
 
 Bilinear_interp::Bilinear_interp(const std::vector<std::vector<double>> &xv,
-                                 const std::vector<double> &yv, const std::vector<std::vector<double>> &zv) {
-    xVals = xv;
-    yVals = yv;
-    zVals = zv;
-
-    haveXVals = true;
-    haveYVals = true;
-    haveZVals = true;
+                                 const std::vector<double> &yv, const std::vector<std::vector<double>> &zv) :
+    usePrecomputedSlopes(false), storageMode(STORAGE_DOUBLE), zFixed16Scale(0.0), zFixed16Offset(0.0), storageError(),
+    mappedTableValues(nullptr) {
+    setXVals(xv);
+    setYVals(yv);
+    setZVals(zv);
 }
 
 Bilinear_interp::InterpResult Bilinear_interp::interpolate(
     const std::vector<double> &xv, const std::vector<double> &yv, double x,
     double *const y) {
-    double x_l, y_l, x_u, y_u;
+    return interpolate(xv, unknownGrid, yv, x, y);
+}
+
+Bilinear_interp::InterpResult Bilinear_interp::interpolate(View xv, const UniformGrid &grid, View yv, double x,
+        double *const y, Cursor *const cursor) {
+    Bracket bracket;
+    InterpResult result = findBracket(xv, grid, x, &bracket, cursor);
+
+    *y = interpolateBracket(yv, bracket);
+
+    return result;
+}
+
+Bilinear_interp::InterpResult Bilinear_interp::findBracket(const std::vector<double> &xv, double x,
+        Bracket *const bracket) {
+    return findBracket(xv, unknownGrid, x, bracket);
+}
+
+Bilinear_interp::InterpResult Bilinear_interp::findBracket(View xv, const UniformGrid &grid, double x,
+        Bracket *const bracket, Cursor *const cursor) {
+    InterpResult result = findInterval(xv, grid, x, bracket, cursor);
+
+    if (bracket->lower != bracket->upper) {
+        // Get the X values.
+        double x_l = xv[bracket->lower];
+        double x_u = xv[bracket->upper];
+
+        bracket->weight = (x - x_l) / (x_u - x_l);
+    }
+
+    return result;
+}
+
+Bilinear_interp::InterpResult Bilinear_interp::findInterval(View xv, const UniformGrid &grid, double x,
+        Bracket *const bracket, Cursor *const cursor) {
+    bracket->weight = 0.0;
 
     // Check to make sure value is within bounds
     if (x >= xv.front()) {
         if (x <= xv.back()) {
             // Find out which indices to interpolate from.
-            std::vector<double>::const_iterator lowBound = lower_bound(xv.begin(), xv.end(),
-                    x);
-            int i_u = std::distance(xv.begin(), lowBound);
-
-            // Otherwise we would interpolate between x[-1] and x[0]
-            if (x == xv.front()) {
-                i_u++;
+            std::size_t i_u = lowerBound(xv, grid, x, cursor);
+
+            if (i_u == 0) {
+                // Exactly on the first point, otherwise we would interpolate between x[-1] and x[0]
+                bracket->lower = 0;
+                bracket->upper = 0;
+            } else {
+                bracket->lower = i_u - 1;
+                bracket->upper = i_u;
             }
 
-            // Get the X and Y values.
-            x_l = xv[i_u - 1];
-            x_u = xv[i_u];
-            y_l = yv[i_u - 1];
-            y_u = yv[i_u];
-
-            // Perform linear interpolation
-            *y = (x - x_l) / (x_u - x_l) * (y_u - y_l) + y_l;
-
             // Interpolation success.
             return InterpResult::INTERP_SUCCESS;
         } else {
-            *y = yv.back();
+            bracket->lower = xv.size() - 1;
+            bracket->upper = xv.size() - 1;
             return InterpResult::INTERP_WARN_OUT_OF_BOUNDS;
         }
     } else {
-        *y = yv.front();
+        bracket->lower = 0;
+        bracket->upper = 0;
         return InterpResult::INTERP_WARN_OUT_OF_BOUNDS;
     }
 }
 
-Bilinear_interp::InterpResult Bilinear_interp::interpolate2D(
-    const std::vector<std::vector<double>> &xv, const std::vector<double> &yv,
-    const std::vector<std::vector<double>> &zv, double x, double y,
-    double *const z) {
-    double y_l, y_u;
-    double z_l = 0.0f;
-    double z_u = 0.0f;
-    InterpResult errorState = InterpResult::INTERP_SUCCESS;
+double Bilinear_interp::interpolateBracket(View yv, const Bracket &bracket) {
+    double y_l = yv[bracket.lower];
+    double y_u = yv[bracket.upper];
 
-    double y_clamped;  // Bound using first and last points of LUT. Clamp if out of range, but throw an error.
+    // Perform linear interpolation
+    return bracket.weight * (y_u - y_l) + y_l;
+}
 
-    // Sanity check and bounding
-    if (y < yv.front()) {
-        y_clamped = yv.front();
-        errorState = InterpResult::INTERP_WARN_OUT_OF_BOUNDS;
-    } else if (y > yv.back()) {
-        y_clamped = yv.back();
-        errorState = InterpResult::INTERP_WARN_OUT_OF_BOUNDS;
-    } else {
-        y_clamped = y;
+void Bilinear_interp::computeSegments(View xv, View yv, std::vector<Segment> *const segments) {
+    for (std::size_t i = 0; i < yv.size(); i++) {
+        Segment segment = {0.0, yv[i]};
+
+        if (i + 1 < std::min(xv.size(), yv.size()) && xv[i + 1] != xv[i]) {
+            segment.slope = (yv[i + 1] - yv[i]) / (xv[i + 1] - xv[i]);
+            segment.intercept = yv[i] - segment.slope * xv[i];
+        }
+
+        segments->push_back(segment);
     }
+}
 
-    // Find out which y values are bounding our input point
-    std::vector<double>::const_iterator lowBound = lower_bound(yv.begin(), yv.end(),
-            y_clamped);
-    int iy_u = std::distance(yv.begin(), lowBound);
+double Bilinear_interp::interpolateSegment(View yv, const Segment *const segments, const Bracket &bracket,
+        double x) {
+    // Clamped, or exactly on the first point.
+    if (bracket.lower == bracket.upper) {
+        return yv[bracket.lower];
+    }
 
-    // Otherwise we would interpolate between x[-1] and x[0]
-    if (y_clamped == yv.front()) {
-        iy_u++;
+    const Segment &segment = segments[bracket.lower];
+    return segment.slope * x + segment.intercept;
+}
+
+void Bilinear_interp::computeMonotoneCubic(View xv, View yv, std::vector<CubicSegment> *const segments) {
+    std::size_t count = std::min(xv.size(), yv.size());
+
+    // Secant slope of each interval, 0 for an interval of zero width.
+    std::vector<double> secants(count > 0 ? count - 1 : 0, 0.0);
+
+    for (std::size_t i = 0; i + 1 < count; i++) {
+        if (xv[i + 1] != xv[i]) {
+            secants[i] = (yv[i + 1] - yv[i]) / (xv[i + 1] - xv[i]);
+        }
     }
 
-    if (y_clamped != yv.front() && y_clamped != yv.back()) {
-        // There are two curves to work with
+    // Slope at each breakpoint: 0 at a local extremum of the data, otherwise the slope of the parabola through it and
+    // its neighbours, and the secant at either end of the table.
+    std::vector<double> slopes(count, 0.0);
 
-        // Get the curve value pairs.
-        if (interpolate(xv[iy_u - 1], zv[iy_u - 1], x,
-                        &z_l) != InterpResult::INTERP_SUCCESS) {
-            // Error has occured in interpolation
-            errorState = InterpResult::INTERP_WARN_OUT_OF_BOUNDS;
+    if (count > 1) {
+        slopes.front() = secants.front();
+        slopes.back() = secants.back();
+    }
+
+    for (std::size_t i = 1; i + 1 < count; i++) {
+        double h_l = xv[i] - xv[i - 1];
+        double h_u = xv[i + 1] - xv[i];
+
+        if (secants[i - 1] * secants[i] > 0.0) {
+            slopes[i] = (h_u * secants[i - 1] + h_l * secants[i]) / (h_l + h_u);
         }
+    }
 
-        if (interpolate(xv[iy_u], zv[iy_u], x, &z_u) != InterpResult::INTERP_SUCCESS) {
-            // Error has occured in interpolation
-            errorState = InterpResult::INTERP_WARN_OUT_OF_BOUNDS;
+    // Limit the slopes at the ends of each interval to a circle of radius 3 secants, within which the cubic is
+    // monotone (Fritsch and Carlson, 1980).
+    for (std::size_t i = 0; i + 1 < count; i++) {
+        if (secants[i] == 0.0) {
+            slopes[i] = 0.0;
+            slopes[i + 1] = 0.0;
+            continue;
         }
 
-        // Y bounding values
-        y_l = yv[iy_u - 1];
-        y_u = yv[iy_u];
-
-        // Perform interpolation
-        *z = (y - y_l) / (y_u - y_l) * (z_u - z_l) + z_l;
-    }  else if (y_clamped == yv.front()) {
-        // Only have the first curve to work with.
-        if (interpolate(xv[iy_u - 1], zv[iy_u - 1], x,
-                        &z_l) != InterpResult::INTERP_SUCCESS) {
-            errorState = InterpResult::INTERP_WARN_OUT_OF_BOUNDS;  // Threw an error.
+        double alpha = slopes[i] / secants[i];
+        double beta = slopes[i + 1] / secants[i];
+        double radiusSquared = alpha * alpha + beta * beta;
+
+        if (radiusSquared > 9.0) {
+            double tau = 3.0 / std::sqrt(radiusSquared);
+            slopes[i] = tau * alpha * secants[i];
+            slopes[i + 1] = tau * beta * secants[i];
         }
+    }
+
+    for (std::size_t i = 0; i < yv.size(); i++) {
+        CubicSegment segment = {i < xv.size() ? xv[i] : 0.0, yv[i], 0.0, 0.0, 0.0};
+
+        if (i + 1 < count && xv[i + 1] != xv[i]) {
+            double h = xv[i + 1] - xv[i];
 
-        *z = z_l;  // No second interpolation
-    }   else  {
-        // Only have the last curve to work with.
-        if (interpolate(xv[iy_u], zv[iy_u], x, &z_l) != InterpResult::INTERP_SUCCESS) {
-            errorState = InterpResult::INTERP_WARN_OUT_OF_BOUNDS;  // Threw an error.
+            segment.c1 = slopes[i];
+            segment.c2 = (3.0 * secants[i] - 2.0 * slopes[i] - slopes[i + 1]) / h;
+            segment.c3 = (slopes[i] + slopes[i + 1] - 2.0 * secants[i]) / (h * h);
         }
 
-        *z = z_l;  // No second interpolation
+        segments->push_back(segment);
     }
+}
+
+double Bilinear_interp::interpolateCubic(const CubicSegment *const segments, const Bracket &bracket, double x) {
+    const CubicSegment &segment = segments[bracket.lower];
+
+    // Clamped, or exactly on the first point.
+    if (bracket.lower == bracket.upper) {
+        return segment.c0;
+    }
+
+    double t = x - segment.x0;
+    return ((segment.c3 * t + segment.c2) * t + segment.c1) * t + segment.c0;
+}
+
+Bilinear_interp::InterpResult Bilinear_interp::interpolateCubic(View xv, const UniformGrid &grid,
+        const CubicSegment *const segments, double x, double *const y, Cursor *const cursor) {
+    Bracket bracket;
+    InterpResult result = findInterval(xv, grid, x, &bracket, cursor);
+
+    *y = interpolateCubic(segments, bracket, x);
+
+    return result;
+}
+
+Bilinear_interp::UniformGrid Bilinear_interp::detectUniformGrid(const std::vector<double> &xv) {
+    return detectUniformGrid(View(xv));
+}
+
+Bilinear_interp::UniformGrid Bilinear_interp::detectUniformGrid(View xv) {
+    if (xv.size() < 2) {
+        return unknownGrid;
+    }
+
+    double dx = (xv.back() - xv.front()) / (xv.size() - 1);
+
+    // Also rejects NaN breakpoints.
+    if (!(dx > 0.0)) {
+        return unknownGrid;
+    }
+
+    for (std::size_t i = 0; i < xv.size(); i++) {
+        if (!(std::fabs(xv[i] - (xv.front() + i * dx)) <= UNIFORM_GRID_TOLERANCE * dx)) {
+            return unknownGrid;
+        }
+    }
+
+    UniformGrid grid = {true, xv.front(), 1.0 / dx};
+    return grid;
+}
+
+std::size_t Bilinear_interp::lowerBound(View xv, const UniformGrid &grid, double x, Cursor *const cursor) {
+    if (!grid.isUniform) {
+        if (cursor) {
+            return huntLowerBound(xv, x, cursor);
+        }
+
+        return std::distance(xv.begin(), std::lower_bound(xv.begin(), xv.end(), x));
+    }
+
+    // Interval the query falls in were the grid exactly uniform.
+    double position = (x - grid.x0) * grid.invDx;
+    std::size_t last = xv.size() - 1;
+    std::size_t i;
+
+    if (!(position > 0.0)) {
+        i = 0;
+    } else if (position >= last) {
+        i = last;
+    } else {
+        i = static_cast<std::size_t>(position);
+    }
+
+    // Breakpoints are within tolerance of the uniform grid, so at most a step is needed either way to land exactly
+    // on the first breakpoint not less than x.
+    while (i > 0 && xv[i - 1] >= x) {
+        i--;
+    }
+
+    while (i <= last && xv[i] < x) {
+        i++;
+    }
+
+    return i;
+}
+
+std::size_t Bilinear_interp::huntLowerBound(View xv, double x, Cursor *const cursor) {
+    const double *begin = xv.begin();
+    std::size_t n = xv.size();
+    std::size_t start = std::min(cursor->index, n - 1);
+    std::size_t lo, hi;  // The answer lies in (lo, hi]
+
+    // Gallop away from the previous answer with doubling steps until x is bracketed, then binary search the last
+    // step. A query in the same or an adjacent interval is found within the first step.
+    if (xv[start] >= x) {
+        hi = start;
+        lo = start;
+
+        for (std::size_t step = 1; lo > 0; step *= 2) {
+            lo = (hi > step) ? hi - step : 0;
+
+            if (xv[lo] < x) {
+                break;
+            }
+
+            hi = lo;
+        }
+
+        if (xv[lo] >= x) {
+            // Not even the first breakpoint is below x.
+            cursor->index = 0;
+            return 0;
+        }
+    } else {
+        lo = start;
+        hi = start;
+
+        for (std::size_t step = 1; hi < n; step *= 2) {
+            hi = std::min(lo + step, n);
+
+            if (hi == n || xv[hi] >= x) {
+                break;
+            }
+
+            lo = hi;
+        }
+    }
+
+    cursor->index = std::distance(begin, std::lower_bound(begin + lo + 1, begin + hi, x));
+    return cursor->index;
+}
+
+Bilinear_interp::InterpResult Bilinear_interp::interpolate2D(
+    const std::vector<std::vector<double>> &xv, const std::vector<double> &yv,
+    const std::vector<std::vector<double>> &zv, double x, double y,
+    double *const z) {
+    return interpolate2D(xv, nullptr, yv, unknownGrid, zv, x, y, z);
+}
+
+template <typename Rows, typename ZRows>
+Bilinear_interp::InterpResult Bilinear_interp::interpolate2D(const Rows &xv, const UniformGrid *const xGrids,
+        View yv, const UniformGrid &yGrid, const ZRows &zv, double x, double y, double *const z,
+        Telemetry2D *const counts) {
+    Bracket2D bracket;
+    InterpResult errorState = findBracket2D(xv, xGrids, yv, yGrid, x, y, &bracket, counts);
+
+    // Both rows are interpolated, the same row twice when there is only one, and the result then picked.
+    double z_l = interpolateRow(zv[bracket.lowerRow], bracket.lower);
+    double z_u = interpolateRow(zv[bracket.upperRow], bracket.upper);
+
+    // Perform interpolation
+    double z_2 = bracket.weight * (z_u - z_l) + z_l;
+    *z = bracket.twoRows ? z_2 : z_l;
 
     return errorState;
 }
 
+template <typename Rows>
+Bilinear_interp::InterpResult Bilinear_interp::findBracket2D(const Rows &xv, const UniformGrid *const xGrids,
+        View yv, const UniformGrid &yGrid, double x, double y, Bracket2D *const bracket,
+        Telemetry2D *const counts) {
+    // Grid of a row of x values, if known.
+    auto rowGrid = [xGrids](std::size_t row) -> const UniformGrid & {
+        return xGrids ? xGrids[row] : unknownGrid;
+    };
+
+    // Bound using first and last points of LUT. Queries below, on, within, or beyond the rows are bracketed by the
+    // same arithmetic rather than each on a path of its own: beyond the last row, searched for as on it so as to find
+    // the first of any repeats of it, and below the first, or a NaN, the search gives the first.
+    bool below = !(y >= yv.front());
+    bool above = y > yv.back();
+    std::size_t iy_u = lowerBound(yv, yGrid, std::min(y, yv.back()), nullptr);
+
+    // Find out which y values are bounding our input point. On or beyond the first or last row, the row found is used
+    // alone, as both the lower and the upper row.
+    bool twoRows = (y > yv.front()) & (y < yv.back());
+
+    bracket->lowerRow = iy_u - twoRows;
+    bracket->upperRow = iy_u;
+    bracket->twoRows = twoRows;
+
+    InterpResult lowerResult = findBracket(xv[bracket->lowerRow], rowGrid(bracket->lowerRow), x, &bracket->lower);
+    InterpResult upperResult = lowerResult;
+
+    // Branched on only to spare searching the same row twice.
+    if (twoRows) {
+        upperResult = findBracket(xv[bracket->upperRow], rowGrid(bracket->upperRow), x, &bracket->upper);
+    } else {
+        bracket->upper = bracket->lower;
+    }
+
+    // Y bounding values
+    double y_l = yv[bracket->lowerRow];
+    double y_u = yv[bracket->upperRow];
+    double weight = (y - y_l) / (y_u - y_l);
+
+    bracket->weight = twoRows ? weight : 0.0;
+
+    if (counts) {
+        // Clamped in x if clamped on either row.
+        counts->x.record(x, std::max(xv[bracket->lowerRow].front(), xv[bracket->upperRow].front()),
+                         std::min(xv[bracket->lowerRow].back(), xv[bracket->upperRow].back()));
+        counts->y.record(y, yv.front(), yv.back());
+    }
+
+    bool inBounds = !below & !above & (lowerResult == InterpResult::INTERP_SUCCESS) &
+                    (upperResult == InterpResult::INTERP_SUCCESS);
+
+    return inBounds ? InterpResult::INTERP_SUCCESS : InterpResult::INTERP_WARN_OUT_OF_BOUNDS;
+}
+
 Bilinear_interp::InterpResult Bilinear_interp::interpolate2D(double x, double y,
         double *const z) {
     if (!haveXVals || !haveYVals || !haveZVals) {
@@ -151,52 +788,473 @@ Bilinear_interp::InterpResult Bilinear_interp::interpolate2D(double x, double y,
     }
 
     // Have LUT data. Perform interpolation.
-    return interpolate2D(xVals, yVals, zVals, x, y, z);
+    if (usePrecomputedSlopes) {
+        return interpolate2DSegments(x, y, z, &telemetry);
+    }
+
+    return interpolate2DStored(x, y, z, &telemetry);
+}
+
+Bilinear_interp::InterpResult Bilinear_interp::interpolate2DStored(double x, double y, double *const z,
+        Telemetry2D *const counts) const {
+    switch (storageMode) {
+    case STORAGE_FLOAT32: {
+        Float32Rows zv = {zFloat32.data(), zRowOffsets.data()};
+        return interpolate2D(viewX(), xGrids.data(), viewY(), yGrid, zv, x, y, z, counts);
+    }
+
+    case STORAGE_FIXED16: {
+        Fixed16Rows zv = {zFixed16.data(), zRowOffsets.data(), zFixed16Scale, zFixed16Offset};
+        return interpolate2D(viewX(), xGrids.data(), viewY(), yGrid, zv, x, y, z, counts);
+    }
+
+    default:
+        return interpolate2D(viewX(), xGrids.data(), viewY(), yGrid, viewZ(), x, y, z, counts);
+    }
+}
+
+Bilinear_interp::InterpResult Bilinear_interp::interpolate2DSegments(double x, double y, double *const z,
+        Telemetry2D *const counts) const {
+    View yv = viewY();
+    TableView xv = viewX();
+
+    // Bound and bracket y as findBracket2D() does.
+    bool below = !(y >= yv.front());
+    bool above = y > yv.back();
+    std::size_t iy_u = lowerBound(yv, yGrid, std::min(y, yv.back()), nullptr);
+    bool twoRows = (y > yv.front()) & (y < yv.back());
+    std::size_t lowerRow = iy_u - twoRows;
+
+    double z_l, z_u;
+    InterpResult lowerResult = interpolateRowSegments(lowerRow, x, &z_l);
+    InterpResult upperResult = lowerResult;
+
+    if (twoRows) {
+        upperResult = interpolateRowSegments(iy_u, x, &z_u);
+
+        double weight = (y - yv[lowerRow]) * yInvSpacing[lowerRow];
+        *z = weight * (z_u - z_l) + z_l;
+    } else {
+        *z = z_l;
+    }
+
+    counts->x.record(x, std::max(xv[lowerRow].front(), xv[iy_u].front()),
+                     std::min(xv[lowerRow].back(), xv[iy_u].back()));
+    counts->y.record(y, yv.front(), yv.back());
+
+    bool inBounds = !below & !above & (lowerResult == InterpResult::INTERP_SUCCESS) &
+                    (upperResult == InterpResult::INTERP_SUCCESS);
+
+    return inBounds ? InterpResult::INTERP_SUCCESS : InterpResult::INTERP_WARN_OUT_OF_BOUNDS;
+}
+
+Bilinear_interp::InterpResult Bilinear_interp::interpolateRowSegments(std::size_t row, double x,
+        double *const z) const {
+    Bracket bracket;
+    InterpResult result = findInterval(viewX()[row], xGrids[row], x, &bracket);
+
+    *z = interpolateSegment(viewZ()[row], &rowSegments[zRowOffsets[row] - zRowOffsets[0]], bracket, x);
+
+    return result;
+}
+
+Bilinear_interp::InterpResult Bilinear_interp::interpolate2D(View x, View y, double *const z,
+        InterpResult *const results) const {
+    assert(x.size() == y.size());
+
+    if (!haveXVals || !haveYVals || !haveZVals) {
+        if (results) {
+            std::fill(results, results + x.size(), InterpResult::INTERP_ERROR_NO_LUT);
+        }
+
+        return InterpResult::INTERP_ERROR_NO_LUT;
+    }
+
+    TableView xv = viewX();
+    View yv = viewY();
+    TableView zv = viewZ();
+    InterpResult errorState = InterpResult::INTERP_SUCCESS;
+
+    // Counted locally and stored once done, so that the counts need not be written back after every point.
+    Telemetry2D counts = telemetry;
+
+    // Interpolates a single point with the scalar code.
+    auto interpolatePoint = [&](std::size_t i) {
+        InterpResult result = usePrecomputedSlopes ? interpolate2DSegments(x[i], y[i], &z[i], &counts) :
+                              storageMode != STORAGE_DOUBLE ? interpolate2DStored(x[i], y[i], &z[i], &counts) :
+                              interpolate2D(xv, xGrids.data(), yv, yGrid, zv, x[i], y[i], &z[i], &counts);
+
+        if (result != InterpResult::INTERP_SUCCESS) {
+            errorState = InterpResult::INTERP_WARN_OUT_OF_BOUNDS;
+        }
+
+        if (results) {
+            results[i] = result;
+        }
+    };
+
+    std::size_t i = 0;
+
+#if defined(BILINEAR_INTERP_AVX2)
+
+    // Four points at a time, when every search can be a direct index.
+    if (haveAvx2() && !usePrecomputedSlopes && storageMode == STORAGE_DOUBLE && yGrid.isUniform &&
+            !uniformRowGrids.empty()) {
+        static_assert(sizeof(std::size_t) == sizeof(long long), "Row offsets are gathered as 64 bit integers");
+
+        UniformBatchTable table = {
+            tableData(),
+            reinterpret_cast<const long long *>(xRowOffsets.data()),
+            reinterpret_cast<const long long *>(zRowOffsets.data()),
+            uniformRowGrids.data(),
+            yv.data(),
+            static_cast<long long>(yv.size() - 1),
+            yGrid.x0,
+            yGrid.invDx
+        };
+
+        while (x.size() - i >= 4) {
+            std::size_t count = std::min(AVX2_CHUNK_SIZE, (x.size() - i) / 4 * 4);
+            std::uint64_t needsSearch, outOfBounds;
+            ChunkBounds bounds;
+            interpolateUniformChunkAvx2(table, x.data() + i, y.data() + i, count, z + i, &needsSearch, &outOfBounds,
+                                        &bounds);
+
+            // Points left to the search are counted by it.
+            std::uint64_t counted = ~needsSearch & (~static_cast<std::uint64_t>(0) >> (64 - count));
+            countChunk(x.data() + i, count, counted, bounds.xBelow, bounds.xAbove, &counts.x);
+            countChunk(y.data() + i, count, counted, bounds.yBelow, bounds.yAbove, &counts.y);
+
+            for (std::size_t point = 0; point < count; point++, i++) {
+                std::uint64_t bit = static_cast<std::uint64_t>(1) << point;
+
+                if (needsSearch & bit) {
+                    interpolatePoint(i);
+                } else {
+                    InterpResult result = (outOfBounds & bit) ? InterpResult::INTERP_WARN_OUT_OF_BOUNDS :
+                                          InterpResult::INTERP_SUCCESS;
+
+                    if (result != InterpResult::INTERP_SUCCESS) {
+                        errorState = InterpResult::INTERP_WARN_OUT_OF_BOUNDS;
+                    }
+
+                    if (results) {
+                        results[i] = result;
+                    }
+
+                }
+            }
+        }
+    }
+
+#endif
+
+    for (; i < x.size(); i++) {
+        interpolatePoint(i);
+    }
+
+    telemetry = counts;
+
+    return errorState;
+}
+
+const char *Bilinear_interp::batchInstructionSet() {
+    return haveAvx2() ? "avx2" : "scalar";
 }
 
 bool Bilinear_interp::setXVals(const std::string &inputVals) {
-    if (!Bilinear_interp::get2DLUTelementsFromString(inputVals, &xVals)) {
+    std::vector<std::vector<double>> xv;
+
+    if (!Bilinear_interp::get2DLUTelementsFromString(inputVals, &xv)) {
         return false;  // Parsing error
     }
 
-    haveXVals = true;
+    setXVals(xv);
 
     return true;  // Success
 }
 
 void Bilinear_interp::setXVals(const std::vector<std::vector<double>> &xv) {
-    xVals = xv;
+    std::vector<double> values;
+    std::vector<std::size_t> offsets;
+    flattenRows(xv, &values, &offsets);
+
+    storeTable(TableView(values.data(), offsets.data(), xv.size()), viewZ());
     haveXVals = true;
+
+    detectXGrids(true);
+    updateSegments();
+    updateStorage();
 }
 
 bool Bilinear_interp::setYVals(const std::string &inputVals) {
-    if (!Bilinear_interp::get1DLUTelementsFromString(inputVals, &yVals)) {
+    std::vector<double> yv;
+
+    if (!Bilinear_interp::get1DLUTelementsFromString(inputVals, &yv)) {
         return false;  // Parsing error
     }
 
-    haveYVals = true;
+    setYVals(yv);
 
     return true;  // Success
 }
 
 void Bilinear_interp::setYVals(const std::vector<double> &yv) {
-    yVals = yv;
+    yVals = TableRegistry::instance().intern(yv);
     haveYVals = true;
+
+    mappedYVals = View();
+    releaseUnusedTableFile();
+
+    yGrid = detectUniformGrid(*yVals);
+    updateSegments();
+    updateStorage();
 }
 
 bool Bilinear_interp::setZVals(const std::string &inputVals) {
-    if (!Bilinear_interp::get2DLUTelementsFromString(inputVals, &zVals)) {
+    std::vector<std::vector<double>> zv;
+
+    if (!Bilinear_interp::get2DLUTelementsFromString(inputVals, &zv)) {
         return false;  // Parsing error
     }
 
-    haveZVals = true;
+    setZVals(zv);
 
     return true;  // Success
 }
 
 void Bilinear_interp::setZVals(const std::vector<std::vector<double>> &zv) {
-    zVals = zv;
+    std::vector<double> values;
+    std::vector<std::size_t> offsets;
+    flattenRows(zv, &values, &offsets);
+
+    storeTable(viewX(), TableView(values.data(), offsets.data(), zv.size()));
     haveZVals = true;
+
+    updateSegments();
+    updateStorage();
+}
+
+void Bilinear_interp::storeTable(TableView xv, TableView zv) {
+    std::vector<double> values;
+    std::vector<std::size_t> xOffsets, zOffsets;
+
+    // Copies rows one after the other onto the end of values.
+    auto appendRows = [&values](TableView rows, std::vector<std::size_t> *const offsets) {
+        offsets->push_back(values.size());
+
+        for (std::size_t i = 0; i < rows.size(); i++) {
+            values.insert(values.end(), rows[i].begin(), rows[i].end());
+            offsets->push_back(values.size());
+        }
+    };
+
+    appendRows(xv, &xOffsets);
+    appendRows(zv, &zOffsets);
+
+    tableValues = TableRegistry::instance().intern(std::move(values));
+    xRowOffsets.swap(xOffsets);
+    zRowOffsets.swap(zOffsets);
+
+    mappedTableValues = nullptr;
+    releaseUnusedTableFile();
+}
+
+void Bilinear_interp::detectXGrids(bool mayBeUniform) {
+    TableView xv = viewX();
+
+    xGrids.clear();
+    uniformRowGrids.clear();
+
+    for (std::size_t i = 0; i < xv.size(); i++) {
+        xGrids.push_back(mayBeUniform ? detectUniformGrid(xv[i]) : unknownGrid);
+    }
+
+    bool allUniform = !xv.empty();
+
+    for (const UniformGrid &grid : xGrids) {
+        allUniform = allUniform && grid.isUniform;
+    }
+
+    if (allUniform) {
+        for (std::size_t i = 0; i < xv.size(); i++) {
+            uniformRowGrids.push_back(xGrids[i].x0);
+            uniformRowGrids.push_back(xGrids[i].invDx);
+            uniformRowGrids.push_back(xv[i].back());
+        }
+    }
+}
+
+bool Bilinear_interp::setTableFile(const std::shared_ptr<const TableFile> &file) {
+    if (!file) {
+        return false;
+    }
+
+    const TableFile::Array *xArray = file->find("x");
+    const TableFile::Array *yArray = file->find("y");
+    const TableFile::Array *zArray = file->find("z");
+
+    if (xArray == nullptr || yArray == nullptr || zArray == nullptr || yArray->rowCount != 1) {
+        return false;
+    }
+
+    // x and z share the values of the file, as they share tableValues otherwise.
+    tableValues.reset();
+    xRowOffsets.assign(xArray->offsets, xArray->offsets + xArray->rowCount + 1);
+    zRowOffsets.assign(zArray->offsets, zArray->offsets + zArray->rowCount + 1);
+    mappedTableValues = file->data();
+
+    yVals.reset();
+    mappedYVals = file->rows(*yArray)[0];
+
+    tableFile = file;
+    haveXVals = true;
+    haveYVals = true;
+    haveZVals = true;
+
+    detectXGrids((xArray->flags & TableFile::ARRAY_UNIFORM_ROWS) != 0);
+    yGrid = (yArray->flags & TableFile::ARRAY_UNIFORM_ROWS) ? detectUniformGrid(mappedYVals) : unknownGrid;
+    updateSegments();
+    updateStorage();
+
+    return true;
+}
+
+void Bilinear_interp::setPrecomputedSlopes(bool enable) {
+    usePrecomputedSlopes = enable;
+    updateSegments();
+}
+
+bool Bilinear_interp::setStorage(StorageMode mode, StorageError *const error) {
+    storageMode = mode;
+    updateStorage();
+
+    if (error) {
+        *error = storageError;
+    }
+
+    return storageMode == mode;
+}
+
+Bilinear_interp::StorageMode Bilinear_interp::getStorage() const {
+    return storageMode;
+}
+
+Bilinear_interp::StorageError Bilinear_interp::getStorageError() const {
+    return storageError;
+}
+
+Bilinear_interp::Telemetry2D Bilinear_interp::getTelemetry() const {
+    return telemetry;
+}
+
+void Bilinear_interp::resetTelemetry() {
+    telemetry = Telemetry2D();
+}
+
+void Bilinear_interp::updateStorage() {
+    std::vector<float>().swap(zFloat32);
+    std::vector<std::int16_t>().swap(zFixed16);
+    zFixed16Scale = 0.0;
+    zFixed16Offset = 0.0;
+    storageError = StorageError();
+
+    if (storageMode == STORAGE_DOUBLE || zRowOffsets.empty()) {
+        return;
+    }
+
+    View zValues(tableData() + zRowOffsets.front(), zRowOffsets.back() - zRowOffsets.front());
+
+    if (storageMode == STORAGE_FLOAT32) {
+        zFloat32.assign(zValues.begin(), zValues.end());
+    } else {
+        double zMin = 0.0, zMax = 0.0;
+
+        for (std::size_t i = 0; i < zValues.size(); i++) {
+            if (!std::isfinite(zValues[i])) {
+                storageMode = STORAGE_DOUBLE;
+                return;
+            }
+
+            zMin = (i == 0) ? zValues[i] : std::min(zMin, zValues[i]);
+            zMax = (i == 0) ? zValues[i] : std::max(zMax, zValues[i]);
+        }
+
+        // Centred on the range, so that both ends are within half a step of the nearest integer in [-32767, 32767].
+        zFixed16Offset = 0.5 * zMin + 0.5 * zMax;
+        zFixed16Scale = (0.5 * zMax - 0.5 * zMin) / 32767.0;
+        zFixed16.reserve(zValues.size());
+
+        for (double value : zValues) {
+            double q = zFixed16Scale > 0.0 ? std::round((value - zFixed16Offset) / zFixed16Scale) : 0.0;
+            zFixed16.push_back(static_cast<std::int16_t>(std::max(-32767.0, std::min(32767.0, q))));
+        }
+    }
+
+    // Error of each stored value, read back as interpolate2D() reads it.
+    Float32Rows floatRows = {zFloat32.data(), zRowOffsets.data()};
+    Fixed16Rows fixedRows = {zFixed16.data(), zRowOffsets.data(), zFixed16Scale, zFixed16Offset};
+    TableView zv = viewZ();
+
+    for (std::size_t row = 0; row < zv.size(); row++) {
+        for (std::size_t i = 0; i < zv[row].size(); i++) {
+            double stored = (storageMode == STORAGE_FLOAT32) ? floatRows[row][i] : fixedRows[row][i];
+            storageError.maxValueError = std::max(storageError.maxValueError, std::fabs(stored - zv[row][i]));
+        }
+    }
+
+    if (!haveXVals || !haveYVals || !haveZVals) {
+        return;
+    }
+
+    // Interpolations at every breakpoint of every row, and midway between each row and the next.
+    TableView xv = viewX();
+    View yv = viewY();
+
+    for (std::size_t row = 0; row < std::min(xv.size(), yv.size()); row++) {
+        for (double x : xv[row]) {
+            for (double y : {yv[row], row + 1 < yv.size() ? 0.5 * yv[row] + 0.5 * yv[row + 1] : yv[row]}) {
+                double expected, stored;
+                interpolate2D(xv, xGrids.data(), yv, yGrid, viewZ(), x, y, &expected);
+                interpolate2DStored(x, y, &stored, nullptr);
+
+                storageError.maxInterpolationError = std::max(storageError.maxInterpolationError,
+                                                              std::fabs(stored - expected));
+            }
+        }
+    }
+}
+
+void Bilinear_interp::updateSegments() {
+    rowSegments.clear();
+    yInvSpacing.clear();
+
+    if (!usePrecomputedSlopes) {
+        return;
+    }
+
+    TableView xv = viewX();
+    TableView zv = viewZ();
+
+    for (std::size_t i = 0; i < std::min(xv.size(), zv.size()); i++) {
+        computeSegments(xv[i], zv[i], &rowSegments);
+    }
+
+    View yv = viewY();
+
+    for (std::size_t i = 0; i + 1 < yv.size(); i++) {
+        yInvSpacing.push_back(1.0 / (yv[i + 1] - yv[i]));
+    }
+}
+
+const double *Bilinear_interp::tableData() const {
+    return mappedTableValues ? mappedTableValues : tableValues ? tableValues->data() : nullptr;
+}
+
+void Bilinear_interp::releaseUnusedTableFile() {
+    if (mappedTableValues == nullptr && mappedYVals.data() == nullptr) {
+        tableFile.reset();
+    }
 }
 
 bool Bilinear_interp::getX(std::vector<std::vector<double>> *const xVect) {
@@ -205,7 +1263,13 @@ bool Bilinear_interp::getX(std::vector<std::vector<double>> *const xVect) {
         return false;
     }
 
-    *xVect = xVals;
+    TableView xv = viewX();
+    xVect->clear();
+
+    for (std::size_t i = 0; i < xv.size(); i++) {
+        xVect->push_back(std::vector<double>(xv[i].begin(), xv[i].end()));
+    }
+
     return true;
 }
 
@@ -215,7 +1279,8 @@ bool Bilinear_interp::getY(std::vector<double> *const yVect) {
         return false;
     }
 
-    *yVect = yVals;
+    View yv = viewY();
+    yVect->assign(yv.begin(), yv.end());
     return true;
 }
 
@@ -225,95 +1290,84 @@ bool Bilinear_interp::getZ(std::vector<std::vector<double>> *const zVect) {
         return false;
     }
 
-    *zVect = zVals;
+    TableView zv = viewZ();
+    zVect->clear();
+
+    for (std::size_t i = 0; i < zv.size(); i++) {
+        zVect->push_back(std::vector<double>(zv[i].begin(), zv[i].end()));
+    }
+
     return true;
 }
 
-bool Bilinear_interp::get1DLUTelementsFromString(const std::string &inputVals,
-        std::vector<double> *const outputVect) {
-    // Return failure if null string.
-    if (inputVals.empty()) {
-        return false;
+Bilinear_interp::TableView Bilinear_interp::viewX() const {
+    if (xRowOffsets.empty()) {
+        return TableView();
     }
 
-    // Explicit copy operation.
-    std::string inputString = inputVals;
+    return TableView(tableData(), xRowOffsets.data(), xRowOffsets.size() - 1);
+}
 
-    std::string delimiter = ",";
-    size_t pos = 0;
-    std::string token;
+Bilinear_interp::View Bilinear_interp::viewY() const {
+    return mappedYVals.data() ? mappedYVals : yVals ? View(*yVals) : View();
+}
 
-    std::vector<double> row;
+Bilinear_interp::TableView Bilinear_interp::viewZ() const {
+    if (zRowOffsets.empty()) {
+        return TableView();
+    }
 
-    double tmpDouble;
+    return TableView(tableData(), zRowOffsets.data(), zRowOffsets.size() - 1);
+}
 
-    while ((pos = inputString.find(delimiter)) != std::string::npos) {
-        token = inputString.substr(0, pos);
+bool Bilinear_interp::get1DLUTelementsFromString(const std::string &inputVals,
+        std::vector<double> *const outputVect, ParseError *const error) {
+    std::vector<double> row;
+    std::size_t column;
 
-        if (sscanf(token.c_str(), "%lf", &tmpDouble) != 1) {
-            return false;  // Return fault if sscanf fails
+    // An empty string fails on its first value.
+    if (!parseLUTRow(inputVals.c_str(), inputVals.c_str() + inputVals.size(), &row, &column)) {
+        if (error != nullptr) {
+            error->row = 0;
+            error->column = column;
         }
 
-        row.push_back(tmpDouble);
-        inputString.erase(0, pos + delimiter.length());
-    }
-
-    // Push in last value;
-    if (sscanf(inputString.c_str(), "%lf", &tmpDouble) != 1) {
-        return false;  // Return fault if sscanf fails
+        return false;
     }
 
-    row.push_back(tmpDouble);
-
-    // Copy to output vector
-    *outputVect = row;
+    outputVect->swap(row);
 
     return true;
 }
 
 bool Bilinear_interp::get2DLUTelementsFromString(const std::string &inputVals,
-        std::vector<std::vector<double>> *const outputVect) {
-    // Return failure if null string.
-    if (inputVals.empty()) {
-        return false;
-    }
-
-    std::stringstream ss(inputVals);
-    std::string to;
-
-    std::string delimiter = ",";
-    size_t pos = 0;
-    std::string token;
+        std::vector<std::vector<double>> *const outputVect, ParseError *const error) {
+    const char *begin = inputVals.c_str();
+    const char *const end = begin + inputVals.size();
 
     std::vector<std::vector<double>> vect_vals;
-    std::vector<double> row;
+    vect_vals.reserve(std::count(begin, end, ';') + 1);
 
-    double tmpDouble;
+    // An empty string fails on its first value, whereas a semicolon at the very end does not start another row.
+    do {
+        const char *const rowEnd = std::find(begin, end, ';');
+        std::size_t column;
 
-    while (std::getline(ss, to, ';')) {
-        while ((pos = to.find(delimiter)) != std::string::npos) {
-            token = to.substr(0, pos);
+        vect_vals.push_back(std::vector<double>());
 
-            if (sscanf(token.c_str(), "%lf", &tmpDouble) != 1) {
-                return false;  // Return fault if sscanf fails
+        if (!parseLUTRow(begin, rowEnd, &vect_vals.back(), &column)) {
+            if (error != nullptr) {
+                error->row = vect_vals.size() - 1;
+                error->column = column;
             }
 
-            row.push_back(tmpDouble);
-            to.erase(0, pos + delimiter.length());
+            return false;
         }
 
-        // Push in last value;
-        if (sscanf(to.c_str(), "%lf", &tmpDouble) != 1) {
-            return false;  // Return fault if sscanf fails
-        }
-
-        row.push_back(tmpDouble);
-        vect_vals.push_back(row);
-        row.clear();
-    }
+        begin = rowEnd + 1;
+    } while (begin < end);
 
-    // Copy to output vector
-    *outputVect = vect_vals;
+    outputVect->swap(vect_vals);
 
     return true;
 }
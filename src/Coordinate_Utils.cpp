@@ -12,6 +12,18 @@
 namespace avionics_sim {
 int Coordinate_Utils::project_vector_global(ignition::math::Pose3d targetFrame, ignition::math::Vector3d vec,
         ignition::math::Vector3d *const res) {
+    ignition::math::Matrix3d rotation;
+
+    project_rotation_global(targetFrame, &rotation);
+
+    // Project source vector into target frame.
+    *res = rotation * vec;
+
+    return 0;
+}
+
+int Coordinate_Utils::project_rotation_global(ignition::math::Pose3d targetFrame,
+        ignition::math::Matrix3d *const res) {
     // Unit direction vectors in target (world) frame.
 
     // Forward is positive on x-axis in world frame.
@@ -27,10 +39,10 @@ int Coordinate_Utils::project_vector_global(ignition::math::Pose3d targetFrame,
     // Cross product to get right direction vector.
     ignition::math::Vector3d rightI = upwardI.Cross(forwardI).Normalize();
 
-    // Project source vector into target frame.
-    *res = ignition::math::Vector3d(forwardI.Dot(vec),
-                                    rightI.Dot(vec),
-                                    upwardI.Dot(vec));
+    *res = ignition::math::Matrix3d(
+               forwardI.X(), forwardI.Y(), forwardI.Z(),
+               rightI.X(), rightI.Y(), rightI.Z(),
+               upwardI.X(), upwardI.Y(), upwardI.Z());
 
     return 0;
 }
@@ -8,6 +8,8 @@
 
 #include "LookupTable.hpp"
 #include <assert.h>
+#include <stdexcept>
+#include <utility>
 
 namespace avionics_sim {
 
@@ -18,18 +20,142 @@ LookupTable::LookupTable::LookupTable(
     // Number of column names must match the number of columns
     assert(colNames.size() == cols.size());
 
-    // Populate LUT Map
-    for (int i = 0; i < colNames.size(); i++) {
-        lutMap.insert(std::make_pair(colNames[i], cols.at(i)));
+    // Populate LUT Map. Should a name repeat, the first column registered under it is kept.
+    for (std::size_t i = 0; i < colNames.size(); i++) {
+        columns.push_back(TableRegistry::instance().intern(std::move(cols.at(i))));
+        columnIndices.insert(std::make_pair(colNames[i], i));
+        grids.push_back(avionics_sim::Bilinear_interp::detectUniformGrid(*columns.back()));
     }
+
+    telemetry.resize(columns.size());
+}
+
+LookupTable::LookupTable(const std::shared_ptr<const TableFile> &file) : tableFile(file) {
+    if (!file) {
+        throw std::invalid_argument("No table file to construct LookupTable from");
+    }
+
+    for (const TableFile::Array &array : file->arrays()) {
+        if (array.rowCount != 1) {
+            throw std::invalid_argument("Table file array " + array.name + " is not a single column");
+        }
+
+        columnIndices.insert(std::make_pair(array.name, mappedColumns.size()));
+        mappedColumns.push_back(file->rows(array)[0]);
+
+        // Only evenly spaced columns can be used through a grid, so the others need not be checked.
+        grids.push_back((array.flags & TableFile::ARRAY_UNIFORM_ROWS) ?
+                        avionics_sim::Bilinear_interp::detectUniformGrid(mappedColumns.back()) :
+                        avionics_sim::Bilinear_interp::UniformGrid{false, 0.0, 0.0});
+    }
+
+    telemetry.resize(mappedColumns.size());
+}
+
+LookupTable::ColumnHandle LookupTable::resolveColumn(const std::string &colName) const {
+    ColumnHandle handle = {columnIndices.at(colName)};
+    return handle;
+}
+
+double LookupTable::lookup(double valA, const std::string &fromA, const std::string &inB) const {
+    return lookup(valA, resolveColumn(fromA), resolveColumn(inB));
 }
 
-double LookupTable::lookup(double valA, std::string fromA, std::string inB) {
+double LookupTable::lookup(double valA, ColumnHandle fromA, ColumnHandle inB,
+                           Bilinear_interp::Cursor *const cursor) const {
+    telemetry[fromA.index].record(valA, column(fromA.index).front(), column(fromA.index).back());
+
+    if (fromA.index < cubicSegments.size() && !cubicSegments[fromA.index].empty()) {
+        double valB;
+        avionics_sim::Bilinear_interp::interpolateCubic(column(fromA.index), grids[fromA.index],
+                cubicSegments[fromA.index][inB.index].data(), valA, &valB, cursor);
+
+        return valB;
+    }
+
+    if (fromA.index < segments.size() && !segments[fromA.index].empty()) {
+        avionics_sim::Bilinear_interp::Bracket bracket;
+        avionics_sim::Bilinear_interp::findInterval(column(fromA.index), grids[fromA.index], valA, &bracket, cursor);
+
+        return avionics_sim::Bilinear_interp::interpolateSegment(column(inB.index),
+                segments[fromA.index][inB.index].data(), bracket, valA);
+    }
+
     double valB;
-    avionics_sim::Bilinear_interp::interpolate(lutMap.at(fromA), lutMap.at(inB),
-            valA, &valB);
+    avionics_sim::Bilinear_interp::interpolate(column(fromA.index), grids[fromA.index], column(inB.index),
+            valA, &valB, cursor);
 
     return valB;
 }
 
+void LookupTable::lookup(double valA, ColumnHandle fromA, const ColumnHandle *const inB, std::size_t count,
+                         double *const valB, Bilinear_interp::Cursor *const cursor) const {
+    avionics_sim::Bilinear_interp::Bracket bracket;
+
+    telemetry[fromA.index].record(valA, column(fromA.index).front(), column(fromA.index).back());
+
+    if (fromA.index < cubicSegments.size() && !cubicSegments[fromA.index].empty()) {
+        avionics_sim::Bilinear_interp::findInterval(column(fromA.index), grids[fromA.index], valA, &bracket, cursor);
+
+        for (std::size_t i = 0; i < count; i++) {
+            valB[i] = avionics_sim::Bilinear_interp::interpolateCubic(cubicSegments[fromA.index][inB[i].index].data(),
+                      bracket, valA);
+        }
+
+        return;
+    }
+
+    if (fromA.index < segments.size() && !segments[fromA.index].empty()) {
+        avionics_sim::Bilinear_interp::findInterval(column(fromA.index), grids[fromA.index], valA, &bracket, cursor);
+
+        for (std::size_t i = 0; i < count; i++) {
+            valB[i] = avionics_sim::Bilinear_interp::interpolateSegment(column(inB[i].index),
+                      segments[fromA.index][inB[i].index].data(), bracket, valA);
+        }
+
+        return;
+    }
+
+    avionics_sim::Bilinear_interp::findBracket(column(fromA.index), grids[fromA.index], valA, &bracket, cursor);
+
+    for (std::size_t i = 0; i < count; i++) {
+        valB[i] = avionics_sim::Bilinear_interp::interpolateBracket(column(inB[i].index), bracket);
+    }
+}
+
+void LookupTable::precomputeSlopes(ColumnHandle fromA) {
+    segments.resize(columnCount());
+    segments[fromA.index].assign(columnCount(), std::vector<avionics_sim::Bilinear_interp::Segment>());
+
+    for (std::size_t i = 0; i < columnCount(); i++) {
+        avionics_sim::Bilinear_interp::computeSegments(column(fromA.index), column(i), &segments[fromA.index][i]);
+    }
+
+    if (fromA.index < cubicSegments.size()) {
+        cubicSegments[fromA.index].clear();
+    }
+}
+
+void LookupTable::precomputeMonotoneCubic(ColumnHandle fromA) {
+    cubicSegments.resize(columnCount());
+    cubicSegments[fromA.index].assign(columnCount(), std::vector<avionics_sim::Bilinear_interp::CubicSegment>());
+
+    for (std::size_t i = 0; i < columnCount(); i++) {
+        avionics_sim::Bilinear_interp::computeMonotoneCubic(column(fromA.index), column(i),
+                &cubicSegments[fromA.index][i]);
+    }
+
+    if (fromA.index < segments.size()) {
+        segments[fromA.index].clear();
+    }
+}
+
+const Bilinear_interp::Telemetry &LookupTable::getTelemetry(ColumnHandle fromA) const {
+    return telemetry[fromA.index];
+}
+
+void LookupTable::resetTelemetry() {
+    telemetry.assign(columnCount(), Bilinear_interp::Telemetry());
+}
+
 }  // namespace avionics_sim
@@ -0,0 +1,321 @@
+/**
+ * @brief       TableFile class. Read-only, memory mapped binary file of LUT values.
+ * @file        TableFile.cpp
+ * @copyright   Copyright (c) 2021, Swift Engineering Inc.
+ * @license     Licensed under the MIT license. See LICENSE for details.
+ */
+
+#include "TableFile.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace avionics_sim {
+
+static_assert(sizeof(std::size_t) == sizeof(std::uint64_t), "Row offsets are used in place as 64 bit integers");
+
+static const char MAGIC[8] = {'A', 'V', 'S', 'I', 'M', 'L', 'U', 'T'};
+static const std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+static const std::uint64_t VALUES_ALIGNMENT = 64;
+
+// Header at the start of every file.
+struct FileHeader {
+    char magic[8];
+    std::uint32_t byteOrder;
+    std::uint32_t version;
+    std::uint64_t fileSize;
+    std::uint64_t checksum;      // FNV-1a of the bytes from the end of the header to the end of the file
+    std::uint32_t arrayCount;
+    std::uint32_t reserved;
+    std::uint64_t valuesOffset;  // Multiple of VALUES_ALIGNMENT
+    std::uint64_t valueCount;
+    std::uint64_t reserved2;
+};
+
+// Entry describing each array, following the header.
+struct FileArrayEntry {
+    char name[TableFile::MAX_NAME_LENGTH + 1];
+    std::uint32_t flags;
+    std::uint32_t rowCount;
+    std::uint64_t offsetsOffset;  // Byte offset of the rowCount + 1 row starts of the array
+    std::uint64_t reserved;
+};
+
+static_assert(sizeof(FileHeader) == 64, "The header is 64 bytes");
+static_assert(sizeof(FileArrayEntry) == 64, "Each array entry is 64 bytes");
+
+static std::uint64_t fnv1a(const unsigned char *bytes, std::size_t size) {
+    std::uint64_t hash = 14695981039346656037ULL;
+
+    for (std::size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+// Sets error, if there is one to set, and returns false.
+static bool fail(std::string *const error, const std::string &message) {
+    if (error != nullptr) {
+        *error = message;
+    }
+
+    return false;
+}
+
+TableFile::TableFile() : mapping(nullptr), mappingSize(0), values(nullptr) {}
+
+TableFile::~TableFile() {
+    if (mapping != nullptr) {
+        munmap(mapping, mappingSize);
+    }
+}
+
+std::shared_ptr<const TableFile> TableFile::open(const std::string &path, std::string *const error) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+
+    if (fd < 0) {
+        fail(error, "Cannot open " + path + ": " + std::strerror(errno));
+        return nullptr;
+    }
+
+    struct stat status;
+
+    if (fstat(fd, &status) != 0 || status.st_size < static_cast<off_t>(sizeof(FileHeader))) {
+        close(fd);
+        fail(error, path + " is too short to be a table file");
+        return nullptr;
+    }
+
+    std::shared_ptr<TableFile> file(new TableFile());
+    file->mappingSize = static_cast<std::size_t>(status.st_size);
+    void *mapping = mmap(nullptr, file->mappingSize, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (mapping == MAP_FAILED) {
+        fail(error, "Cannot map " + path + ": " + std::strerror(errno));
+        return nullptr;
+    }
+
+    file->mapping = mapping;
+
+    const unsigned char *bytes = static_cast<const unsigned char *>(mapping);
+    const std::uint64_t size = file->mappingSize;
+    const FileHeader &header = *reinterpret_cast<const FileHeader *>(bytes);
+
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        fail(error, path + " is not a table file");
+        return nullptr;
+    }
+
+    if (header.byteOrder != BYTE_ORDER_MARK) {
+        fail(error, path + " was written with a different byte order");
+        return nullptr;
+    }
+
+    if (header.version != VERSION) {
+        fail(error, path + " is version " + std::to_string(header.version) + ", not " + std::to_string(VERSION));
+        return nullptr;
+    }
+
+    if (header.fileSize != size) {
+        fail(error, path + " is truncated");
+        return nullptr;
+    }
+
+    if (header.checksum != fnv1a(bytes + sizeof(FileHeader), size - sizeof(FileHeader))) {
+        fail(error, path + " is corrupt: checksum mismatch");
+        return nullptr;
+    }
+
+    // The checksum only shows the file is as written; the layout is checked as well so no lookup can read past it.
+    std::uint64_t directoryEnd = sizeof(FileHeader) + std::uint64_t(header.arrayCount) * sizeof(FileArrayEntry);
+
+    if (directoryEnd > size || header.valuesOffset % VALUES_ALIGNMENT != 0 || header.valuesOffset > size ||
+            header.valueCount > (size - header.valuesOffset) / sizeof(double)) {
+        fail(error, path + " is corrupt: bad layout");
+        return nullptr;
+    }
+
+    file->values = reinterpret_cast<const double *>(bytes + header.valuesOffset);
+    const FileArrayEntry *entries = reinterpret_cast<const FileArrayEntry *>(bytes + sizeof(FileHeader));
+
+    for (std::uint32_t i = 0; i < header.arrayCount; i++) {
+        const FileArrayEntry &entry = entries[i];
+        std::uint64_t offsetsSize = (std::uint64_t(entry.rowCount) + 1) * sizeof(std::uint64_t);
+
+        if (std::memchr(entry.name, '\0', sizeof(entry.name)) == nullptr || entry.offsetsOffset % 8 != 0 ||
+                entry.offsetsOffset > size || offsetsSize > size - entry.offsetsOffset) {
+            fail(error, path + " is corrupt: bad entry for array " + std::to_string(i));
+            return nullptr;
+        }
+
+        Array array;
+        array.name = entry.name;
+        array.flags = entry.flags;
+        array.rowCount = entry.rowCount;
+        array.offsets = reinterpret_cast<const std::size_t *>(bytes + entry.offsetsOffset);
+
+        for (std::size_t row = 0; row < array.rowCount; row++) {
+            if (array.offsets[row] > array.offsets[row + 1] || array.offsets[row + 1] > header.valueCount) {
+                fail(error, path + " is corrupt: bad rows for array " + array.name);
+                return nullptr;
+            }
+        }
+
+        file->arrayList.push_back(array);
+    }
+
+    return file;
+}
+
+bool TableFile::write(const std::string &path, const std::vector<ArrayData> &arrays, std::string *const error) {
+    FileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.version = VERSION;
+    header.arrayCount = static_cast<std::uint32_t>(arrays.size());
+
+    // Lay out the directory and row starts, then the values on the next aligned boundary.
+    std::vector<FileArrayEntry> entries(arrays.size());
+    std::vector<std::uint64_t> offsets;
+    std::uint64_t valueCount = 0;
+
+    for (std::size_t i = 0; i < arrays.size(); i++) {
+        const std::string &name = arrays[i].first;
+        const std::vector<std::vector<double>> &rows = arrays[i].second;
+
+        if (name.empty() || name.size() > MAX_NAME_LENGTH) {
+            return fail(error, "Array name \"" + name + "\" must be 1 to " + std::to_string(MAX_NAME_LENGTH) +
+                        " characters long");
+        }
+
+        FileArrayEntry &entry = entries[i];
+        std::memset(&entry, 0, sizeof(entry));
+        std::memcpy(entry.name, name.c_str(), name.size());
+        entry.rowCount = static_cast<std::uint32_t>(rows.size());
+        entry.offsetsOffset = sizeof(FileHeader) + arrays.size() * sizeof(FileArrayEntry) +
+                              offsets.size() * sizeof(std::uint64_t);
+
+        bool allUniform = !rows.empty();
+        offsets.push_back(valueCount);
+
+        for (const std::vector<double> &row : rows) {
+            allUniform = allUniform && Bilinear_interp::detectUniformGrid(row).isUniform;
+            valueCount += row.size();
+            offsets.push_back(valueCount);
+        }
+
+        entry.flags = allUniform ? static_cast<std::uint32_t>(ARRAY_UNIFORM_ROWS) : 0u;
+    }
+
+    std::uint64_t offsetsEnd = sizeof(FileHeader) + arrays.size() * sizeof(FileArrayEntry) +
+                               offsets.size() * sizeof(std::uint64_t);
+    header.valuesOffset = (offsetsEnd + VALUES_ALIGNMENT - 1) / VALUES_ALIGNMENT * VALUES_ALIGNMENT;
+    header.valueCount = valueCount;
+    header.fileSize = header.valuesOffset + valueCount * sizeof(double);
+
+    std::vector<unsigned char> bytes(header.fileSize, 0);
+    std::memcpy(bytes.data() + sizeof(FileHeader), entries.data(), entries.size() * sizeof(FileArrayEntry));
+    std::memcpy(bytes.data() + sizeof(FileHeader) + entries.size() * sizeof(FileArrayEntry), offsets.data(),
+                offsets.size() * sizeof(std::uint64_t));
+
+    unsigned char *values = bytes.data() + header.valuesOffset;
+
+    for (const ArrayData &array : arrays) {
+        for (const std::vector<double> &row : array.second) {
+            std::memcpy(values, row.data(), row.size() * sizeof(double));
+            values += row.size() * sizeof(double);
+        }
+    }
+
+    header.checksum = fnv1a(bytes.data() + sizeof(FileHeader), bytes.size() - sizeof(FileHeader));
+    std::memcpy(bytes.data(), &header, sizeof(FileHeader));
+
+    // Replace any existing file in one step, as other processes may have it mapped. The temporary file is unique to
+    // this write, in the same directory so that the rename stays within one file system, as others may be writing
+    // the same table at once.
+    std::vector<char> temporaryName(path.begin(), path.end());
+    const char suffix[] = ".XXXXXX";
+    temporaryName.insert(temporaryName.end(), suffix, suffix + sizeof(suffix));
+
+    int fd = mkstemp(temporaryName.data());
+
+    if (fd < 0) {
+        return fail(error, "Cannot create a temporary file for " + path + ": " + std::strerror(errno));
+    }
+
+    std::string temporaryPath(temporaryName.data());
+    const unsigned char *remaining = bytes.data();
+    std::size_t remainingSize = bytes.size();
+    bool written = fchmod(fd, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH) == 0;
+
+    while (written && remainingSize > 0) {
+        ssize_t count = ::write(fd, remaining, remainingSize);
+
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+
+        written = count > 0;
+
+        if (written) {
+            remaining += count;
+            remainingSize -= static_cast<std::size_t>(count);
+        }
+    }
+
+    if (::close(fd) != 0) {
+        written = false;
+    }
+
+    if (!written) {
+        std::remove(temporaryPath.c_str());
+        return fail(error, "Cannot write " + temporaryPath);
+    }
+
+    if (std::rename(temporaryPath.c_str(), path.c_str()) != 0) {
+        std::remove(temporaryPath.c_str());
+        return fail(error, "Cannot rename " + temporaryPath + " to " + path + ": " + std::strerror(errno));
+    }
+
+    return true;
+}
+
+bool TableFile::writeFromStrings(const std::string &path,
+                                 const std::vector<std::pair<std::string, std::string>> &lutStrings,
+                                 std::string *const error) {
+    std::vector<ArrayData> arrays;
+
+    for (const std::pair<std::string, std::string> &lutString : lutStrings) {
+        Bilinear_interp::ParseError parseError;
+        arrays.push_back(ArrayData(lutString.first, std::vector<std::vector<double>>()));
+
+        if (!Bilinear_interp::get2DLUTelementsFromString(lutString.second, &arrays.back().second, &parseError)) {
+            return fail(error, "Cannot parse " + lutString.first + ": bad value at row " +
+                        std::to_string(parseError.row) + ", column " + std::to_string(parseError.column));
+        }
+    }
+
+    return write(path, arrays, error);
+}
+
+const TableFile::Array *TableFile::find(const std::string &name) const {
+    for (const Array &array : arrayList) {
+        if (array.name == name) {
+            return &array;
+        }
+    }
+
+    return nullptr;
+}
+
+}  // namespace avionics_sim
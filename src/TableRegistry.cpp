@@ -0,0 +1,109 @@
+/**
+ * @brief       TableRegistry class. Process-wide store of immutable LUT values shared between tables.
+ * @file        TableRegistry.cpp
+ * @copyright   Copyright (c) 2021, Swift Engineering Inc.
+ * @license     Licensed under the MIT license. See LICENSE for details.
+ */
+
+#include "TableRegistry.hpp"
+
+#include <cstring>
+#include <utility>
+
+namespace avionics_sim {
+
+TableRegistry &TableRegistry::instance() {
+    static TableRegistry *registry = new TableRegistry();
+    return *registry;
+}
+
+TableRegistry::Table TableRegistry::intern(std::vector<double> values) {
+    std::uint64_t hash = contentHash(values);
+
+    // References taken while looking, released after the lock in case one is the last and releases its values.
+    std::vector<Table> candidates;
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto range = entries.equal_range(hash);
+
+    for (auto it = range.first; it != range.second; ++it) {
+        candidates.push_back(it->second.table.lock());
+        const Table &table = candidates.back();
+
+        // Compared by their bytes, so that 0.0 and -0.0, or NaNs of different payloads, are not merged.
+        if (table && table->size() == values.size() &&
+                std::memcmp(table->data(), values.data(), values.size() * sizeof(double)) == 0) {
+            return table;
+        }
+    }
+
+    const std::vector<double> *held = new std::vector<double>(std::move(values));
+    Table table(held, [this, hash](const std::vector<double> *released) {
+        release(hash, released);
+    });
+
+    Entry entry = {held, table};
+    entries.insert(std::make_pair(hash, entry));
+
+    return table;
+}
+
+void TableRegistry::release(std::uint64_t hash, const std::vector<double> *values) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        auto range = entries.equal_range(hash);
+
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second.values == values) {
+                entries.erase(it);
+                break;
+            }
+        }
+    }
+
+    delete values;
+}
+
+TableRegistry::Usage TableRegistry::usage() const {
+    Usage usage = {0, 0, 0, 0};
+
+    // References taken while measuring, released after the lock as in intern().
+    std::vector<Table> tables;
+    std::lock_guard<std::mutex> lock(mutex);
+
+    tables.reserve(entries.size());
+
+    for (const auto &entry : entries) {
+        tables.push_back(entry.second.table.lock());
+        const Table &table = tables.back();
+
+        if (!table) {
+            continue;
+        }
+
+        // Less the reference just taken.
+        std::size_t references = static_cast<std::size_t>(table.use_count()) - 1;
+        std::size_t bytes = table->size() * sizeof(double);
+
+        usage.tableCount++;
+        usage.tableBytes += bytes;
+        usage.referenceCount += references;
+        usage.unsharedBytes += references * bytes;
+    }
+
+    return usage;
+}
+
+std::uint64_t TableRegistry::contentHash(const std::vector<double> &values) {
+    const unsigned char *bytes = reinterpret_cast<const unsigned char *>(values.data());
+    std::uint64_t hash = 14695981039346656037ULL;
+
+    for (std::size_t i = 0; i < values.size() * sizeof(double); i++) {
+        hash = (hash ^ bytes[i]) * 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+}  // namespace avionics_sim
@@ -97,4 +97,39 @@ double US_1976_atmosphere::get_mass_density_kg_per_m3(const double geopot_height
     return rho;
 }
 
+double US_1976_atmosphere::get_speed_of_sound_m_per_s(const double geopot_height) {
+    const double Tm = get_temperature_K(geopot_height);
+
+    return sqrt(gamma * Tm / MR);
+}
+
+EnvironmentSnapshot US_1976_atmosphere::get_snapshot(const double geopot_height) {
+    const double geopot_height_km = geopot_height / 1000.0;
+    const ATMOSPHERE_LAYER layer = get_layer(geopot_height_km);
+    const size_t layer_i = static_cast<size_t>(layer);
+
+    const double Lmb = lapse_rate[layer_i];
+    const double Tmb = base_temp[layer_i];
+    const double Pb = base_pressure[layer_i];
+    const double Hb = base_geopot_height_km[layer_i];
+
+    // The temperature is also the base of the power of the pressure.
+    const double Tm = Tmb + Lmb * (geopot_height_km - Hb);
+
+    double P = 0.0;
+
+    if (Lmb == 0.0) {
+        P = Pb * exp(-GMR * (geopot_height_km - Hb) / Tmb);
+    } else {
+        P = Pb * pow(Tmb / Tm, GMR / Lmb);
+    }
+
+    EnvironmentSnapshot snapshot;
+    snapshot.airDensity_kg_per_m3 = P * MR / Tm;
+    snapshot.staticPressure_Pa = P;
+    snapshot.temperature_K = Tm;
+    snapshot.speedOfSound_m_per_s = sqrt(gamma * Tm / MR);
+    return snapshot;
+}
+
 }  // namespace avionics_sim
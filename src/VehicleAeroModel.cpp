@@ -0,0 +1,204 @@
+/**
+ * @brief       VehicleAeroModel
+ * @file        VehicleAeroModel.cpp
+ * @copyright   Copyright (c) 2021, Swift Engineering Inc.
+ * @license     Licensed under the MIT license. See LICENSE for details.
+ */
+
+#include "VehicleAeroModel.hpp"
+#include "Coordinate_Utils.hpp"
+
+namespace avionics_sim {
+
+VehicleAeroModel::VehicleAeroModel(IPhysicsEnvironment &environment) :
+    _environment(&environment),
+    _velocitiesInWorld_m_per_s(nullptr),
+    _propWashes_m_per_s(nullptr),
+    _controlAngles_rad(nullptr),
+    _generation(0),
+    _pendingRuns(0),
+    _stopping(false) {
+}
+
+VehicleAeroModel::~VehicleAeroModel() {
+    stopWorkers();
+}
+
+std::size_t VehicleAeroModel::addSurface(Airfoil airfoil, ignition::math::Vector3d forward,
+        ignition::math::Vector3d upward, ignition::math::Vector3d centerOfPressureInBody_m) {
+    Surface surface(airfoil, *_environment);
+    surface.setBasisVectors(forward, upward);
+    surface.setCenterOfPressure(centerOfPressureInBody_m);
+    surface.setStateCapture(Surface::STATE_CAPTURE_NONE);
+
+    _surfaces.push_back(surface);
+    _surfaceWrenches.push_back(AeroWrench());
+
+    return _surfaces.size() - 1;
+}
+
+std::size_t VehicleAeroModel::size() const {
+    return _surfaces.size();
+}
+
+VehicleAeroModel::Surface &VehicleAeroModel::getSurface(std::size_t surface) {
+    return _surfaces[surface];
+}
+
+const AeroWrench &VehicleAeroModel::getSurfaceWrench(std::size_t surface) const {
+    return _surfaceWrenches[surface];
+}
+
+void VehicleAeroModel::setThreadCount(std::size_t threadCount) {
+    stopWorkers();
+
+    for (std::size_t run = 1; run < threadCount; run++) {
+        _workers.push_back(std::thread(&VehicleAeroModel::runWorker, this, run, _generation));
+    }
+}
+
+std::size_t VehicleAeroModel::getThreadCount() const {
+    return _workers.size() + 1;
+}
+
+AeroWrench VehicleAeroModel::updateWrenchInBody(
+    const ignition::math::Pose3d &poseInWorld_m_rad,
+    const ignition::math::Vector3d *velocitiesInWorld_m_per_s,
+    const double *propWashes_m_per_s,
+    const double *controlAngles_rad) {
+    return updateWrenchInBody(_environment->get_snapshot(), poseInWorld_m_rad, velocitiesInWorld_m_per_s,
+                              propWashes_m_per_s, controlAngles_rad);
+}
+
+AeroWrench VehicleAeroModel::updateWrenchInBody(
+    const EnvironmentSnapshot &environment,
+    const ignition::math::Pose3d &poseInWorld_m_rad,
+    const ignition::math::Vector3d *velocitiesInWorld_m_per_s,
+    const double *propWashes_m_per_s,
+    const double *controlAngles_rad) {
+    _snapshot = environment;
+    Coordinate_Utils::project_rotation_global(poseInWorld_m_rad, &_worldToBody);
+    _velocitiesInWorld_m_per_s = velocitiesInWorld_m_per_s;
+    _propWashes_m_per_s = propWashes_m_per_s;
+    _controlAngles_rad = controlAngles_rad;
+
+    if (_workers.empty()) {
+        updateRun(0);
+    } else {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _pendingRuns = _workers.size();
+            _generation++;
+        }
+
+        _updateStarted.notify_all();
+
+        // The other threads read the arrays of the caller until they finish, so they are waited for before any
+        // exception leaves here.
+        std::exception_ptr exception;
+
+        try {
+            updateRun(0);
+        } catch (...) {
+            exception = std::current_exception();
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _runsFinished.wait(lock, [this] {
+                return _pendingRuns == 0;
+            });
+
+            if (!exception) {
+                exception = _workerException;
+            }
+
+            _workerException = nullptr;
+        }
+
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+    }
+
+    // Summed in the order surfaces were added, whichever thread calculated them.
+    AeroWrench wrench;
+
+    for (std::size_t i = 0; i < _surfaceWrenches.size(); i++) {
+        wrench.force_N += _surfaceWrenches[i].force_N;
+        wrench.moment_N_m += _surfaceWrenches[i].moment_N_m;
+    }
+
+    return wrench;
+}
+
+void VehicleAeroModel::updateRun(std::size_t run) {
+    const std::size_t runs = getThreadCount();
+    const std::size_t first = run * _surfaces.size() / runs;
+    const std::size_t last = (run + 1) * _surfaces.size() / runs;
+
+    for (std::size_t i = first; i < last; i++) {
+        _surfaceWrenches[i] = _surfaces[i].updateWrenchInBody(_snapshot, _worldToBody, _velocitiesInWorld_m_per_s[i],
+                              _propWashes_m_per_s[i], _controlAngles_rad[i]);
+    }
+}
+
+void VehicleAeroModel::runWorker(std::size_t run, std::size_t generation) {
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _updateStarted.wait(lock, [this, generation] {
+                return _stopping || _generation != generation;
+            });
+
+            if (_stopping) {
+                return;
+            }
+
+            generation = _generation;
+        }
+
+        // Rethrown by the caller, as it would escape the thread and terminate the program otherwise.
+        std::exception_ptr exception;
+
+        try {
+            updateRun(run);
+        } catch (...) {
+            exception = std::current_exception();
+        }
+
+        bool finished;
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            if (exception && !_workerException) {
+                _workerException = exception;
+            }
+
+            finished = (--_pendingRuns == 0);
+        }
+
+        if (finished) {
+            _runsFinished.notify_one();
+        }
+    }
+}
+
+void VehicleAeroModel::stopWorkers() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+
+    _updateStarted.notify_all();
+
+    for (std::size_t i = 0; i < _workers.size(); i++) {
+        _workers[i].join();
+    }
+
+    _workers.clear();
+    _stopping = false;
+}
+
+}  // namespace avionics_sim
@@ -0,0 +1,568 @@
+/**
+ * @copyright   Copyright (c) 2021, Swift Engineering Inc.
+ * @license     Licensed under the MIT license. See LICENSE for details.
+ */
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <ignition/math/Pose3.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "AerodynamicModel.hpp"
+#include "AerodynamicModelT.hpp"
+#include "AerodynamicSurfaceSet.hpp"
+#include "AtmosphereEnvironment.hpp"
+#include "BenchmarkUtils.hpp"
+#include "Coordinate_Utils.hpp"
+#include "Math_util.hpp"
+#include "VehicleAeroModel.hpp"
+
+namespace {
+
+// Polar of the sin/cos airfoil of the benchmarks, one row per degree, filled in by benchmarks needing it.
+avionics_sim::AirfoilTable<361> fixedPolar;
+
+// Environment whose air density is called with no virtual dispatch.
+class SeaLevelEnvironment final : public avionics_sim::IPhysicsEnvironment {
+  public:
+    double get_air_density_kg_per_m3() override {
+        return 1.22;
+    }
+};
+
+}  // namespace
+
+namespace avionics_sim {
+
+class AerodynamicModelBenchmark : public ::testing::Test, IPhysicsEnvironment {
+  public:
+    virtual double get_air_density_kg_per_m3() {
+        return 1.22;
+    }
+
+  protected:
+    static const std::size_t iterations = 1000000;
+
+    AerodynamicModel aerodynamic_model_;
+    std::vector<ignition::math::Pose3d> poses_;
+    std::vector<ignition::math::Vector3d> velocities_;
+
+    IPhysicsEnvironment &environment() {
+        return *this;
+    }
+
+    virtual void SetUp() {
+        std::vector<double> alpha_deg, cl, cd;
+
+        for (int i = -180; i <= 180; i++) {
+            alpha_deg.push_back(i);
+            cl.push_back(sin(2.0 * DEG2RAD(i)));
+            cd.push_back(1.0 - cos(2.0 * DEG2RAD(i)) + 0.01);
+        }
+
+        aerodynamic_model_ = AerodynamicModel(Airfoil(1.0, 0.1, alpha_deg, cl, cd), *this);
+        aerodynamic_model_.setBasisVectors(ignition::math::Vector3d(0, 0, 1), ignition::math::Vector3d(-1, 0, 0));
+
+        // Gentle pitch oscillation in forward flight.
+        for (std::size_t i = 0; i < 1024; i++) {
+            double phase = i * 2.0 * M_PI / 1024.0;
+            poses_.push_back(ignition::math::Pose3d(0, 0, 0, -0.09, 1.48 + 0.2 * sin(phase), 0.1));
+            velocities_.push_back(ignition::math::Vector3d(10, 1, 0.1 + cos(phase)));
+        }
+    }
+};
+
+TEST_F(AerodynamicModelBenchmark, UpdateForcesInBody) {
+    std::size_t allocationsBefore = benchmark::allocation_count();
+    double update_ns = benchmark::time_ns_per_call([&](std::size_t i) {
+        std::size_t sample = i % poses_.size();
+        benchmark::do_not_optimize(
+            aerodynamic_model_.updateForcesInBody_N(poses_[sample], velocities_[sample], 0, 0.05).X());
+    }, iterations);
+    double allocations = double(benchmark::allocation_count() - allocationsBefore) / iterations;
+
+    benchmark::report("updateForcesInBody_N", update_ns, "ns/call");
+    benchmark::report("updateForcesInBody_N allocations", allocations, "allocs/call");
+
+    EXPECT_EQ(allocations, 0.0);
+}
+
+TEST_F(AerodynamicModelBenchmark, UpdateForcesInBodyByStateCapture) {
+    const AerodynamicModel::StateCapture captures[] = {
+        AerodynamicModel::STATE_CAPTURE_FULL,
+        AerodynamicModel::STATE_CAPTURE_FORCES,
+        AerodynamicModel::STATE_CAPTURE_NONE
+    };
+    const char *names[] = {"full", "forces", "none"};
+
+    for (int c = 0; c < 3; c++) {
+        aerodynamic_model_.setStateCapture(captures[c]);
+
+        double update_ns = benchmark::time_ns_per_call([&](std::size_t i) {
+            std::size_t sample = i % poses_.size();
+            benchmark::do_not_optimize(
+                aerodynamic_model_.updateForcesInBody_N(poses_[sample], velocities_[sample], 0, 0.05).X());
+        }, iterations);
+
+        benchmark::report(std::string("updateForcesInBody_N, state capture ") + names[c], update_ns, "ns/call");
+    }
+}
+
+TEST_F(AerodynamicModelBenchmark, ExactVersusFastAngleMath) {
+    std::vector<double> ys, xs;
+
+    for (std::size_t i = 0; i < poses_.size(); i++) {
+        ys.push_back(-velocities_[i].X() * sin(i * 0.37));
+        xs.push_back(velocities_[i].Z() + cos(i * 0.11));
+    }
+
+    double atan2_ns = benchmark::time_ns_per_call([&](std::size_t i) {
+        std::size_t sample = i % ys.size();
+        benchmark::do_not_optimize(atan2(ys[sample], xs[sample]));
+    }, iterations);
+
+    double fast_atan2_ns = benchmark::time_ns_per_call([&](std::size_t i) {
+        std::size_t sample = i % ys.size();
+        benchmark::do_not_optimize(Math_util::fast_atan2(ys[sample], xs[sample]));
+    }, iterations);
+
+    double asin_ns = benchmark::time_ns_per_call([&](std::size_t i) {
+        benchmark::do_not_optimize(asin(sin(i * 0.37)));
+    }, iterations);
+
+    double fast_asin_ns = benchmark::time_ns_per_call([&](std::size_t i) {
+        benchmark::do_not_optimize(Math_util::fast_asin(sin(i * 0.37)));
+    }, iterations);
+
+    benchmark::report("atan2", atan2_ns, "ns/call");
+    benchmark::report("Math_util::fast_atan2", fast_atan2_ns, "ns/call");
+    benchmark::report("asin, with its argument's sin", asin_ns, "ns/call");
+    benchmark::report("Math_util::fast_asin, with its argument's sin", fast_asin_ns, "ns/call");
+
+    const AerodynamicModel::AngleMath angleMaths[] = {
+        AerodynamicModel::ANGLE_MATH_FAST,
+        AerodynamicModel::ANGLE_MATH_EXACT
+    };
+    const char *names[] = {"fast", "exact"};
+
+    for (int m = 0; m < 2; m++) {
+        aerodynamic_model_.setAngleMath(angleMaths[m]);
+
+        double update_ns = benchmark::time_ns_per_call([&](std::size_t i) {
+            std::size_t sample = i % poses_.size();
+            benchmark::do_not_optimize(
+                aerodynamic_model_.updateForcesInBody_N(poses_[sample], velocities_[sample], 0, 0.05).X());
+        }, iterations);
+
+        benchmark::report(std::string("updateForcesInBody_N, angle math ") + names[m], update_ns, "ns/call");
+    }
+}
+
+TEST_F(AerodynamicModelBenchmark, VirtualAdapterVersusTemplate) {
+    for (int i = -180; i <= 180; i++) {
+        fixedPolar.columns[0][i + 180] = i;
+        fixedPolar.columns[1][i + 180] = sin(2.0 * DEG2RAD(i));
+        fixedPolar.columns[2][i + 180] = 1.0 - cos(2.0 * DEG2RAD(i)) + 0.01;
+    }
+
+    SeaLevelEnvironment seaLevel;
+    ignition::math::Vector3d forward(0, 0, 1);
+    ignition::math::Vector3d upward(-1, 0, 0);
+
+    // The same fixed polar, behind the virtual interfaces and inline.
+    AerodynamicModel adapter(Airfoil(1.0, 0.1, fixedPolar), seaLevel);
+    AerodynamicModelT<SeaLevelEnvironment, FixedAirfoil<361>> model(FixedAirfoil<361>(1.0, 0.1, fixedPolar), seaLevel);
+    IAerodynamicModel &interface = adapter;
+
+    adapter.setBasisVectors(forward, upward);
+    model.setBasisVectors(forward, upward);
+
+    std::vector<ignition::math::Matrix3d> rotations(poses_.size());
+
+    for (std::size_t i = 0; i < poses_.size(); i++) {
+        Coordinate_Utils::project_rotation_global(poses_[i], &rotations[i]);
+    }
+
+    const AerodynamicModel::StateCapture captures[] = {
+        AerodynamicModel::STATE_CAPTURE_FULL,
+        AerodynamicModel::STATE_CAPTURE_NONE
+    };
+    const char *names[] = {"full", "none"};
+
+    for (int c = 0; c < 2; c++) {
+        adapter.setStateCapture(captures[c]);
+        model.setStateCapture(captures[c]);
+
+        double interface_ns = benchmark::time_ns_per_call([&](std::size_t i) {
+            std::size_t sample = i % poses_.size();
+            benchmark::do_not_optimize(
+                interface.updateForcesInBody_N(poses_[sample], velocities_[sample], 0, 0.05).X());
+        }, iterations);
+
+        double template_ns = benchmark::time_ns_per_call([&](std::size_t i) {
+            std::size_t sample = i % poses_.size();
+            benchmark::do_not_optimize(
+                model.updateForcesInBody_N(poses_[sample], velocities_[sample], 0, 0.05).X());
+        }, iterations);
+
+        double adapterRotation_ns = benchmark::time_ns_per_call([&](std::size_t i) {
+            std::size_t sample = i % poses_.size();
+            benchmark::do_not_optimize(
+                adapter.updateForcesInBody_N(rotations[sample], velocities_[sample], 0, 0.05).X());
+        }, iterations);
+
+        double templateRotation_ns = benchmark::time_ns_per_call([&](std::size_t i) {
+            std::size_t sample = i % poses_.size();
+            benchmark::do_not_optimize(
+                model.updateForcesInBody_N(rotations[sample], velocities_[sample], 0, 0.05).X());
+        }, iterations);
+
+        std::string capture = std::string(", state capture ") + names[c];
+        benchmark::report("IAerodynamicModel, from the pose" + capture, interface_ns, "ns/call");
+        benchmark::report("AerodynamicModelT, from the pose" + capture, template_ns, "ns/call");
+        benchmark::report("AerodynamicModel, from a rotation" + capture, adapterRotation_ns, "ns/call");
+        benchmark::report("AerodynamicModelT, from a rotation" + capture, templateRotation_ns, "ns/call");
+    }
+}
+
+TEST_F(AerodynamicModelBenchmark, WrenchVersusMomentsOutside) {
+    std::vector<double> alpha_deg, cl, cd, cm;
+
+    for (int i = -180; i <= 180; i++) {
+        alpha_deg.push_back(i);
+        cl.push_back(sin(2.0 * DEG2RAD(i)));
+        cd.push_back(1.0 - cos(2.0 * DEG2RAD(i)) + 0.01);
+        cm.push_back(-0.1 * sin(2.0 * DEG2RAD(i)));
+    }
+
+    const double area_m2 = 1.0;
+    const double chord_m = 0.3;
+    const ignition::math::Vector3d forward(0, 0, 1);
+    const ignition::math::Vector3d upward(-1, 0, 0);
+    const ignition::math::Vector3d centerOfPressure_m(0.2, 0.0, -0.8);
+
+    AerodynamicModel model(Airfoil(area_m2, 0.1, chord_m, alpha_deg, cl, cd, cm), environment());
+    model.setBasisVectors(forward, upward);
+    model.setCenterOfPressure(centerOfPressure_m);
+    model.setStateCapture(AerodynamicModel::STATE_CAPTURE_NONE);
+
+    // As a caller would, with a polar of its own for the pitching moment.
+    LookupTable momentPolar({"alpha", "CM"}, {alpha_deg, cm});
+    LookupTable::ColumnHandle alphaColumn = momentPolar.resolveColumn("alpha");
+    LookupTable::ColumnHandle cmColumn = momentPolar.resolveColumn("CM");
+    const ignition::math::Vector3d port = forward.Cross(upward);
+
+    double outside_ns = benchmark::time_ns_per_call([&](std::size_t i) {
+        std::size_t sample = i % poses_.size();
+        ignition::math::Vector3d force_N = model.updateForcesInBody_N(poses_[sample], velocities_[sample], 0, 0.05);
+
+        // Which derives the flow again to find the pitching moment.
+        ignition::math::Vector3d velocityInBody_m_per_s = model.transformToLocalVelocity(poses_[sample],
+                velocities_[sample]);
+        double planarVelocity_m_per_s = model.transformBodyToWindPlanar(velocityInBody_m_per_s);
+        AeroAngles angles_deg = model.correctAttackAnglesForDirectionAndControl_deg(
+                                    model.calculateBodyAttackAngles_deg(velocityInBody_m_per_s), 0.05,
+                                    planarVelocity_m_per_s);
+        double pitchingMoment_N_m = momentPolar.lookup(angles_deg.attackAngle_deg, alphaColumn, cmColumn) *
+                                    model.calculateDynamicPressure_Pa(planarVelocity_m_per_s) * area_m2 * chord_m;
+        ignition::math::Vector3d moment_N_m = centerOfPressure_m.Cross(force_N) + port * pitchingMoment_N_m;
+
+        benchmark::do_not_optimize(force_N.X() + moment_N_m.Y());
+    }, iterations);
+
+    double wrench_ns = benchmark::time_ns_per_call([&](std::size_t i) {
+        std::size_t sample = i % poses_.size();
+        AeroWrench wrench = model.updateWrenchInBody(poses_[sample], velocities_[sample], 0, 0.05);
+
+        benchmark::do_not_optimize(wrench.force_N.X() + wrench.moment_N_m.Y());
+    }, iterations);
+
+    double forces_ns = benchmark::time_ns_per_call([&](std::size_t i) {
+        std::size_t sample = i % poses_.size();
+        benchmark::do_not_optimize(model.updateForcesInBody_N(poses_[sample], velocities_[sample], 0, 0.05).X());
+    }, iterations);
+
+    benchmark::report("Forces, then moments derived outside", outside_ns, "ns/call");
+    benchmark::report("updateWrenchInBody", wrench_ns, "ns/call");
+    benchmark::report("updateForcesInBody_N alone", forces_ns, "ns/call");
+}
+
+TEST_F(AerodynamicModelBenchmark, VehicleAeroModelVersusSummedSurfaces) {
+    std::vector<double> alpha_deg, cl, cd, cm;
+
+    for (int i = -180; i <= 180; i++) {
+        alpha_deg.push_back(i);
+        cl.push_back(sin(2.0 * DEG2RAD(i)));
+        cd.push_back(1.0 - cos(2.0 * DEG2RAD(i)) + 0.01);
+        cm.push_back(-0.1 * sin(2.0 * DEG2RAD(i)));
+    }
+
+    const std::size_t sizes[] = {12, 480};
+
+    for (std::size_t surfaces : sizes) {
+        const std::size_t steps = iterations / surfaces;
+        VehicleAeroModel vehicle(environment());
+        std::vector<AerodynamicModel> models;
+
+        for (std::size_t s = 0; s < surfaces; s++) {
+            double heading = s * 2.0 * M_PI / surfaces;
+            ignition::math::Vector3d forward(cos(heading), sin(heading), 1);
+            ignition::math::Vector3d upward(-1, 0, 0);
+            ignition::math::Vector3d centerOfPressure_m(0.1 * s, 0.5, -0.2);
+            Airfoil airfoil(1.0, 0.1, 0.3, alpha_deg, cl, cd, cm);
+
+            vehicle.addSurface(airfoil, forward, upward, centerOfPressure_m);
+
+            models.push_back(AerodynamicModel(airfoil, environment()));
+            models.back().setBasisVectors(forward, upward);
+            models.back().setCenterOfPressure(centerOfPressure_m);
+            models.back().setStateCapture(AerodynamicModel::STATE_CAPTURE_NONE);
+        }
+
+        std::vector<ignition::math::Vector3d> velocities(surfaces);
+        std::vector<double> propWashes(surfaces, 0.0), controlAngles(surfaces, 0.05);
+
+        // Each surface through its own model, summed by the caller.
+        double summed_ns = benchmark::time_ns_per_call([&](std::size_t i) {
+            std::size_t sample = i % poses_.size();
+            AeroWrench total;
+
+            for (std::size_t s = 0; s < surfaces; s++) {
+                AeroWrench wrench = models[s].updateWrenchInBody(poses_[sample], velocities_[sample], 0, 0.05);
+                total.force_N += wrench.force_N;
+                total.moment_N_m += wrench.moment_N_m;
+            }
+
+            benchmark::do_not_optimize(total.force_N.X() + total.moment_N_m.Y());
+        }, steps);
+
+        std::string label = std::to_string(surfaces) + " surfaces, ";
+        benchmark::report(label + "models summed by the caller", summed_ns, "ns/step");
+
+        const std::size_t threadCounts[] = {1, 2, 4};
+
+        for (std::size_t threadCount : threadCounts) {
+            vehicle.setThreadCount(threadCount);
+
+            double vehicle_ns = benchmark::time_ns_per_call([&](std::size_t i) {
+                std::size_t sample = i % poses_.size();
+                std::fill(velocities.begin(), velocities.end(), velocities_[sample]);
+
+                AeroWrench total = vehicle.updateWrenchInBody(poses_[sample], velocities.data(), propWashes.data(),
+                                   controlAngles.data());
+
+                benchmark::do_not_optimize(total.force_N.X() + total.moment_N_m.Y());
+            }, steps);
+
+            benchmark::report(label + "VehicleAeroModel, " + std::to_string(threadCount) + " threads", vehicle_ns,
+                              "ns/step");
+        }
+    }
+
+    benchmark::report("Hardware threads", double(std::thread::hardware_concurrency()), "threads");
+}
+
+TEST_F(AerodynamicModelBenchmark, AtmosphereQueriesVersusSnapshot) {
+    const std::size_t surfaces = 12;
+    const std::size_t steps = iterations / surfaces;
+
+    std::vector<double> alpha_deg, cl, cd;
+
+    for (int i = -180; i <= 180; i++) {
+        alpha_deg.push_back(i);
+        cl.push_back(sin(2.0 * DEG2RAD(i)));
+        cd.push_back(1.0 - cos(2.0 * DEG2RAD(i)) + 0.01);
+    }
+
+    // Surfaces of one vehicle, in the atmosphere at its height.
+    AtmosphereEnvironment atmosphere(1500.0);
+    std::vector<AerodynamicModel> models;
+
+    for (std::size_t s = 0; s < surfaces; s++) {
+        models.push_back(AerodynamicModel(Airfoil(1.0, 0.1, alpha_deg, cl, cd), atmosphere));
+        models.back().setBasisVectors(ignition::math::Vector3d(0, 0, 1), ignition::math::Vector3d(-1, 0, 0));
+    }
+
+    double query_ns = benchmark::time_ns_per_call([&](std::size_t i) {
+        std::size_t sample = i % poses_.size();
+
+        for (std::size_t s = 0; s < surfaces; s++) {
+            benchmark::do_not_optimize(
+                models[s].updateForcesInBody_N(poses_[sample], velocities_[sample], 0, 0.05).X());
+        }
+    }, steps);
+
+    double snapshot_ns = benchmark::time_ns_per_call([&](std::size_t i) {
+        std::size_t sample = i % poses_.size();
+        EnvironmentSnapshot snapshot = atmosphere.get_snapshot();
+
+        for (std::size_t s = 0; s < surfaces; s++) {
+            benchmark::do_not_optimize(
+                models[s].updateForcesInBody_N(snapshot, poses_[sample], velocities_[sample], 0, 0.05).X());
+        }
+    }, steps);
+
+    double density_ns = benchmark::time_ns_per_call([&](std::size_t) {
+        benchmark::do_not_optimize(atmosphere.get_air_density_kg_per_m3());
+    }, iterations);
+
+    double environmentSnapshot_ns = benchmark::time_ns_per_call([&](std::size_t) {
+        benchmark::do_not_optimize(atmosphere.get_snapshot().airDensity_kg_per_m3);
+    }, iterations);
+
+    benchmark::report("12 surfaces, each querying the atmosphere", query_ns, "ns/step");
+    benchmark::report("12 surfaces, from one snapshot", snapshot_ns, "ns/step");
+    benchmark::report("AtmosphereEnvironment::get_air_density_kg_per_m3", density_ns, "ns/call");
+    benchmark::report("AtmosphereEnvironment::get_snapshot", environmentSnapshot_ns, "ns/call");
+}
+
+TEST_F(AerodynamicModelBenchmark, SharedPoseAsRotation) {
+    const std::size_t surfaces = 12;
+    const std::size_t steps = iterations / surfaces;
+
+    // Surfaces of one vehicle, sharing its pose.
+    std::vector<AerodynamicModel> models(surfaces, aerodynamic_model_);
+
+    double pose_ns = benchmark::time_ns_per_call([&](std::size_t i) {
+        std::size_t sample = i % poses_.size();
+
+        for (std::size_t s = 0; s < surfaces; s++) {
+            benchmark::do_not_optimize(
+                models[s].updateForcesInBody_N(poses_[sample], velocities_[sample], 0, 0.05).X());
+        }
+    }, steps);
+
+    double rotation_ns = benchmark::time_ns_per_call([&](std::size_t i) {
+        std::size_t sample = i % poses_.size();
+        ignition::math::Matrix3d worldToBody;
+        Coordinate_Utils::project_rotation_global(poses_[sample], &worldToBody);
+
+        for (std::size_t s = 0; s < surfaces; s++) {
+            benchmark::do_not_optimize(
+                models[s].updateForcesInBody_N(worldToBody, velocities_[sample], 0, 0.05).X());
+        }
+    }, steps);
+
+    benchmark::report("12 surfaces, each from the pose", pose_ns, "ns/step");
+    benchmark::report("12 surfaces, from one rotation", rotation_ns, "ns/step");
+}
+
+TEST_F(AerodynamicModelBenchmark, UpdateForcesInBodyBatch) {
+    const std::size_t batches = iterations / poses_.size();
+    std::vector<double> propWashes(poses_.size(), 0.0), controlAngles(poses_.size(), 0.05);
+    std::vector<ignition::math::Vector3d> forces(poses_.size());
+    IAerodynamicModel &model = aerodynamic_model_;
+
+    double single_ns = benchmark::time_ns_per_call([&](std::size_t i) {
+        std::size_t sample = i % poses_.size();
+        benchmark::do_not_optimize(
+            model.updateForcesInBody_N(poses_[sample], velocities_[sample], 0, 0.05).X());
+    }, batches * poses_.size());
+
+    std::size_t allocationsBefore = benchmark::allocation_count();
+    double batch_ns = benchmark::time_ns_per_call([&](std::size_t) {
+        model.updateForcesInBody_N(poses_.data(), velocities_.data(), propWashes.data(), controlAngles.data(),
+                                   poses_.size(), forces.data());
+        benchmark::do_not_optimize(forces.back().X());
+    }, batches) / poses_.size();
+    double allocations = double(benchmark::allocation_count() - allocationsBefore) / batches;
+
+    benchmark::report("updateForcesInBody_N, one at a time", single_ns, "ns/element");
+    benchmark::report("updateForcesInBody_N, batches of 1024", batch_ns, "ns/element");
+
+    EXPECT_EQ(allocations, 0.0);
+}
+
+TEST_F(AerodynamicModelBenchmark, TwelveSurfacesAsSetVersusModels) {
+    const std::size_t surfaces = 12;
+    const std::size_t steps = iterations / surfaces;
+
+    std::vector<AerodynamicModel> models(surfaces, aerodynamic_model_);
+    std::vector<IAerodynamicModel *> interfaces;
+    AerodynamicSurfaceSet set(environment());
+
+    for (std::size_t s = 0; s < surfaces; s++) {
+        interfaces.push_back(&models[s]);
+
+        // The polar of the fixture, as each surface loads its own.
+        std::vector<double> alpha_deg, cl, cd;
+
+        for (int i = -180; i <= 180; i++) {
+            alpha_deg.push_back(i);
+            cl.push_back(sin(2.0 * DEG2RAD(i)));
+            cd.push_back(1.0 - cos(2.0 * DEG2RAD(i)) + 0.01);
+        }
+
+        set.addSurface(Airfoil(1.0, 0.1, alpha_deg, cl, cd), ignition::math::Vector3d(0, 0, 1),
+                       ignition::math::Vector3d(-1, 0, 0));
+    }
+
+    // Each surface a step further along the oscillation of the fixture.
+    std::vector<ignition::math::Pose3d> poses(surfaces);
+    std::vector<ignition::math::Vector3d> velocities(surfaces);
+    std::vector<double> propWashes(surfaces, 0.0), controlAngles(surfaces, 0.05);
+    std::vector<ignition::math::Vector3d> forces(surfaces);
+
+    double models_ns = benchmark::time_ns_per_call([&](std::size_t i) {
+        for (std::size_t s = 0; s < surfaces; s++) {
+            std::size_t sample = (i + s) % poses_.size();
+            benchmark::do_not_optimize(
+                interfaces[s]->updateForcesInBody_N(poses_[sample], velocities_[sample], 0, 0.05).X());
+        }
+    }, steps);
+
+    std::size_t allocationsBefore = benchmark::allocation_count();
+    double set_ns = benchmark::time_ns_per_call([&](std::size_t i) {
+        for (std::size_t s = 0; s < surfaces; s++) {
+            std::size_t sample = (i + s) % poses_.size();
+            poses[s] = poses_[sample];
+            velocities[s] = velocities_[sample];
+        }
+
+        set.updateForcesInBody_N(poses.data(), velocities.data(), propWashes.data(), controlAngles.data(),
+                                 forces.data());
+        benchmark::do_not_optimize(forces[surfaces - 1].X());
+    }, steps);
+    double allocations = double(benchmark::allocation_count() - allocationsBefore) / steps;
+
+    benchmark::report("12 AerodynamicModels", models_ns, "ns/step");
+    benchmark::report("AerodynamicSurfaceSet of 12", set_ns, "ns/step");
+
+    EXPECT_EQ(allocations, 0.0);
+}
+
+TEST_F(AerodynamicModelBenchmark, SwarmOfIdenticalVehicles) {
+    const std::size_t vehicles = 200;
+
+    // Without the polar of the fixture, so that the swarm's are counted from none.
+    aerodynamic_model_ = AerodynamicModel();
+    TableRegistry::Usage before = TableRegistry::instance().usage();
+
+    // Each vehicle loads its own copy of the same polar, as from its own model file.
+    std::vector<AerodynamicModel> swarm;
+
+    for (std::size_t v = 0; v < vehicles; v++) {
+        std::vector<double> alpha_deg, cl, cd;
+
+        for (int i = -180; i <= 180; i++) {
+            alpha_deg.push_back(i);
+            cl.push_back(sin(2.0 * DEG2RAD(i)));
+            cd.push_back(1.0 - cos(2.0 * DEG2RAD(i)) + 0.01);
+        }
+
+        swarm.push_back(AerodynamicModel(Airfoil(1.0, 0.1, alpha_deg, cl, cd), environment()));
+    }
+
+    TableRegistry::Usage after = TableRegistry::instance().usage();
+
+    benchmark::report("200 vehicles, polar bytes held", double(after.tableBytes - before.tableBytes), "bytes");
+    benchmark::report("200 vehicles, polar bytes if unshared", double(after.unsharedBytes - before.unsharedBytes),
+                      "bytes");
+
+    EXPECT_EQ(after.tableCount - before.tableCount, 3);
+}
+
+}  // namespace avionics_sim
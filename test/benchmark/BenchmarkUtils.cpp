@@ -0,0 +1,52 @@
+/**
+ * @copyright   Copyright (c) 2021, Swift Engineering Inc.
+ * @license     Licensed under the MIT license. See LICENSE for details.
+ */
+
+#include "BenchmarkUtils.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<std::size_t> allocations(0);
+
+volatile double sink;
+
+}  // namespace
+
+void *operator new(std::size_t size) {
+    allocations++;
+
+    void *ptr = std::malloc(size == 0 ? 1 : size);
+
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+
+    return ptr;
+}
+
+void operator delete(void *ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+namespace avionics_sim {
+namespace benchmark {
+
+std::size_t allocation_count() {
+    return allocations.load();
+}
+
+void do_not_optimize(double value) {
+    sink = value;
+}
+
+}  // namespace benchmark
+}  // namespace avionics_sim
@@ -0,0 +1,57 @@
+/**
+ * @copyright   Copyright (c) 2021, Swift Engineering Inc.
+ * @license     Licensed under the MIT license. See LICENSE for details.
+ */
+
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+
+namespace avionics_sim {
+namespace benchmark {
+
+///
+/// \brief      Number of calls made to the global operator new since program start.
+/// \details    The benchmark executable replaces the global allocation functions to keep this count.
+///
+std::size_t allocation_count();
+
+///
+/// \brief      Keeps the compiler from discarding a value computed inside a timed loop.
+///
+void do_not_optimize(double value);
+
+///
+/// \brief      Times a callable
+/// \param[in]  function    Callable invoked with the iteration index
+/// \param[in]  iterations  Number of calls to make
+/// \return     Mean wall time per call in nanoseconds
+///
+template <typename Function>
+double time_ns_per_call(Function function, std::size_t iterations) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    for (std::size_t i = 0; i < iterations; i++) {
+        function(i);
+    }
+
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+///
+/// \brief      Prints a result line and records it in the gtest xml output.
+///
+inline void report(const std::string &name, double value, const std::string &unit) {
+    printf("[ BENCHMARK] %-48s %12.2f %s\n", name.c_str(), value, unit.c_str());
+    ::testing::Test::RecordProperty(name, std::to_string(value) + " " + unit);
+}
+
+}  // namespace benchmark
+}  // namespace avionics_sim
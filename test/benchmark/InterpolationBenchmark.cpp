@@ -0,0 +1,458 @@
+/**
+ * @copyright   Copyright (c) 2021, Swift Engineering Inc.
+ * @license     Licensed under the MIT license. See LICENSE for details.
+ */
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Bilinear_interp.hpp"
+#include "BenchmarkUtils.hpp"
+#include "Multilinear_interp.hpp"
+
+namespace avionics_sim {
+
+class InterpolationBenchmark : public ::testing::TestWithParam<std::size_t> {
+  protected:
+    static const std::size_t iterations = 1000000;
+
+    std::vector<double> xVals;
+    std::vector<double> yVals;
+    std::vector<double> queries;
+
+    virtual void SetUp() {
+        std::size_t points = GetParam();
+
+        for (std::size_t i = 0; i < points; i++) {
+            xVals.push_back(-180.0 + i * 360.0 / (points - 1));
+            yVals.push_back(0.01 * xVals.back());
+        }
+
+        // Queries spread over the whole table, including a margin either side of it.
+        std::mt19937_64 generator(0);
+        std::uniform_real_distribution<double> distribution(-190.0, 190.0);
+
+        for (std::size_t i = 0; i < 4096; i++) {
+            queries.push_back(distribution(generator));
+        }
+    }
+};
+
+TEST_P(InterpolationBenchmark, BinarySearchVersusUniformGrid) {
+    Bilinear_interp::UniformGrid grid = Bilinear_interp::detectUniformGrid(xVals);
+    ASSERT_TRUE(grid.isUniform);
+
+    double search_ns = benchmark::time_ns_per_call([&](std::size_t i) {
+        double y;
+        Bilinear_interp::interpolate(xVals, yVals, queries[i % queries.size()], &y);
+        benchmark::do_not_optimize(y);
+    }, iterations);
+
+    double grid_ns = benchmark::time_ns_per_call([&](std::size_t i) {
+        double y;
+        Bilinear_interp::interpolate(xVals, grid, yVals, queries[i % queries.size()], &y);
+        benchmark::do_not_optimize(y);
+    }, iterations);
+
+    std::string points = std::to_string(GetParam()) + " points";
+    benchmark::report("interpolate, binary search, " + points, search_ns, "ns/call");
+    benchmark::report("interpolate, uniform grid, " + points, grid_ns, "ns/call");
+}
+
+TEST_P(InterpolationBenchmark, BinarySearchVersusCursor) {
+    // Breakpoints concentrated around zero, as in an airfoil table, so that the grid does not apply.
+    std::vector<double> unevenXVals;
+
+    for (std::size_t i = 0; i < xVals.size(); i++) {
+        double t = xVals[i] / 180.0;
+        unevenXVals.push_back(180.0 * t * t * t);
+    }
+
+    Bilinear_interp::UniformGrid grid = Bilinear_interp::detectUniformGrid(unevenXVals);
+    ASSERT_FALSE(grid.isUniform);
+
+    // Queries that change a little from one call to the next, as the angle of attack does between time steps.
+    std::vector<double> sweep;
+
+    for (std::size_t i = 0; i < queries.size(); i++) {
+        sweep.push_back(170.0 * std::sin(2.0 * M_PI * i / queries.size()));
+    }
+
+    double search_ns = benchmark::time_ns_per_call([&](std::size_t i) {
+        double y;
+        Bilinear_interp::interpolate(unevenXVals, yVals, sweep[i % sweep.size()], &y);
+        benchmark::do_not_optimize(y);
+    }, iterations);
+
+    Bilinear_interp::Cursor cursor;
+    double cursor_ns = benchmark::time_ns_per_call([&](std::size_t i) {
+        double y;
+        Bilinear_interp::interpolate(unevenXVals, grid, yVals, sweep[i % sweep.size()], &y, &cursor);
+        benchmark::do_not_optimize(y);
+    }, iterations);
+
+    std::string points = std::to_string(GetParam()) + " points";
+    benchmark::report("interpolate, binary search, coherent queries, " + points, search_ns, "ns/call");
+    benchmark::report("interpolate, cursor, coherent queries, " + points, cursor_ns, "ns/call");
+}
+
+INSTANTIATE_TEST_CASE_P(TableSizes,
+                        InterpolationBenchmark,
+                        ::testing::Values(50, 500, 5000));
+
+TEST(Interpolation2DBenchmark, NestedVersusFlatStorage) {
+    const std::size_t iterations = 1000000;
+
+    // Unevenly spaced rows and columns, so that both versions search in the same way.
+    std::vector<std::vector<double>> xVals, zVals;
+    std::vector<double> yVals;
+
+    for (std::size_t j = 0; j < 20; j++) {
+        yVals.push_back(j * j * 0.5);
+        xVals.push_back(std::vector<double>());
+        zVals.push_back(std::vector<double>());
+
+        for (std::size_t i = 0; i < 60; i++) {
+            double t = (i - 30.0) / 30.0;
+            xVals[j].push_back(180.0 * t * t * t);
+            zVals[j].push_back(0.01 * xVals[j].back() + 0.1 * j);
+        }
+    }
+
+    Bilinear_interp interp(xVals, yVals, zVals);
+
+    std::mt19937_64 generator(0);
+    std::uniform_real_distribution<double> xDistribution(-180.0, 180.0);
+    std::uniform_real_distribution<double> yDistribution(0.0, yVals.back());
+    std::vector<double> xQueries, yQueries;
+
+    for (std::size_t i = 0; i < 4096; i++) {
+        xQueries.push_back(xDistribution(generator));
+        yQueries.push_back(yDistribution(generator));
+    }
+
+    double nested_ns = benchmark::time_ns_per_call([&](std::size_t i) {
+        double z;
+        interp.interpolate2D(xVals, yVals, zVals, xQueries[i % xQueries.size()], yQueries[i % yQueries.size()], &z);
+        benchmark::do_not_optimize(z);
+    }, iterations);
+
+    double flat_ns = benchmark::time_ns_per_call([&](std::size_t i) {
+        double z;
+        interp.interpolate2D(xQueries[i % xQueries.size()], yQueries[i % yQueries.size()], &z);
+        benchmark::do_not_optimize(z);
+    }, iterations);
+
+    benchmark::report("interpolate2D, nested vectors", nested_ns, "ns/call");
+    benchmark::report("interpolate2D, flat table", flat_ns, "ns/call");
+}
+
+TEST(Interpolation2DBenchmark, WeightsVersusPrecomputedSlopes) {
+    const std::size_t iterations = 1000000;
+
+    // Evenly spaced rows and columns, so that the searches are cheap and the divisions are the difference.
+    std::vector<std::vector<double>> xVals, zVals;
+    std::vector<double> yVals;
+
+    for (std::size_t j = 0; j < 20; j++) {
+        yVals.push_back(j * 2.5);
+        xVals.push_back(std::vector<double>());
+        zVals.push_back(std::vector<double>());
+
+        for (std::size_t i = 0; i < 61; i++) {
+            xVals[j].push_back(-180.0 + i * 6.0);
+            zVals[j].push_back(std::sin(0.01 * xVals[j].back()) + 0.1 * j);
+        }
+    }
+
+    Bilinear_interp weights(xVals, yVals, zVals);
+    Bilinear_interp slopes(xVals, yVals, zVals);
+    slopes.setPrecomputedSlopes(true);
+
+    std::mt19937_64 generator(0);
+    std::uniform_real_distribution<double> xDistribution(-180.0, 180.0);
+    std::uniform_real_distribution<double> yDistribution(0.0, yVals.back());
+    std::vector<double> xQueries, yQueries;
+
+    for (std::size_t i = 0; i < 4096; i++) {
+        xQueries.push_back(xDistribution(generator));
+        yQueries.push_back(yDistribution(generator));
+    }
+
+    double weights_ns = benchmark::time_ns_per_call([&](std::size_t i) {
+        double z;
+        weights.interpolate2D(xQueries[i % xQueries.size()], yQueries[i % yQueries.size()], &z);
+        benchmark::do_not_optimize(z);
+    }, iterations);
+
+    double slopes_ns = benchmark::time_ns_per_call([&](std::size_t i) {
+        double z;
+        slopes.interpolate2D(xQueries[i % xQueries.size()], yQueries[i % yQueries.size()], &z);
+        benchmark::do_not_optimize(z);
+    }, iterations);
+
+    benchmark::report("interpolate2D, weights", weights_ns, "ns/call");
+    benchmark::report("interpolate2D, precomputed slopes", slopes_ns, "ns/call");
+}
+
+TEST(Interpolation2DBenchmark, SingleVersusBatch) {
+    const std::size_t iterations = 1000;
+    const std::size_t points = 4096;
+
+    // Evenly spaced rows and columns, as in a trim sweep table, so that the arithmetic is a larger part of the cost.
+    std::vector<std::vector<double>> xVals, zVals;
+    std::vector<double> yVals;
+
+    for (std::size_t j = 0; j < 20; j++) {
+        yVals.push_back(j * 2.5);
+        xVals.push_back(std::vector<double>());
+        zVals.push_back(std::vector<double>());
+
+        for (std::size_t i = 0; i < 61; i++) {
+            xVals[j].push_back(-180.0 + i * 6.0);
+            zVals[j].push_back(std::sin(0.01 * xVals[j].back()) + 0.1 * j);
+        }
+    }
+
+    Bilinear_interp interp(xVals, yVals, zVals);
+
+    std::mt19937_64 generator(0);
+    std::uniform_real_distribution<double> xDistribution(-190.0, 190.0);
+    std::uniform_real_distribution<double> yDistribution(-1.0, yVals.back() + 1.0);
+    std::vector<double> x, y, z(points);
+    std::vector<Bilinear_interp::InterpResult> results(points);
+
+    for (std::size_t i = 0; i < points; i++) {
+        x.push_back(xDistribution(generator));
+        y.push_back(yDistribution(generator));
+    }
+
+    double single_ns = benchmark::time_ns_per_call([&](std::size_t) {
+        for (std::size_t i = 0; i < points; i++) {
+            results[i] = interp.interpolate2D(x[i], y[i], &z[i]);
+        }
+
+        benchmark::do_not_optimize(z[points - 1]);
+    }, iterations) / points;
+
+    double batch_ns = benchmark::time_ns_per_call([&](std::size_t) {
+        interp.interpolate2D(x, y, z.data(), results.data());
+        benchmark::do_not_optimize(z[points - 1]);
+    }, iterations) / points;
+
+    std::string instructionSet = Bilinear_interp::batchInstructionSet();
+    benchmark::report("interpolate2D, one point per call", single_ns, "ns/point");
+    benchmark::report("interpolate2D, batch (" + instructionSet + ")", batch_ns, "ns/point");
+}
+
+TEST(Interpolation2DBenchmark, InteriorVersusEdgeHeavyQueries) {
+    const std::size_t iterations = 1000;
+    const std::size_t points = 4096;
+
+    std::vector<std::vector<double>> xVals, zVals;
+    std::vector<double> yVals;
+
+    for (std::size_t j = 0; j < 20; j++) {
+        yVals.push_back(j * 2.5);
+        xVals.push_back(std::vector<double>());
+        zVals.push_back(std::vector<double>());
+
+        for (std::size_t i = 0; i < 61; i++) {
+            xVals[j].push_back(-180.0 + i * 6.0);
+            zVals[j].push_back(std::sin(0.01 * xVals[j].back()) + 0.1 * j);
+        }
+    }
+
+    Bilinear_interp interp(xVals, yVals, zVals);
+
+    // Queries within the table, and queries picked at random from within, beyond each edge and exactly on the edges,
+    // as during aggressive manoeuvres, so that which way each edge case goes cannot be predicted.
+    std::mt19937_64 generator(0);
+    std::uniform_real_distribution<double> xInside(-180.0, 180.0), yInside(0.0, yVals.back());
+    std::uniform_real_distribution<double> xBeyond(180.0, 400.0), yBeyond(yVals.back(), 2.0 * yVals.back());
+    std::uniform_int_distribution<int> side(0, 4);
+    std::vector<double> xInterior, yInterior, xEdge, yEdge, z(points);
+
+    auto pick = [&](double inside, double beyond, double first, double last) {
+        switch (side(generator)) {
+        case 0: return first - (beyond - last);
+        case 1: return beyond;
+        case 2: return first;
+        case 3: return last;
+        default: return inside;
+        }
+    };
+
+    for (std::size_t i = 0; i < points; i++) {
+        xInterior.push_back(xInside(generator));
+        yInterior.push_back(yInside(generator));
+        xEdge.push_back(pick(xInside(generator), xBeyond(generator), -180.0, 180.0));
+        yEdge.push_back(pick(yInside(generator), yBeyond(generator), 0.0, yVals.back()));
+    }
+
+    auto time = [&](const std::vector<double> &x, const std::vector<double> &y) {
+        return benchmark::time_ns_per_call([&](std::size_t) {
+            for (std::size_t i = 0; i < points; i++) {
+                interp.interpolate2D(x[i], y[i], &z[i]);
+            }
+
+            benchmark::do_not_optimize(z[points - 1]);
+        }, iterations) / points;
+    };
+
+    // Best of several runs of each in turn, against noise from other processes.
+    double interior_ns = INFINITY, edge_ns = INFINITY;
+
+    for (std::size_t repeat = 0; repeat < 5; repeat++) {
+        interior_ns = std::min(interior_ns, time(xInterior, yInterior));
+        edge_ns = std::min(edge_ns, time(xEdge, yEdge));
+    }
+
+    benchmark::report("interpolate2D, interior queries", interior_ns, "ns/point");
+    benchmark::report("interpolate2D, edge-heavy queries", edge_ns, "ns/point");
+}
+
+TEST(Interpolation2DBenchmark, DoubleVersusCompactStorage) {
+    const std::size_t iterations = 1000000;
+    const std::size_t rows = 4000, columns = 4000;
+
+    // An envelope table whose 128 MB of double z values are larger than the caches, queried at random.
+    std::vector<std::vector<double>> xVals, zVals;
+    std::vector<double> yVals;
+
+    for (std::size_t j = 0; j < rows; j++) {
+        yVals.push_back(j * 0.05);
+        xVals.push_back(std::vector<double>());
+        zVals.push_back(std::vector<double>());
+
+        for (std::size_t i = 0; i < columns; i++) {
+            xVals[j].push_back(i * 0.1);
+            zVals[j].push_back(std::sin(0.01 * xVals[j].back()) * std::cos(0.02 * yVals.back()));
+        }
+    }
+
+    Bilinear_interp interp(xVals, yVals, zVals);
+    std::vector<std::vector<double>>().swap(xVals);
+    std::vector<std::vector<double>>().swap(zVals);
+
+    std::mt19937_64 generator(0);
+    std::uniform_real_distribution<double> xDistribution(0.0, (columns - 1) * 0.1);
+    std::uniform_real_distribution<double> yDistribution(0.0, yVals.back());
+    std::vector<double> x, y;
+
+    for (std::size_t i = 0; i < 65536; i++) {
+        x.push_back(xDistribution(generator));
+        y.push_back(yDistribution(generator));
+    }
+
+    const Bilinear_interp::StorageMode modes[] = {Bilinear_interp::STORAGE_DOUBLE, Bilinear_interp::STORAGE_FLOAT32,
+                                                  Bilinear_interp::STORAGE_FIXED16};
+    const char *const names[] = {"double", "float32", "fixed16"};
+    double best_ns[] = {INFINITY, INFINITY, INFINITY};
+    Bilinear_interp::StorageError errors[3];
+
+    // The modes in turn, several times over, keeping the best time of each against noise from other processes.
+    for (std::size_t repeat = 0; repeat < 5; repeat++) {
+        for (std::size_t m = 0; m < 3; m++) {
+            ASSERT_TRUE(interp.setStorage(modes[m], &errors[m]));
+
+            best_ns[m] = std::min(best_ns[m], benchmark::time_ns_per_call([&](std::size_t i) {
+                double z;
+                interp.interpolate2D(x[i % x.size()], y[i % y.size()], &z);
+                benchmark::do_not_optimize(z);
+            }, iterations));
+        }
+    }
+
+    for (std::size_t m = 0; m < 3; m++) {
+        benchmark::report(std::string("interpolate2D, 4000 x 4000, ") + names[m], best_ns[m], "ns/call");
+        benchmark::report(std::string("interpolate2D, 4000 x 4000, ") + names[m] + " error",
+                          errors[m].maxInterpolationError * 1e6, "1e-6 max");
+    }
+}
+
+TEST(InterpolationNDBenchmark, NestedBilinearVersusMultilinear) {
+    const std::size_t iterations = 1000000;
+
+    // Alpha by Mach tables at each of several control deflections, as a 3D table would be held today.
+    std::vector<double> alpha, mach, deflection, values;
+
+    for (std::size_t i = 0; i < 61; i++) {
+        double t = (i - 30.0) / 30.0;
+        alpha.push_back(30.0 * t * t * t);
+    }
+
+    for (std::size_t j = 0; j < 10; j++) {
+        mach.push_back(j * 0.1);
+    }
+
+    for (std::size_t k = 0; k < 7; k++) {
+        deflection.push_back(-30.0 + k * 10.0);
+    }
+
+    std::vector<Bilinear_interp> slices;
+
+    for (double d : deflection) {
+        std::vector<std::vector<double>> xVals, zVals;
+
+        for (double m : mach) {
+            xVals.push_back(alpha);
+            zVals.push_back(std::vector<double>());
+
+            for (double a : alpha) {
+                zVals.back().push_back(std::sin(0.05 * a) * (1.0 + m) + 0.01 * d);
+            }
+        }
+
+        slices.push_back(Bilinear_interp(xVals, mach, zVals));
+    }
+
+    for (double a : alpha) {
+        for (double m : mach) {
+            for (double d : deflection) {
+                values.push_back(std::sin(0.05 * a) * (1.0 + m) + 0.01 * d);
+            }
+        }
+    }
+
+    Multilinear_interp<3> interp({alpha, mach, deflection}, values);
+    Bilinear_interp::UniformGrid deflectionGrid = Bilinear_interp::detectUniformGrid(deflection);
+
+    std::mt19937_64 generator(0);
+    std::uniform_real_distribution<double> alphaDistribution(-30.0, 30.0);
+    std::uniform_real_distribution<double> machDistribution(0.0, 0.9);
+    std::uniform_real_distribution<double> deflectionDistribution(-30.0, 30.0);
+    std::vector<std::array<double, 3>> queries;
+
+    for (std::size_t i = 0; i < 4096; i++) {
+        queries.push_back({alphaDistribution(generator), machDistribution(generator),
+                           deflectionDistribution(generator)});
+    }
+
+    double nested_ns = benchmark::time_ns_per_call([&](std::size_t i) {
+        const std::array<double, 3> &query = queries[i % queries.size()];
+        Bilinear_interp::Bracket bracket;
+        Bilinear_interp::findBracket(deflection, deflectionGrid, query[2], &bracket);
+
+        double z_l, z_u;
+        slices[bracket.lower].interpolate2D(query[0], query[1], &z_l);
+        slices[bracket.upper].interpolate2D(query[0], query[1], &z_u);
+        benchmark::do_not_optimize(bracket.weight * (z_u - z_l) + z_l);
+    }, iterations);
+
+    double multilinear_ns = benchmark::time_ns_per_call([&](std::size_t i) {
+        double value;
+        interp.interpolate(queries[i % queries.size()], &value);
+        benchmark::do_not_optimize(value);
+    }, iterations);
+
+    benchmark::report("3D table, nested Bilinear_interp", nested_ns, "ns/call");
+    benchmark::report("3D table, Multilinear_interp<3>", multilinear_ns, "ns/call");
+}
+
+}  // namespace avionics_sim
@@ -0,0 +1,194 @@
+/**
+ * @copyright   Copyright (c) 2021, Swift Engineering Inc.
+ * @license     Licensed under the MIT license. See LICENSE for details.
+ */
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Bilinear_interp.hpp"
+#include "BenchmarkUtils.hpp"
+#include "TableFile.hpp"
+
+namespace avionics_sim {
+
+// The parser as it was before it was made single pass, kept as the baseline to compare against.
+static bool legacyGet1DLUTelementsFromString(const std::string &inputVals, std::vector<double> *const outputVect) {
+    if (inputVals.empty()) {
+        return false;
+    }
+
+    std::string inputString = inputVals;
+    size_t pos = 0;
+    std::vector<double> row;
+    double tmpDouble;
+
+    while ((pos = inputString.find(",")) != std::string::npos) {
+        if (sscanf(inputString.substr(0, pos).c_str(), "%lf", &tmpDouble) != 1) {
+            return false;
+        }
+
+        row.push_back(tmpDouble);
+        inputString.erase(0, pos + 1);
+    }
+
+    if (sscanf(inputString.c_str(), "%lf", &tmpDouble) != 1) {
+        return false;
+    }
+
+    row.push_back(tmpDouble);
+    *outputVect = row;
+
+    return true;
+}
+
+static bool legacyGet2DLUTelementsFromString(const std::string &inputVals,
+        std::vector<std::vector<double>> *const outputVect) {
+    if (inputVals.empty()) {
+        return false;
+    }
+
+    std::stringstream ss(inputVals);
+    std::string to;
+    std::vector<std::vector<double>> vect_vals;
+    std::vector<double> row;
+
+    while (std::getline(ss, to, ';')) {
+        if (!legacyGet1DLUTelementsFromString(to, &row)) {
+            return false;
+        }
+
+        vect_vals.push_back(row);
+    }
+
+    *outputVect = vect_vals;
+
+    return true;
+}
+
+class LUTParserBenchmark : public ::testing::Test {
+  protected:
+    static const std::size_t iterations = 20;
+    static const std::size_t rows = 100;
+    static const std::size_t columns = 100;
+
+    std::string string1D;
+    std::string string2D;
+
+    virtual void SetUp() {
+        std::mt19937_64 generator(0);
+        std::uniform_real_distribution<double> distribution(-1000.0, 1000.0);
+        char buffer[32];
+
+        // 10k elements in either shape, written as a table file would hold them.
+        for (std::size_t j = 0; j < rows; j++) {
+            for (std::size_t i = 0; i < columns; i++) {
+                snprintf(buffer, sizeof(buffer), "%.6f", distribution(generator));
+
+                string1D += (string1D.empty() ? "" : ",") + std::string(buffer);
+                string2D += (i == 0 ? "" : ",") + std::string(buffer);
+            }
+
+            string2D += ";";
+        }
+    }
+};
+
+TEST_F(LUTParserBenchmark, LegacyVersusSinglePass1D) {
+    std::vector<double> legacy, parsed;
+    ASSERT_TRUE(legacyGet1DLUTelementsFromString(string1D, &legacy));
+    ASSERT_TRUE(Bilinear_interp::get1DLUTelementsFromString(string1D, &parsed));
+    ASSERT_EQ(legacy, parsed);
+
+    double legacy_ns = benchmark::time_ns_per_call([&](std::size_t) {
+        legacyGet1DLUTelementsFromString(string1D, &legacy);
+        benchmark::do_not_optimize(legacy.back());
+    }, iterations);
+
+    std::size_t allocationsBefore = benchmark::allocation_count();
+    double parsed_ns = benchmark::time_ns_per_call([&](std::size_t) {
+        Bilinear_interp::get1DLUTelementsFromString(string1D, &parsed);
+        benchmark::do_not_optimize(parsed.back());
+    }, iterations);
+    double allocations = double(benchmark::allocation_count() - allocationsBefore) / iterations;
+
+    benchmark::report("1D LUT string, 10k elements, legacy", legacy_ns / 1000.0, "us/parse");
+    benchmark::report("1D LUT string, 10k elements, single pass", parsed_ns / 1000.0, "us/parse");
+    benchmark::report("1D LUT string, single pass allocations", allocations, "allocs/parse");
+
+    // Only the output vector itself.
+    EXPECT_EQ(allocations, 1.0);
+}
+
+TEST_F(LUTParserBenchmark, LegacyVersusSinglePass2D) {
+    std::vector<std::vector<double>> legacy, parsed;
+    ASSERT_TRUE(legacyGet2DLUTelementsFromString(string2D, &legacy));
+    ASSERT_TRUE(Bilinear_interp::get2DLUTelementsFromString(string2D, &parsed));
+    ASSERT_EQ(legacy, parsed);
+
+    double legacy_ns = benchmark::time_ns_per_call([&](std::size_t) {
+        legacyGet2DLUTelementsFromString(string2D, &legacy);
+        benchmark::do_not_optimize(legacy.back().back());
+    }, iterations);
+
+    std::size_t allocationsBefore = benchmark::allocation_count();
+    double parsed_ns = benchmark::time_ns_per_call([&](std::size_t) {
+        Bilinear_interp::get2DLUTelementsFromString(string2D, &parsed);
+        benchmark::do_not_optimize(parsed.back().back());
+    }, iterations);
+    double allocations = double(benchmark::allocation_count() - allocationsBefore) / iterations;
+
+    benchmark::report("2D LUT string, 100 x 100 elements, legacy", legacy_ns / 1000.0, "us/parse");
+    benchmark::report("2D LUT string, 100 x 100 elements, single pass", parsed_ns / 1000.0, "us/parse");
+    benchmark::report("2D LUT string, single pass allocations", allocations, "allocs/parse");
+
+    // The vector of rows and one vector per row.
+    EXPECT_EQ(allocations, rows + 1.0);
+}
+
+TEST_F(LUTParserBenchmark, StringVersusTableFile) {
+    // A 100 x 100 table with the same rows of x for every y.
+    std::string yString;
+
+    for (std::size_t j = 0; j < rows; j++) {
+        yString += (j == 0 ? "" : ",") + std::to_string(j);
+    }
+
+    std::string xString;
+
+    for (std::size_t j = 0; j < rows; j++) {
+        for (std::size_t i = 0; i < columns; i++) {
+            xString += (i == 0 ? "" : ",") + std::to_string(i);
+        }
+
+        xString += ";";
+    }
+
+    std::string path = ::testing::TempDir() + "LUTParserBenchmark.lut";
+    ASSERT_TRUE(TableFile::writeFromStrings(path, {{"x", xString}, {"y", yString}, {"z", string2D}}));
+
+    double string_ns = benchmark::time_ns_per_call([&](std::size_t) {
+        Bilinear_interp interp;
+        interp.setXVals(xString);
+        interp.setYVals(yString);
+        interp.setZVals(string2D);
+        benchmark::do_not_optimize(interp.viewZ()[0][0]);
+    }, iterations);
+
+    double file_ns = benchmark::time_ns_per_call([&](std::size_t) {
+        Bilinear_interp interp;
+        interp.setTableFile(TableFile::open(path));
+        benchmark::do_not_optimize(interp.viewZ()[0][0]);
+    }, iterations);
+
+    std::remove(path.c_str());
+
+    benchmark::report("Bilinear_interp load, 100 x 100, strings", string_ns / 1000.0, "us/load");
+    benchmark::report("Bilinear_interp load, 100 x 100, table file", file_ns / 1000.0, "us/load");
+}
+
+}  // namespace avionics_sim
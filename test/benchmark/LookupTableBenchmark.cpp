@@ -0,0 +1,213 @@
+/**
+ * @copyright   Copyright (c) 2021, Swift Engineering Inc.
+ * @license     Licensed under the MIT license. See LICENSE for details.
+ */
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "Airfoil.hpp"
+#include "BenchmarkUtils.hpp"
+#include "LookupTable.hpp"
+#include "Math_util.hpp"
+
+namespace avionics_sim {
+
+class LookupTableBenchmark : public ::testing::Test {
+  protected:
+    static const std::size_t iterations = 1000000;
+
+    std::vector<double> alpha_deg;
+    std::vector<double> cl;
+    std::vector<double> cd;
+    std::vector<double> queries_deg;
+
+    virtual void SetUp() {
+        for (int i = -180; i <= 180; i++) {
+            alpha_deg.push_back(i);
+            cl.push_back(sin(2.0 * DEG2RAD(i)));
+            cd.push_back(1.0 - cos(2.0 * DEG2RAD(i)) + 0.01);
+        }
+
+        // Slowly varying angle of attack, as seen from a simulation loop.
+        for (std::size_t i = 0; i < 1024; i++) {
+            queries_deg.push_back(170.0 * sin(i * 2.0 * M_PI / 1024.0));
+        }
+    }
+};
+
+TEST_F(LookupTableBenchmark, LookupByNameVersusHandle) {
+    LookupTable table({"alpha", "CL"}, {alpha_deg, cl});
+    LookupTable::ColumnHandle alphaColumn = table.resolveColumn("alpha");
+    LookupTable::ColumnHandle clColumn = table.resolveColumn("CL");
+
+    std::size_t allocationsBefore = benchmark::allocation_count();
+    double byName_ns = benchmark::time_ns_per_call([&](std::size_t i) {
+        benchmark::do_not_optimize(table.lookup(queries_deg[i % queries_deg.size()], "alpha", "CL"));
+    }, iterations);
+    double byNameAllocations = double(benchmark::allocation_count() - allocationsBefore) / iterations;
+
+    allocationsBefore = benchmark::allocation_count();
+    double byHandle_ns = benchmark::time_ns_per_call([&](std::size_t i) {
+        benchmark::do_not_optimize(table.lookup(queries_deg[i % queries_deg.size()], alphaColumn, clColumn));
+    }, iterations);
+    double byHandleAllocations = double(benchmark::allocation_count() - allocationsBefore) / iterations;
+
+    benchmark::report("lookup by name", byName_ns, "ns/call");
+    benchmark::report("lookup by name allocations", byNameAllocations, "allocs/call");
+    benchmark::report("lookup by handle", byHandle_ns, "ns/call");
+    benchmark::report("lookup by handle allocations", byHandleAllocations, "allocs/call");
+
+    EXPECT_EQ(byHandleAllocations, 0.0);
+}
+
+TEST_F(LookupTableBenchmark, SeparateVersusFusedLookup) {
+    LookupTable table({"alpha", "CL", "CD"}, {alpha_deg, cl, cd});
+    LookupTable::ColumnHandle alphaColumn = table.resolveColumn("alpha");
+    LookupTable::ColumnHandle coefficientColumns[] = {table.resolveColumn("CL"), table.resolveColumn("CD")};
+
+    double separate_ns = benchmark::time_ns_per_call([&](std::size_t i) {
+        double alpha = queries_deg[i % queries_deg.size()];
+        benchmark::do_not_optimize(table.lookup(alpha, alphaColumn, coefficientColumns[0]));
+        benchmark::do_not_optimize(table.lookup(alpha, alphaColumn, coefficientColumns[1]));
+    }, iterations);
+
+    double fused_ns = benchmark::time_ns_per_call([&](std::size_t i) {
+        double coefficients[2];
+        table.lookup(queries_deg[i % queries_deg.size()], alphaColumn, coefficientColumns, 2, coefficients);
+        benchmark::do_not_optimize(coefficients[0]);
+        benchmark::do_not_optimize(coefficients[1]);
+    }, iterations);
+
+    benchmark::report("CL and CD, separate lookups", separate_ns, "ns/call");
+    benchmark::report("CL and CD, fused lookup", fused_ns, "ns/call");
+}
+
+TEST_F(LookupTableBenchmark, WeightsVersusPrecomputedSlopes) {
+    // Unevenly spaced, so that the search is the same for both and the division is the difference.
+    std::vector<double> alpha, cl, cd;
+
+    for (std::size_t i = 0; i < alpha_deg.size(); i++) {
+        double t = alpha_deg[i] / 180.0;
+        alpha.push_back(180.0 * t * t * t);
+        cl.push_back(sin(2.0 * DEG2RAD(alpha.back())));
+        cd.push_back(1.0 - cos(2.0 * DEG2RAD(alpha.back())) + 0.01);
+    }
+
+    LookupTable table({"alpha", "CL", "CD"}, {alpha, cl, cd});
+    LookupTable::ColumnHandle alphaColumn = table.resolveColumn("alpha");
+    LookupTable::ColumnHandle coefficientColumns[] = {table.resolveColumn("CL"), table.resolveColumn("CD")};
+
+    LookupTable slopes = table;
+    slopes.precomputeSlopes(alphaColumn);
+
+    Bilinear_interp::Cursor cursor;
+    double weights_ns = benchmark::time_ns_per_call([&](std::size_t i) {
+        double coefficients[2];
+        table.lookup(queries_deg[i % queries_deg.size()], alphaColumn, coefficientColumns, 2, coefficients, &cursor);
+        benchmark::do_not_optimize(coefficients[0]);
+        benchmark::do_not_optimize(coefficients[1]);
+    }, iterations);
+
+    double slopes_ns = benchmark::time_ns_per_call([&](std::size_t i) {
+        double coefficients[2];
+        slopes.lookup(queries_deg[i % queries_deg.size()], alphaColumn, coefficientColumns, 2, coefficients, &cursor);
+        benchmark::do_not_optimize(coefficients[0]);
+        benchmark::do_not_optimize(coefficients[1]);
+    }, iterations);
+
+    benchmark::report("CL and CD, fused lookup, weights", weights_ns, "ns/call");
+    benchmark::report("CL and CD, fused lookup, precomputed slopes", slopes_ns, "ns/call");
+}
+
+TEST_F(LookupTableBenchmark, DenseLinearVersusSparseCubic) {
+    // The same curves every 5 degrees rather than every degree.
+    std::vector<double> sparseAlpha, sparseCl, sparseCd;
+
+    for (std::size_t i = 0; i < alpha_deg.size(); i += 5) {
+        sparseAlpha.push_back(alpha_deg[i]);
+        sparseCl.push_back(cl[i]);
+        sparseCd.push_back(cd[i]);
+    }
+
+    LookupTable dense({"alpha", "CL", "CD"}, {alpha_deg, cl, cd});
+    LookupTable sparse({"alpha", "CL", "CD"}, {sparseAlpha, sparseCl, sparseCd});
+    LookupTable::ColumnHandle alphaColumn = dense.resolveColumn("alpha");
+    LookupTable::ColumnHandle coefficientColumns[] = {dense.resolveColumn("CL"), dense.resolveColumn("CD")};
+    sparse.precomputeMonotoneCubic(alphaColumn);
+
+    double denseError = 0.0, sparseError = 0.0;
+
+    for (double alpha = -180.0; alpha <= 180.0; alpha += 0.01) {
+        double expected = sin(2.0 * DEG2RAD(alpha));
+        denseError = std::max(denseError,
+                              std::fabs(dense.lookup(alpha, alphaColumn, coefficientColumns[0]) - expected));
+        sparseError = std::max(sparseError,
+                               std::fabs(sparse.lookup(alpha, alphaColumn, coefficientColumns[0]) - expected));
+    }
+
+    Bilinear_interp::Cursor cursor;
+    double dense_ns = benchmark::time_ns_per_call([&](std::size_t i) {
+        double coefficients[2];
+        dense.lookup(queries_deg[i % queries_deg.size()], alphaColumn, coefficientColumns, 2, coefficients, &cursor);
+        benchmark::do_not_optimize(coefficients[0]);
+        benchmark::do_not_optimize(coefficients[1]);
+    }, iterations);
+
+    cursor = Bilinear_interp::Cursor();
+    double sparse_ns = benchmark::time_ns_per_call([&](std::size_t i) {
+        double coefficients[2];
+        sparse.lookup(queries_deg[i % queries_deg.size()], alphaColumn, coefficientColumns, 2, coefficients, &cursor);
+        benchmark::do_not_optimize(coefficients[0]);
+        benchmark::do_not_optimize(coefficients[1]);
+    }, iterations);
+
+    benchmark::report("CL and CD, 361 breakpoints, linear", dense_ns, "ns/call");
+    benchmark::report("CL and CD, 73 breakpoints, monotone cubic", sparse_ns, "ns/call");
+    benchmark::report("CL error, 361 breakpoints, linear", denseError * 1e6, "1e-6 max");
+    benchmark::report("CL error, 73 breakpoints, monotone cubic", sparseError * 1e6, "1e-6 max");
+}
+
+TEST_F(LookupTableBenchmark, LookupTableVersusFixed) {
+    // Filled at run time here, but laid out and searched as a constexpr table would be.
+    static AirfoilTable<361> polar;
+    ASSERT_EQ(alpha_deg.size(), 361);
+
+    for (std::size_t i = 0; i < alpha_deg.size(); i++) {
+        polar.columns[0][i] = alpha_deg[i];
+        polar.columns[1][i] = cl[i];
+        polar.columns[2][i] = cd[i];
+    }
+
+    Airfoil vectors(1.0, 0.1, alpha_deg, cl, cd);
+    Airfoil fixed(1.0, 0.1, polar);
+
+    double vectors_ns = benchmark::time_ns_per_call([&](std::size_t i) {
+        AeroCoefficients coefficients = vectors.calculateCoefficients(queries_deg[i % queries_deg.size()]);
+        benchmark::do_not_optimize(coefficients.lift);
+        benchmark::do_not_optimize(coefficients.drag);
+    }, iterations);
+
+    double fixed_ns = benchmark::time_ns_per_call([&](std::size_t i) {
+        AeroCoefficients coefficients = fixed.calculateCoefficients(queries_deg[i % queries_deg.size()]);
+        benchmark::do_not_optimize(coefficients.lift);
+        benchmark::do_not_optimize(coefficients.drag);
+    }, iterations);
+
+    const std::size_t columns[] = {1, 2};
+    double table_ns = benchmark::time_ns_per_call([&](std::size_t i) {
+        double coefficients[2];
+        polar.lookup(queries_deg[i % queries_deg.size()], 0, columns, 2, coefficients);
+        benchmark::do_not_optimize(coefficients[0]);
+        benchmark::do_not_optimize(coefficients[1]);
+    }, iterations);
+
+    benchmark::report("Airfoil coefficients, LookupTable", vectors_ns, "ns/call");
+    benchmark::report("Airfoil coefficients, AirfoilTable<361>", fixed_ns, "ns/call");
+    benchmark::report("AirfoilTable<361> fused lookup, inlined", table_ns, "ns/call");
+}
+
+}  // namespace avionics_sim
@@ -0,0 +1,242 @@
+/**
+ * @copyright   Copyright (c) 2021, Swift Engineering Inc.
+ * @license     Licensed under the MIT license. See LICENSE for details.
+ */
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+#include <ignition/math/Matrix3.hh>
+#include <ignition/math/Pose3.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "AerodynamicModel.hpp"
+#include "AerodynamicModelT.hpp"
+#include "Coordinate_Utils.hpp"
+
+namespace {
+
+// Polar of the tail surfaces.
+constexpr avionics_sim::AirfoilTable<5> tailPolar = {{
+        {-180.0, -15.0, 0.0, 15.0, 180.0},
+        {0.0, -0.9, 0.0, 0.9, 0.0},
+        {0.05, 0.3, 0.02, 0.3, 0.05}
+    }
+};
+
+// Environment whose air density is called with no virtual dispatch.
+class SeaLevelEnvironment final : public avionics_sim::IPhysicsEnvironment {
+  public:
+    double get_air_density_kg_per_m3() override {
+        return 1.22;
+    }
+};
+
+// Environment known only by its air density, implementing no interface.
+struct DenseEnvironment {
+    double get_air_density_kg_per_m3() const {
+        return 1.22;
+    }
+};
+
+// Environment counting the queries of its air density.
+class CountingEnvironment : public avionics_sim::IPhysicsEnvironment {
+  public:
+    int queries = 0;
+
+    virtual double get_air_density_kg_per_m3() {
+        queries++;
+        return 1.22;
+    }
+};
+
+}  // namespace
+
+namespace avionics_sim {
+
+class AerodynamicModelTTest : public ::testing::Test {
+  protected:
+    SeaLevelEnvironment environment_;
+    DenseEnvironment denseEnvironment_;
+
+    AerodynamicModel model_ = AerodynamicModel(Airfoil(0.25, 0.05, tailPolar), environment_);
+    AerodynamicModelT<SeaLevelEnvironment, FixedAirfoil<5>> fixedModel_ =
+        AerodynamicModelT<SeaLevelEnvironment, FixedAirfoil<5>>(FixedAirfoil<5>(0.25, 0.05, tailPolar), environment_);
+    AerodynamicModelT<const DenseEnvironment, Airfoil> denseModel_ =
+        AerodynamicModelT<const DenseEnvironment, Airfoil>(Airfoil(0.25, 0.05, tailPolar), denseEnvironment_);
+
+    virtual void SetUp() {
+        ignition::math::Vector3d forward(0.3, 0, 1);
+        ignition::math::Vector3d upward(-1, 0, 0.3);
+
+        model_.setBasisVectors(forward, upward);
+        fixedModel_.setBasisVectors(forward, upward);
+        denseModel_.setBasisVectors(forward, upward);
+    }
+};
+
+TEST_F(AerodynamicModelTTest, MatchesAerodynamicModel) {
+    // Given: Poses all around, with prop wash dominating and reversed flow along the way
+    std::mt19937 generator(3);
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+    std::uniform_real_distribution<double> speed(-30.0, 30.0);
+    IAerodynamicModel &adapter = model_;
+
+    for (int i = 0; i < 1000; i++) {
+        ignition::math::Pose3d poseInWorld_m_rad(0, 0, 0, angle(generator), angle(generator), angle(generator));
+        ignition::math::Vector3d velocityInWorld_m_per_s(speed(generator), speed(generator), speed(generator));
+        double propWash_m_per_s = i % 3 == 0 ? 10.0 : 0.0;
+        double controlAngle_rad = i % 2 == 0 ? 0.2 : 0.0;
+
+        ignition::math::Matrix3d worldToBody;
+        Coordinate_Utils::project_rotation_global(poseInWorld_m_rad, &worldToBody);
+
+        // When: Forces are calculated by the adapter, and by the templates directly
+        ignition::math::Vector3d expected_N = adapter.updateForcesInBody_N(poseInWorld_m_rad,
+                                              velocityInWorld_m_per_s, propWash_m_per_s, controlAngle_rad);
+        ignition::math::Vector3d fixed_N = fixedModel_.updateForcesInBody_N(poseInWorld_m_rad,
+                                           velocityInWorld_m_per_s, propWash_m_per_s, controlAngle_rad);
+        ignition::math::Vector3d dense_N = denseModel_.updateForcesInBody_N(poseInWorld_m_rad,
+                                           velocityInWorld_m_per_s, propWash_m_per_s, controlAngle_rad);
+        ignition::math::Vector3d rotation_N = fixedModel_.updateForcesInBody_N(worldToBody,
+                                              velocityInWorld_m_per_s, propWash_m_per_s, controlAngle_rad);
+
+        // Then: Forces should be exactly the same
+        ASSERT_EQ(std::memcmp(&fixed_N, &expected_N, sizeof(expected_N)), 0) << "element " << i;
+        ASSERT_EQ(std::memcmp(&dense_N, &expected_N, sizeof(expected_N)), 0) << "element " << i;
+        ASSERT_EQ(std::memcmp(&rotation_N, &expected_N, sizeof(expected_N)), 0) << "element " << i;
+    }
+
+    // And so should the state of the last update
+    ASSERT_EQ(double(denseModel_.getState().angleOfAttack_deg), double(model_.getState().angleOfAttack_deg));
+    ASSERT_EQ(double(denseModel_.getState().liftCoeff), double(model_.getState().liftCoeff));
+}
+
+TEST_F(AerodynamicModelTTest, BatchMatchesAerodynamicModel) {
+    // Given: A batch of poses and velocities
+    std::mt19937 generator(4);
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+    std::uniform_real_distribution<double> speed(-30.0, 30.0);
+
+    std::vector<ignition::math::Pose3d> poses;
+    std::vector<ignition::math::Vector3d> velocities;
+    std::vector<double> propWashes, controlAngles;
+
+    for (int i = 0; i < 64; i++) {
+        poses.push_back(ignition::math::Pose3d(0, 0, 0, angle(generator), angle(generator), angle(generator)));
+        velocities.push_back(ignition::math::Vector3d(speed(generator), speed(generator), speed(generator)));
+        propWashes.push_back(i % 4 == 0 ? 12.0 : 0.0);
+        controlAngles.push_back(0.1);
+    }
+
+    std::vector<ignition::math::Vector3d> expected(poses.size()), forces(poses.size());
+
+    // When: The batch is updated by the adapter and by the template
+    model_.updateForcesInBody_N(poses.data(), velocities.data(), propWashes.data(), controlAngles.data(),
+                                poses.size(), expected.data());
+    fixedModel_.updateForcesInBody_N(poses.data(), velocities.data(), propWashes.data(), controlAngles.data(),
+                                     poses.size(), forces.data());
+
+    // Then: Forces should be exactly the same
+    ASSERT_EQ(std::memcmp(forces.data(), expected.data(), expected.size() * sizeof(expected[0])), 0);
+}
+
+TEST_F(AerodynamicModelTTest, SnapshotMatchesEnvironment) {
+    // Given: A model whose environment is never to be queried, and a snapshot of the same air
+    CountingEnvironment counting;
+    AerodynamicModel model(Airfoil(0.25, 0.05, tailPolar), counting);
+    model.setBasisVectors(ignition::math::Vector3d(0.3, 0, 1), ignition::math::Vector3d(-1, 0, 0.3));
+
+    EnvironmentSnapshot snapshot = environment_.get_snapshot();
+
+    std::mt19937 generator(6);
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+    std::uniform_real_distribution<double> speed(-30.0, 30.0);
+
+    for (int i = 0; i < 200; i++) {
+        ignition::math::Pose3d poseInWorld_m_rad(0, 0, 0, angle(generator), angle(generator), angle(generator));
+        ignition::math::Vector3d velocityInWorld_m_per_s(speed(generator), speed(generator), speed(generator));
+
+        ignition::math::Matrix3d worldToBody;
+        Coordinate_Utils::project_rotation_global(poseInWorld_m_rad, &worldToBody);
+
+        // When: Forces are calculated in the air of the snapshot, and of the environment
+        ignition::math::Vector3d fromPose_N = model.updateForcesInBody_N(snapshot, poseInWorld_m_rad,
+                                              velocityInWorld_m_per_s, 0.0, 0.1);
+        ignition::math::Vector3d fromRotation_N = model.updateForcesInBody_N(snapshot, worldToBody,
+                velocityInWorld_m_per_s, 0.0, 0.1);
+        ignition::math::Vector3d expected_N = model_.updateForcesInBody_N(poseInWorld_m_rad,
+                                              velocityInWorld_m_per_s, 0.0, 0.1);
+
+        // Then: Forces should be exactly the same
+        ASSERT_EQ(std::memcmp(&fromPose_N, &expected_N, sizeof(expected_N)), 0) << "element " << i;
+        ASSERT_EQ(std::memcmp(&fromRotation_N, &expected_N, sizeof(expected_N)), 0) << "element " << i;
+    }
+
+    ASSERT_EQ(model.calculateDynamicPressure_Pa(12.0, snapshot), model_.calculateDynamicPressure_Pa(12.0));
+
+    // And the environment should never have been queried
+    ASSERT_EQ(counting.queries, 0);
+}
+
+TEST_F(AerodynamicModelTTest, WrenchMatchesAerodynamicModel) {
+    // Given: Models of the same polar, with the same center of pressure
+    std::mt19937 generator(8);
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+    std::uniform_real_distribution<double> speed(-30.0, 30.0);
+    ignition::math::Vector3d centerOfPressure_m(-1.5, 0.6, 0.0);
+
+    model_.setCenterOfPressure(centerOfPressure_m);
+    fixedModel_.setCenterOfPressure(centerOfPressure_m);
+    denseModel_.setCenterOfPressure(centerOfPressure_m);
+
+    ASSERT_EQ(fixedModel_.getCenterOfPressure(), centerOfPressure_m);
+
+    for (int i = 0; i < 200; i++) {
+        ignition::math::Pose3d poseInWorld_m_rad(0, 0, 0, angle(generator), angle(generator), angle(generator));
+        ignition::math::Vector3d velocityInWorld_m_per_s(speed(generator), speed(generator), speed(generator));
+
+        // When: Wrenches are calculated by the adapter, and by the templates directly
+        AeroWrench expected = model_.updateWrenchInBody(poseInWorld_m_rad, velocityInWorld_m_per_s, 0.0, 0.1);
+        AeroWrench fixed = fixedModel_.updateWrenchInBody(poseInWorld_m_rad, velocityInWorld_m_per_s, 0.0, 0.1);
+        AeroWrench dense = denseModel_.updateWrenchInBody(poseInWorld_m_rad, velocityInWorld_m_per_s, 0.0, 0.1);
+
+        // Then: They should be exactly the same, of the forces alone as neither polar has a pitching moment
+        ASSERT_EQ(std::memcmp(&fixed, &expected, sizeof(expected)), 0) << "element " << i;
+        ASSERT_EQ(std::memcmp(&dense, &expected, sizeof(expected)), 0) << "element " << i;
+        ASSERT_EQ(expected.moment_N_m, centerOfPressure_m.Cross(expected.force_N)) << "element " << i;
+    }
+}
+
+TEST_F(AerodynamicModelTTest, FixedAirfoilMatchesAirfoil) {
+    // Given: An airfoil and a fixed airfoil of the same polar
+    Airfoil airfoil(0.25, 0.05, tailPolar);
+    FixedAirfoil<5> fixedAirfoil(0.25, 0.05, tailPolar);
+
+    ASSERT_EQ(fixedAirfoil.getArea_m2(), airfoil.getArea_m2());
+    ASSERT_EQ(fixedAirfoil.getLateralArea_m2(), airfoil.getLateralArea_m2());
+
+    // When: Coefficients are looked up on, off and between the breakpoints
+    for (double angleOfAttack_deg = -200.0; angleOfAttack_deg <= 200.0; angleOfAttack_deg += 0.75) {
+        AeroCoefficients expected = airfoil.calculateCoefficients(angleOfAttack_deg);
+        AeroCoefficients coefficients = fixedAirfoil.calculateCoefficients(angleOfAttack_deg);
+
+        // Then: They should be exactly the same
+        ASSERT_EQ(coefficients.lift, expected.lift) << "angle " << angleOfAttack_deg;
+        ASSERT_EQ(coefficients.drag, expected.drag) << "angle " << angleOfAttack_deg;
+        ASSERT_EQ(fixedAirfoil.calculateSideSlipCoefficient(angleOfAttack_deg),
+                  airfoil.calculateSideSlipCoefficient(angleOfAttack_deg));
+    }
+
+    // And so should the counts of the lookups
+    ASSERT_EQ(fixedAirfoil.getTelemetry().hits, airfoil.getTelemetry().hits);
+    ASSERT_EQ(fixedAirfoil.getTelemetry().lowClamps, airfoil.getTelemetry().lowClamps);
+    ASSERT_EQ(fixedAirfoil.getTelemetry().highClamps, airfoil.getTelemetry().highClamps);
+
+    fixedAirfoil.resetTelemetry();
+    ASSERT_EQ(fixedAirfoil.getTelemetry().hits, 0u);
+}
+
+}  // namespace avionics_sim
@@ -0,0 +1,197 @@
+/**
+ * @copyright   Copyright (c) 2021, Swift Engineering Inc.
+ * @license     Licensed under the MIT license. See LICENSE for details.
+ */
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+#include <ignition/math/Pose3.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "AerodynamicModel.hpp"
+#include "AerodynamicSurfaceSet.hpp"
+
+namespace {
+
+// Polar of the tail surfaces.
+constexpr avionics_sim::AirfoilTable<5> tailPolar = {{
+        {-180.0, -15.0, 0.0, 15.0, 180.0},
+        {0.0, -0.9, 0.0, 0.9, 0.0},
+        {0.05, 0.3, 0.02, 0.3, 0.05}
+    }
+};
+
+}  // namespace
+
+namespace avionics_sim {
+
+class AerodynamicSurfaceSetTest : public ::testing::Test, IPhysicsEnvironment {
+  public:
+    virtual double get_air_density_kg_per_m3() {
+        return 1.22;
+    }
+
+  protected:
+    std::vector<AerodynamicModel> models_;
+    AerodynamicSurfaceSet set_ = AerodynamicSurfaceSet(*this);
+
+    void addSurface(Airfoil airfoil, ignition::math::Vector3d forward, ignition::math::Vector3d upward) {
+        models_.push_back(AerodynamicModel(airfoil, *this));
+        models_.back().setBasisVectors(forward, upward);
+        set_.addSurface(airfoil, forward, upward);
+    }
+
+    virtual void SetUp() {
+        std::vector<double> alpha_deg, cl, cd;
+
+        for (int i = -180; i <= 180; i += 5) {
+            alpha_deg.push_back(i);
+            cl.push_back(sin(2.0 * DEG2RAD(i)));
+            cd.push_back(1.0 - cos(2.0 * DEG2RAD(i)) + 0.01);
+        }
+
+        Airfoil wing(1.0, 0.1, alpha_deg, cl, cd);
+        Airfoil tail(0.25, 0.05, tailPolar);
+
+        // Wings, tails, a fin, and basis vectors with NaNs in them, of a 12 surface VTOL.
+        for (int i = 0; i < 4; i++) {
+            addSurface(wing, ignition::math::Vector3d(0, 0, 1), ignition::math::Vector3d(-1, 0, 0));
+        }
+
+        addSurface(wing, ignition::math::Vector3d(1, 0, 0), ignition::math::Vector3d(0, 0, 1));
+        addSurface(wing, ignition::math::Vector3d(0, 0.6, 0.8), ignition::math::Vector3d(-1, 0, 0));
+        addSurface(tail, ignition::math::Vector3d(0, 0, 1), ignition::math::Vector3d(-1, 0, 0));
+        addSurface(tail, ignition::math::Vector3d(0, 0, 1), ignition::math::Vector3d(0, 1, 0));
+        addSurface(tail, ignition::math::Vector3d(0, 0, 1), ignition::math::Vector3d(-1, NAN, 0));
+        addSurface(tail, ignition::math::Vector3d(INFINITY, 0, 1), ignition::math::Vector3d(-1, 0, 0));
+        addSurface(wing, ignition::math::Vector3d(0, 0, 0), ignition::math::Vector3d(0, 0, 0));
+        addSurface(tail, ignition::math::Vector3d(0.3, 0, 1), ignition::math::Vector3d(-1, 0, 0.3));
+    }
+};
+
+TEST_F(AerodynamicSurfaceSetTest, MatchesAerodynamicModels) {
+    ASSERT_EQ(set_.size(), models_.size());
+
+    const std::size_t count = models_.size();
+    std::mt19937 generator(7);
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+    std::uniform_real_distribution<double> speed(-30.0, 30.0);
+    std::uniform_real_distribution<double> wash(0.0, 25.0);
+    std::uniform_real_distribution<double> control(-0.5, 0.5);
+
+    std::vector<ignition::math::Pose3d> poses(count);
+    std::vector<ignition::math::Vector3d> velocities(count);
+    std::vector<double> propWashes(count), controlAngles(count);
+    std::vector<ignition::math::Vector3d> forces(count);
+
+    for (int step = 0; step < 2000; step++) {
+        for (std::size_t i = 0; i < count; i++) {
+            poses[i] = ignition::math::Pose3d(0, 0, 0, angle(generator), angle(generator), angle(generator));
+            velocities[i] = ignition::math::Vector3d(speed(generator), speed(generator), speed(generator));
+
+            // Prop wash dominating, still air, and hover along the way.
+            propWashes[i] = step % 3 == 0 ? wash(generator) : 0.0;
+            controlAngles[i] = step % 2 == 0 ? control(generator) : 0.0;
+
+            if (step % 7 == 0 && i % 2 == 0) {
+                velocities[i] = ignition::math::Vector3d(0, 0, 0);
+            }
+        }
+
+        set_.updateForcesInBody_N(poses.data(), velocities.data(), propWashes.data(), controlAngles.data(),
+                                  forces.data());
+
+        for (std::size_t i = 0; i < count; i++) {
+            ignition::math::Vector3d expected = models_[i].updateForcesInBody_N(poses[i], velocities[i],
+                                                propWashes[i], controlAngles[i]);
+
+            for (int axis = 0; axis < 3; axis++) {
+                if (std::isnan(expected[axis])) {
+                    ASSERT_TRUE(std::isnan(forces[i][axis])) << "step " << step << ", surface " << i;
+                } else {
+                    ASSERT_EQ(forces[i][axis], expected[axis]) << "step " << step << ", surface " << i;
+                }
+            }
+        }
+    }
+
+    EXPECT_EQ(set_.getAirfoil(0).getArea_m2(), 1.0);
+    EXPECT_EQ(set_.getAirfoil(6).getArea_m2(), 0.25);
+}
+
+TEST_F(AerodynamicSurfaceSetTest, FastAngleMathMatchesAerodynamicModels) {
+    // Given: The set and the models taking their angles with the fast approximations
+    set_.setAngleMath(AerodynamicModelOptions::ANGLE_MATH_FAST);
+    ASSERT_EQ(set_.getAngleMath(), AerodynamicModelOptions::ANGLE_MATH_FAST);
+
+    for (std::size_t i = 0; i < models_.size(); i++) {
+        models_[i].setAngleMath(AerodynamicModel::ANGLE_MATH_FAST);
+    }
+
+    const std::size_t count = models_.size();
+    std::mt19937 generator(9);
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+    std::uniform_real_distribution<double> speed(-30.0, 30.0);
+
+    std::vector<ignition::math::Pose3d> poses(count);
+    std::vector<ignition::math::Vector3d> velocities(count);
+    std::vector<double> propWashes(count, 0.0), controlAngles(count, -0.2);
+    std::vector<ignition::math::Vector3d> forces(count);
+
+    for (int step = 0; step < 200; step++) {
+        for (std::size_t i = 0; i < count; i++) {
+            poses[i] = ignition::math::Pose3d(0, 0, 0, angle(generator), angle(generator), angle(generator));
+            velocities[i] = ignition::math::Vector3d(speed(generator), speed(generator), speed(generator));
+        }
+
+        // When: The set is updated
+        set_.updateForcesInBody_N(poses.data(), velocities.data(), propWashes.data(), controlAngles.data(),
+                                  forces.data());
+
+        // Then: Each force should be exactly that of its model, surfaces of NaN basis vectors aside
+        for (std::size_t i = 0; i < count; i++) {
+            ignition::math::Vector3d expected = models_[i].updateForcesInBody_N(poses[i], velocities[i],
+                                                propWashes[i], controlAngles[i]);
+
+            for (int axis = 0; axis < 3; axis++) {
+                if (!std::isnan(expected[axis])) {
+                    ASSERT_EQ(forces[i][axis], expected[axis]) << "step " << step << ", surface " << i;
+                }
+            }
+        }
+    }
+}
+
+TEST_F(AerodynamicSurfaceSetTest, SnapshotMatchesEnvironment) {
+    const std::size_t count = models_.size();
+    std::mt19937 generator(8);
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+    std::uniform_real_distribution<double> speed(-30.0, 30.0);
+
+    std::vector<ignition::math::Pose3d> poses(count);
+    std::vector<ignition::math::Vector3d> velocities(count);
+    std::vector<double> propWashes(count, 0.0), controlAngles(count, 0.1);
+    std::vector<ignition::math::Vector3d> forces(count), expected(count);
+
+    EnvironmentSnapshot snapshot;
+    snapshot.airDensity_kg_per_m3 = get_air_density_kg_per_m3();
+
+    for (int step = 0; step < 200; step++) {
+        for (std::size_t i = 0; i < count; i++) {
+            poses[i] = ignition::math::Pose3d(0, 0, 0, angle(generator), angle(generator), angle(generator));
+            velocities[i] = ignition::math::Vector3d(speed(generator), speed(generator), speed(generator));
+        }
+
+        set_.updateForcesInBody_N(poses.data(), velocities.data(), propWashes.data(), controlAngles.data(),
+                                  expected.data());
+        set_.updateForcesInBody_N(snapshot, poses.data(), velocities.data(), propWashes.data(),
+                                  controlAngles.data(), forces.data());
+
+        ASSERT_EQ(std::memcmp(forces.data(), expected.data(), count * sizeof(expected[0])), 0) << "step " << step;
+    }
+}
+
+}  // namespace avionics_sim
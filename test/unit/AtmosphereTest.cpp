@@ -5,8 +5,12 @@
  * @license     Licensed under the MIT license. See LICENSE for details.
  */
 
+#include "AtmosphereEnvironment.hpp"
 #include "US_1976_atmosphere.hpp"
 
+#include <cmath>
+#include <stdexcept>
+
 #include "gtest/gtest.h"
 
 namespace avionics_sim {
@@ -155,4 +159,59 @@ TEST(US_1976_atmosphere_UnitTest, get_mass_density) {
     EXPECT_NEAR(US_1976_atmosphere::get_mass_density_kg_per_m3(84500.0), 7.3914e-6, 6.0 * 0.0001e-6);
 }
 
+TEST(US_1976_atmosphere_UnitTest, get_speed_of_sound) {
+    // test the common points in geo potential height, sig figs from NASA table
+    EXPECT_NEAR(US_1976_atmosphere::get_speed_of_sound_m_per_s(0.0),  340.29,  0.01);
+    EXPECT_NEAR(US_1976_atmosphere::get_speed_of_sound_m_per_s(11000.0),  295.07,  0.01);
+    EXPECT_NEAR(US_1976_atmosphere::get_speed_of_sound_m_per_s(20000.0),  295.07,  0.01);
+    EXPECT_NEAR(US_1976_atmosphere::get_speed_of_sound_m_per_s(32000.0),  303.13,  0.01);
+    EXPECT_NEAR(US_1976_atmosphere::get_speed_of_sound_m_per_s(47000.0),  329.80,  0.01);
+}
+
+TEST(US_1976_atmosphere_UnitTest, get_snapshot) {
+    // every layer, on and between their bases
+    for (double geopot_height = -5000.0; geopot_height <= 84500.0; geopot_height += 250.0) {
+        EnvironmentSnapshot snapshot = US_1976_atmosphere::get_snapshot(geopot_height);
+
+        EXPECT_EQ(snapshot.airDensity_kg_per_m3, US_1976_atmosphere::get_mass_density_kg_per_m3(geopot_height));
+        EXPECT_EQ(snapshot.staticPressure_Pa, US_1976_atmosphere::get_pressure_Pa(geopot_height));
+        EXPECT_EQ(snapshot.temperature_K, US_1976_atmosphere::get_temperature_K(geopot_height));
+        EXPECT_EQ(snapshot.speedOfSound_m_per_s, US_1976_atmosphere::get_speed_of_sound_m_per_s(geopot_height));
+    }
+
+    EXPECT_THROW(US_1976_atmosphere::get_snapshot(90000.0), std::domain_error);
+}
+
+TEST(AtmosphereEnvironment_UnitTest, get_snapshot) {
+    AtmosphereEnvironment environment(1500.0);
+    IPhysicsEnvironment &physicsEnvironment = environment;
+
+    EnvironmentSnapshot snapshot = physicsEnvironment.get_snapshot();
+    double geopot_height = Geopotential_height::get_geopot_height(1500.0);
+
+    EXPECT_EQ(snapshot.airDensity_kg_per_m3, physicsEnvironment.get_air_density_kg_per_m3());
+    EXPECT_EQ(snapshot.staticPressure_Pa, US_1976_atmosphere::get_pressure_Pa(geopot_height));
+    EXPECT_EQ(environment.get_geometric_height_m(), 1500.0);
+
+    environment.set_geometric_height_m(0.0);
+    EXPECT_NEAR(physicsEnvironment.get_snapshot().airDensity_kg_per_m3, 1.225, 0.001);
+}
+
+TEST(AtmosphereEnvironment_UnitTest, default_snapshot) {
+    // an environment telling only the air density
+    class DensityEnvironment : public IPhysicsEnvironment {
+      public:
+        virtual double get_air_density_kg_per_m3() {
+            return 1.1;
+        }
+    } environment;
+
+    EnvironmentSnapshot snapshot = environment.get_snapshot();
+
+    EXPECT_EQ(snapshot.airDensity_kg_per_m3, 1.1);
+    EXPECT_TRUE(std::isnan(snapshot.staticPressure_Pa));
+    EXPECT_TRUE(std::isnan(snapshot.temperature_K));
+    EXPECT_TRUE(std::isnan(snapshot.speedOfSound_m_per_s));
+}
+
 }  // namespace avionics_sim
@@ -5,7 +5,11 @@
 #include "Bilinear_interp.hpp"
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <iostream>
+#include <random>
 #include <vector>
 #include <string>
 
@@ -48,6 +52,771 @@ TEST_F(BilinearInterp_UnitTest, get1DLUTelementsFromString) {
     EXPECT_EQ(outVect[6], 70.0f);
 }
 
+TEST_F(BilinearInterp_UnitTest, findBracket) {
+    std::vector<double> xVals = {0.0, 10.0, 20.0, 40.0};
+    avionics_sim::Bilinear_interp::Bracket bracket;
+
+    // Interior point
+    EXPECT_EQ(avionics_sim::Bilinear_interp::findBracket(xVals, 25.0, &bracket),
+              avionics_sim::Bilinear_interp::INTERP_SUCCESS);
+    EXPECT_EQ(bracket.lower, 2);
+    EXPECT_EQ(bracket.upper, 3);
+    EXPECT_DOUBLE_EQ(bracket.weight, 0.25);
+
+    // On a breakpoint, bracketed from below
+    EXPECT_EQ(avionics_sim::Bilinear_interp::findBracket(xVals, 10.0, &bracket),
+              avionics_sim::Bilinear_interp::INTERP_SUCCESS);
+    EXPECT_EQ(bracket.lower, 0);
+    EXPECT_EQ(bracket.upper, 1);
+    EXPECT_DOUBLE_EQ(bracket.weight, 1.0);
+
+    // Clamped below and above
+    EXPECT_EQ(avionics_sim::Bilinear_interp::findBracket(xVals, -1.0, &bracket),
+              avionics_sim::Bilinear_interp::INTERP_WARN_OUT_OF_BOUNDS);
+    EXPECT_EQ(bracket.lower, 0);
+    EXPECT_EQ(bracket.upper, 0);
+
+    EXPECT_EQ(avionics_sim::Bilinear_interp::findBracket(xVals, 41.0, &bracket),
+              avionics_sim::Bilinear_interp::INTERP_WARN_OUT_OF_BOUNDS);
+    EXPECT_EQ(bracket.lower, 3);
+    EXPECT_EQ(bracket.upper, 3);
+
+    // The bracket interpolates any column sharing the breakpoints
+    std::vector<double> yVals = {1.0, 2.0, 4.0, 8.0};
+    avionics_sim::Bilinear_interp::findBracket(xVals, 25.0, &bracket);
+    EXPECT_DOUBLE_EQ(avionics_sim::Bilinear_interp::interpolateBracket(yVals, bracket), 5.0);
+}
+
+TEST_F(BilinearInterp_UnitTest, interpolateSinglePointTable) {
+    std::vector<double> xVals = {0.0};
+    std::vector<double> yVals = {3.0};
+    double y;
+
+    EXPECT_EQ(avionics_sim::Bilinear_interp::interpolate(xVals, yVals, 0.0, &y),
+              avionics_sim::Bilinear_interp::INTERP_SUCCESS);
+    EXPECT_EQ(y, 3.0);
+
+    EXPECT_EQ(avionics_sim::Bilinear_interp::interpolate(xVals, yVals, 1.0, &y),
+              avionics_sim::Bilinear_interp::INTERP_WARN_OUT_OF_BOUNDS);
+    EXPECT_EQ(y, 3.0);
+}
+
+TEST_F(BilinearInterp_UnitTest, detectUniformGrid) {
+    // Evenly spaced, including spacing that is not exactly representable
+    std::vector<double> uniform;
+
+    for (int i = 0; i <= 100; i++) {
+        uniform.push_back(-1.0 + i * 0.1);
+    }
+
+    avionics_sim::Bilinear_interp::UniformGrid grid = avionics_sim::Bilinear_interp::detectUniformGrid(uniform);
+    EXPECT_TRUE(grid.isUniform);
+    EXPECT_DOUBLE_EQ(grid.x0, -1.0);
+    EXPECT_NEAR(grid.invDx, 10.0, 1e-9);
+
+    // Uneven, repeated, descending and too short breakpoints are not uniform
+    EXPECT_FALSE(avionics_sim::Bilinear_interp::detectUniformGrid({0.0, 1.0, 3.0}).isUniform);
+    EXPECT_FALSE(avionics_sim::Bilinear_interp::detectUniformGrid({0.0, 1.0, 1.0, 2.0}).isUniform);
+    EXPECT_FALSE(avionics_sim::Bilinear_interp::detectUniformGrid({2.0, 1.0, 0.0}).isUniform);
+    EXPECT_FALSE(avionics_sim::Bilinear_interp::detectUniformGrid({1.0}).isUniform);
+}
+
+TEST_F(BilinearInterp_UnitTest, interpolateUniformGridMatchesSearch) {
+    std::vector<double> xVals, yVals;
+
+    for (int i = 0; i <= 50; i++) {
+        xVals.push_back(-25.0 + i * 0.7);
+        yVals.push_back(xVals.back() * xVals.back());
+    }
+
+    avionics_sim::Bilinear_interp::UniformGrid grid = avionics_sim::Bilinear_interp::detectUniformGrid(xVals);
+    ASSERT_TRUE(grid.isUniform);
+
+    // Queries between and beyond the breakpoints, and exactly on each of them
+    std::vector<double> queries(xVals);
+
+    for (double x = -27.0; x <= 13.0; x += 0.035) {
+        queries.push_back(x);
+    }
+
+    // Give identical results and result codes
+    for (double query : queries) {
+        double ySearch, yGrid;
+        avionics_sim::Bilinear_interp::InterpResult searchResult =
+            avionics_sim::Bilinear_interp::interpolate(xVals, yVals, query, &ySearch);
+        avionics_sim::Bilinear_interp::InterpResult gridResult =
+            avionics_sim::Bilinear_interp::interpolate(xVals, grid, yVals, query, &yGrid);
+
+        ASSERT_EQ(searchResult, gridResult) << "x = " << query;
+        ASSERT_EQ(ySearch, yGrid) << "x = " << query;
+    }
+}
+
+TEST_F(BilinearInterp_UnitTest, interpolate2DUniformGridMatchesSearch) {
+    std::vector<std::vector<double>> xVals, zVals;
+    std::vector<double> yVals;
+
+    for (int j = 0; j < 5; j++) {
+        yVals.push_back(j * 2.5);
+        xVals.push_back(std::vector<double>());
+        zVals.push_back(std::vector<double>());
+
+        for (int i = 0; i < 20; i++) {
+            xVals[j].push_back(i * (1.0 + j));
+            zVals[j].push_back(i * j + 0.5 * i);
+        }
+    }
+
+    avionics_sim::Bilinear_interp interp(xVals, yVals, zVals);
+
+    for (double y = -1.0; y <= 11.0; y += 0.25) {
+        for (double x = -1.0; x <= 100.0; x += 0.5) {
+            double zSearch, zGrid;
+            avionics_sim::Bilinear_interp::InterpResult searchResult =
+                interp.interpolate2D(xVals, yVals, zVals, x, y, &zSearch);
+            avionics_sim::Bilinear_interp::InterpResult gridResult = interp.interpolate2D(x, y, &zGrid);
+
+            ASSERT_EQ(searchResult, gridResult) << "x = " << x << ", y = " << y;
+            ASSERT_EQ(zSearch, zGrid) << "x = " << x << ", y = " << y;
+        }
+    }
+}
+
+TEST_F(BilinearInterp_UnitTest, interpolateCursorMatchesSearch) {
+    // Unevenly spaced, so that the cursor rather than the grid is used
+    std::vector<double> xVals, yVals;
+
+    for (int i = -40; i <= 40; i++) {
+        xVals.push_back(i * std::fabs(i) * 0.1);
+        yVals.push_back(std::sin(0.1 * i));
+    }
+
+    avionics_sim::Bilinear_interp::UniformGrid grid = avionics_sim::Bilinear_interp::detectUniformGrid(xVals);
+    ASSERT_FALSE(grid.isUniform);
+
+    // A slow sweep across the table and back, then jumps between its ends, past them and onto its breakpoints
+    std::vector<double> queries;
+
+    for (double x = -170.0; x <= 170.0; x += 0.3) {
+        queries.push_back(x);
+    }
+
+    for (double x = 170.0; x >= -170.0; x -= 0.7) {
+        queries.push_back(x);
+    }
+
+    for (int i = 0; i < 50; i++) {
+        queries.push_back((i % 2) ? 155.0 - i : -155.0 + i);
+    }
+
+    queries.insert(queries.end(), xVals.rbegin(), xVals.rend());
+
+    // Give identical results and result codes
+    avionics_sim::Bilinear_interp::Cursor cursor;
+
+    for (double query : queries) {
+        double ySearch, yCursor;
+        avionics_sim::Bilinear_interp::InterpResult searchResult =
+            avionics_sim::Bilinear_interp::interpolate(xVals, yVals, query, &ySearch);
+        avionics_sim::Bilinear_interp::InterpResult cursorResult =
+            avionics_sim::Bilinear_interp::interpolate(xVals, grid, yVals, query, &yCursor, &cursor);
+
+        ASSERT_EQ(searchResult, cursorResult) << "x = " << query;
+        ASSERT_EQ(ySearch, yCursor) << "x = " << query;
+    }
+
+    // A cursor left past the end of a shorter table is still safe to use
+    std::vector<double> shortX = {0.0, 1.0, 3.0};
+    std::vector<double> shortY = {0.0, 2.0, 6.0};
+    double y;
+    ASSERT_EQ(avionics_sim::Bilinear_interp::interpolate(shortX, grid, shortY, 0.5, &y, &cursor),
+              avionics_sim::Bilinear_interp::InterpResult::INTERP_SUCCESS);
+    ASSERT_EQ(y, 1.0);
+}
+
+TEST_F(BilinearInterp_UnitTest, viewsMatchCopies) {
+    std::vector<std::vector<double>> xVals, zVals, xCopy, zCopy;
+    std::vector<double> yVals, yCopy;
+
+    ASSERT_TRUE(avionics_sim::Bilinear_interp::get2DLUTelementsFromString(xValsString, &xVals));
+    ASSERT_TRUE(avionics_sim::Bilinear_interp::get1DLUTelementsFromString(yValsString, &yVals));
+    ASSERT_TRUE(avionics_sim::Bilinear_interp::get2DLUTelementsFromString(zValsString, &zVals));
+
+    avionics_sim::Bilinear_interp interp;
+
+    // Nothing to view before the values are set
+    ASSERT_TRUE(interp.viewX().empty());
+    ASSERT_TRUE(interp.viewY().empty());
+    ASSERT_TRUE(interp.viewZ().empty());
+
+    // Set z before x, so that storing x has to keep z
+    interp.setZVals(zVals);
+    interp.setYVals(yVals);
+    interp.setXVals(xVals);
+
+    ASSERT_TRUE(interp.getX(&xCopy));
+    ASSERT_TRUE(interp.getY(&yCopy));
+    ASSERT_TRUE(interp.getZ(&zCopy));
+    ASSERT_EQ(xCopy, xVals);
+    ASSERT_EQ(yCopy, yVals);
+    ASSERT_EQ(zCopy, zVals);
+
+    avionics_sim::Bilinear_interp::TableView xView = interp.viewX();
+    avionics_sim::Bilinear_interp::View yView = interp.viewY();
+    avionics_sim::Bilinear_interp::TableView zView = interp.viewZ();
+
+    ASSERT_EQ(xView.size(), xVals.size());
+    ASSERT_EQ(std::vector<double>(yView.begin(), yView.end()), yVals);
+    ASSERT_EQ(zView.size(), zVals.size());
+
+    for (std::size_t i = 0; i < xVals.size(); i++) {
+        ASSERT_EQ(std::vector<double>(xView[i].begin(), xView[i].end()), xVals[i]);
+        ASSERT_EQ(std::vector<double>(zView[i].begin(), zView[i].end()), zVals[i]);
+    }
+}
+
+TEST_F(BilinearInterp_UnitTest, interpolate2DRaggedRows) {
+    // Rows of different lengths and spacing
+    std::vector<std::vector<double>> xVals = {{0.0, 10.0}, {0.0, 2.0, 5.0, 10.0}, {-5.0, 0.0, 15.0}};
+    std::vector<std::vector<double>> zVals = {{0.0, 1.0}, {1.0, 2.0, 2.5, 3.0}, {4.0, 5.0, 8.0}};
+    std::vector<double> yVals = {0.0, 1.0, 3.0};
+
+    avionics_sim::Bilinear_interp interp(xVals, yVals, zVals);
+
+    ASSERT_EQ(interp.viewX()[1].size(), 4);
+    ASSERT_EQ(interp.viewZ()[2].back(), 8.0);
+
+    // Stored values give the same results as the values they were set from
+    for (double y = -0.5; y <= 3.5; y += 0.25) {
+        for (double x = -6.0; x <= 16.0; x += 0.5) {
+            double zStored, zGiven;
+            avionics_sim::Bilinear_interp::InterpResult storedResult = interp.interpolate2D(x, y, &zStored);
+            avionics_sim::Bilinear_interp::InterpResult givenResult =
+                interp.interpolate2D(xVals, yVals, zVals, x, y, &zGiven);
+
+            ASSERT_EQ(storedResult, givenResult) << "x = " << x << ", y = " << y;
+            ASSERT_EQ(zStored, zGiven) << "x = " << x << ", y = " << y;
+        }
+    }
+}
+
+TEST_F(BilinearInterp_UnitTest, interpolate2DBatchMatchesSingle) {
+    std::vector<std::vector<double>> xVals, zVals;
+    std::vector<double> yVals;
+
+    ASSERT_TRUE(avionics_sim::Bilinear_interp::get2DLUTelementsFromString(xValsString, &xVals));
+    ASSERT_TRUE(avionics_sim::Bilinear_interp::get1DLUTelementsFromString(yValsString, &yVals));
+    ASSERT_TRUE(avionics_sim::Bilinear_interp::get2DLUTelementsFromString(zValsString, &zVals));
+
+    avionics_sim::Bilinear_interp interp;
+    std::vector<double> x = {0.0, 1.0, 2.0}, y = {0.0, 1.0, 2.0}, z(3);
+    std::vector<avionics_sim::Bilinear_interp::InterpResult> results(3);
+
+    // Every point fails without a LUT
+    ASSERT_EQ(interp.interpolate2D(x, y, z.data(), results.data()),
+              avionics_sim::Bilinear_interp::INTERP_ERROR_NO_LUT);
+    ASSERT_EQ(results[2], avionics_sim::Bilinear_interp::INTERP_ERROR_NO_LUT);
+
+    interp.setXVals(xVals);
+    interp.setYVals(yVals);
+    interp.setZVals(zVals);
+
+    // Points inside, outside and on the edges of the table, in a number that leaves a partial last block
+    x.clear();
+    y.clear();
+
+    for (double yq = yVals.front() - 5.0; yq <= yVals.back() + 5.0; yq += 2.5) {
+        for (double xq = -50.0; xq <= 50.0; xq += 0.7) {
+            x.push_back(xq);
+            y.push_back(yq);
+        }
+    }
+
+    x.push_back(0.0);
+    y.push_back(yVals.back());
+    x.push_back(-5.0);
+    y.push_back(yVals.front());
+    ASSERT_NE(x.size() % 4, 0);
+
+    z.resize(x.size());
+    results.resize(x.size());
+
+    // Give identical results and result codes to interpolating one point at a time
+    avionics_sim::Bilinear_interp::InterpResult batchResult =
+        interp.interpolate2D(x, y, z.data(), results.data());
+    avionics_sim::Bilinear_interp::InterpResult expectedBatchResult = avionics_sim::Bilinear_interp::INTERP_SUCCESS;
+
+    for (std::size_t i = 0; i < x.size(); i++) {
+        double zSingle;
+        avionics_sim::Bilinear_interp::InterpResult singleResult = interp.interpolate2D(x[i], y[i], &zSingle);
+
+        ASSERT_EQ(results[i], singleResult) << "x = " << x[i] << ", y = " << y[i];
+        ASSERT_EQ(z[i], zSingle) << "x = " << x[i] << ", y = " << y[i];
+
+        if (singleResult != avionics_sim::Bilinear_interp::INTERP_SUCCESS) {
+            expectedBatchResult = avionics_sim::Bilinear_interp::INTERP_WARN_OUT_OF_BOUNDS;
+        }
+    }
+
+    ASSERT_EQ(batchResult, expectedBatchResult);
+
+    // Per point results are optional
+    std::vector<double> zWithoutResults(x.size());
+    ASSERT_EQ(interp.interpolate2D(x, y, zWithoutResults.data()), batchResult);
+    ASSERT_EQ(zWithoutResults, z);
+}
+
+TEST_F(BilinearInterp_UnitTest, interpolate2DBatchUniformMatchesSingle) {
+    // Uniform rows of different lengths and spacings, not all exactly representable, so that whole blocks of points
+    // can be searched at once
+    std::vector<std::vector<double>> xVals, zVals;
+    std::vector<double> yVals;
+
+    for (int j = 0; j < 12; j++) {
+        yVals.push_back(-0.3 + j * 0.1);
+        xVals.push_back(std::vector<double>());
+        zVals.push_back(std::vector<double>());
+
+        for (int i = 0; i < 30 + j; i++) {
+            xVals[j].push_back(-3.0 + j * 0.01 + i * (0.1 + j * 0.003));
+            zVals[j].push_back(std::sin(xVals[j].back()) * (j - 5.5));
+        }
+    }
+
+    avionics_sim::Bilinear_interp interp(xVals, yVals, zVals);
+
+    // Points between, on and beyond the breakpoints, and not a number in x
+    std::vector<double> x, y;
+    std::mt19937_64 generator(0);
+    std::uniform_real_distribution<double> xDistribution(-3.5, 2.5);
+    std::uniform_real_distribution<double> yDistribution(-0.5, 1.0);
+
+    for (int i = 0; i < 4001; i++) {
+        x.push_back(xDistribution(generator));
+        y.push_back(yDistribution(generator));
+    }
+
+    for (std::size_t j = 0; j < yVals.size(); j++) {
+        for (double xq : xVals[j]) {
+            x.push_back(xq);
+            y.push_back(yVals[j]);
+        }
+    }
+
+    x.push_back(std::nan(""));
+    y.push_back(0.25);
+
+    std::vector<double> z(x.size());
+    std::vector<avionics_sim::Bilinear_interp::InterpResult> results(x.size());
+    interp.interpolate2D(x, y, z.data(), results.data());
+
+    // Give identical results and result codes to interpolating one point at a time
+    for (std::size_t i = 0; i < x.size(); i++) {
+        double zSingle;
+        avionics_sim::Bilinear_interp::InterpResult singleResult = interp.interpolate2D(x[i], y[i], &zSingle);
+
+        ASSERT_EQ(results[i], singleResult) << "x = " << x[i] << ", y = " << y[i];
+        ASSERT_EQ(std::memcmp(&z[i], &zSingle, sizeof(double)), 0) << "x = " << x[i] << ", y = " << y[i];
+    }
+}
+
+TEST_F(BilinearInterp_UnitTest, interpolateSegmentMatchesBracket) {
+    // Unevenly spaced, with a repeated breakpoint
+    std::vector<double> xv = {-180.0, -20.0, -5.0, 0.0, 0.0, 2.5, 10.0, 90.0, 180.0};
+    std::vector<double> yv = {0.0, -0.9, -0.4, 0.1, 0.1, 0.35, 1.2, 0.05, 0.0};
+
+    std::vector<avionics_sim::Bilinear_interp::Segment> segments;
+    avionics_sim::Bilinear_interp::computeSegments(xv, yv, &segments);
+    ASSERT_EQ(segments.size(), yv.size());
+
+    avionics_sim::Bilinear_interp::UniformGrid grid = avionics_sim::Bilinear_interp::detectUniformGrid(xv);
+
+    for (double x = -200.0; x <= 200.0; x += 0.125) {
+        avionics_sim::Bilinear_interp::Bracket bracket, interval;
+        avionics_sim::Bilinear_interp::InterpResult result =
+            avionics_sim::Bilinear_interp::findBracket(xv, grid, x, &bracket);
+
+        ASSERT_EQ(avionics_sim::Bilinear_interp::findInterval(xv, grid, x, &interval), result);
+        ASSERT_EQ(interval.lower, bracket.lower);
+        ASSERT_EQ(interval.upper, bracket.upper);
+
+        double expected = avionics_sim::Bilinear_interp::interpolateBracket(yv, bracket);
+        EXPECT_NEAR(avionics_sim::Bilinear_interp::interpolateSegment(yv, segments.data(), interval, x), expected,
+                    1e-14 * 180.0) << "x = " << x;
+    }
+
+    // Clamped values are exactly those of the table
+    avionics_sim::Bilinear_interp::Bracket interval;
+    avionics_sim::Bilinear_interp::findInterval(xv, grid, 500.0, &interval);
+    EXPECT_EQ(avionics_sim::Bilinear_interp::interpolateSegment(yv, segments.data(), interval, 500.0), yv.back());
+}
+
+TEST_F(BilinearInterp_UnitTest, interpolate2DPrecomputedSlopesMatchWeights) {
+    std::vector<std::vector<double>> xVals, zVals;
+    std::vector<double> yVals;
+
+    ASSERT_TRUE(avionics_sim::Bilinear_interp::get2DLUTelementsFromString(xValsString, &xVals));
+    ASSERT_TRUE(avionics_sim::Bilinear_interp::get1DLUTelementsFromString(yValsString, &yVals));
+    ASSERT_TRUE(avionics_sim::Bilinear_interp::get2DLUTelementsFromString(zValsString, &zVals));
+
+    avionics_sim::Bilinear_interp weights(xVals, yVals, zVals);
+    avionics_sim::Bilinear_interp slopes(xVals, yVals, zVals);
+    slopes.setPrecomputedSlopes(true);
+
+    std::vector<double> x, y;
+
+    for (double yq = -10.0; yq <= 80.0; yq += 2.5) {
+        for (double xq = -500.0; xq <= 10000.0; xq += 97.0) {
+            x.push_back(xq);
+            y.push_back(yq);
+        }
+    }
+
+    std::vector<double> z(x.size());
+    std::vector<avionics_sim::Bilinear_interp::InterpResult> results(x.size());
+    slopes.interpolate2D(x, y, z.data(), results.data());
+
+    for (std::size_t i = 0; i < x.size(); i++) {
+        double zWeights, zSlopes;
+        avionics_sim::Bilinear_interp::InterpResult weightsResult = weights.interpolate2D(x[i], y[i], &zWeights);
+
+        ASSERT_EQ(slopes.interpolate2D(x[i], y[i], &zSlopes), weightsResult) << "x = " << x[i] << ", y = " << y[i];
+        ASSERT_NEAR(zSlopes, zWeights, 1e-12) << "x = " << x[i] << ", y = " << y[i];
+
+        // The batch stays identical to single points
+        ASSERT_EQ(results[i], weightsResult);
+        ASSERT_EQ(std::memcmp(&z[i], &zSlopes, sizeof(double)), 0) << "x = " << x[i] << ", y = " << y[i];
+    }
+
+    // Slopes follow values set after they were enabled, and can be turned off again
+    zVals[3][5] += 1.0;
+    slopes.setZVals(zVals);
+    weights.setZVals(zVals);
+
+    double zWeights, zSlopes;
+    weights.interpolate2D(4000.0, 35.0, &zWeights);
+    slopes.interpolate2D(4000.0, 35.0, &zSlopes);
+    EXPECT_NEAR(zSlopes, zWeights, 1e-12);
+
+    slopes.setPrecomputedSlopes(false);
+    slopes.interpolate2D(4000.0, 35.0, &zSlopes);
+    EXPECT_EQ(zSlopes, zWeights);
+}
+
+TEST_F(BilinearInterp_UnitTest, interpolate2DEdgesUseNearestRow) {
+    typedef avionics_sim::Bilinear_interp::InterpResult InterpResult;
+
+    // The last row is repeated, so that queries on or beyond it take the first of the two.
+    std::vector<std::vector<double>> xVals = {{0.0, 1.0}, {0.0, 1.0}, {0.0, 1.0}};
+    std::vector<double> yVals = {0.0, 1.0, 1.0};
+    std::vector<std::vector<double>> zVals = {{0.0, 1.0}, {10.0, 11.0}, {20.0, 21.0}};
+
+    avionics_sim::Bilinear_interp weights(xVals, yVals, zVals);
+    avionics_sim::Bilinear_interp slopes(xVals, yVals, zVals);
+    slopes.setPrecomputedSlopes(true);
+
+    struct Query {
+        double x, y, z;
+        InterpResult result;
+    };
+
+    const Query queries[] = {
+        {0.0, 0.0, 0.0, InterpResult::INTERP_SUCCESS},
+        {0.5, -1.0, 0.5, InterpResult::INTERP_WARN_OUT_OF_BOUNDS},
+        {0.5, 0.5, 5.5, InterpResult::INTERP_SUCCESS},
+        {0.5, 1.0, 10.5, InterpResult::INTERP_SUCCESS},
+        {0.5, 2.0, 10.5, InterpResult::INTERP_WARN_OUT_OF_BOUNDS},
+        {2.0, 2.0, 11.0, InterpResult::INTERP_WARN_OUT_OF_BOUNDS},
+        {0.5, NAN, 0.5, InterpResult::INTERP_WARN_OUT_OF_BOUNDS},
+        {NAN, 0.5, 5.0, InterpResult::INTERP_WARN_OUT_OF_BOUNDS},
+    };
+
+    for (const Query &query : queries) {
+        double z;
+
+        EXPECT_EQ(weights.interpolate2D(query.x, query.y, &z), query.result) << "x = " << query.x << ", y = " << query.y;
+        EXPECT_EQ(z, query.z) << "x = " << query.x << ", y = " << query.y;
+
+        EXPECT_EQ(slopes.interpolate2D(query.x, query.y, &z), query.result) << "x = " << query.x << ", y = " << query.y;
+        EXPECT_EQ(z, query.z) << "x = " << query.x << ", y = " << query.y;
+    }
+}
+
+TEST_F(BilinearInterp_UnitTest, interpolate2DCompactStorageWithinReportedError) {
+    avionics_sim::Bilinear_interp reference, interp;
+    ASSERT_TRUE(reference.setXVals(xValsString));
+    ASSERT_TRUE(reference.setYVals(yValsString));
+    ASSERT_TRUE(reference.setZVals(zValsString));
+    ASSERT_TRUE(interp.setXVals(xValsString));
+    ASSERT_TRUE(interp.setYVals(yValsString));
+    ASSERT_TRUE(interp.setZVals(zValsString));
+
+    // z spans about -0.44 to 5.33
+    const double range = 5.3292 + 0.435;
+
+    for (avionics_sim::Bilinear_interp::StorageMode mode : {avionics_sim::Bilinear_interp::STORAGE_FLOAT32,
+            avionics_sim::Bilinear_interp::STORAGE_FIXED16}) {
+        avionics_sim::Bilinear_interp::StorageError error;
+        ASSERT_TRUE(interp.setStorage(mode, &error));
+        EXPECT_EQ(interp.getStorage(), mode);
+        EXPECT_EQ(interp.getStorageError().maxValueError, error.maxValueError);
+
+        // Within half a step of either representation
+        double bound = (mode == avionics_sim::Bilinear_interp::STORAGE_FLOAT32) ? 5.3292 * std::pow(2.0, -24) :
+                       0.5 * range / 65534.0;
+        EXPECT_GT(error.maxValueError, 0.0);
+        EXPECT_LE(error.maxValueError, bound * (1.0 + 1e-9));
+        EXPECT_LE(error.maxInterpolationError, error.maxValueError * (1.0 + 1e-9));
+
+        std::vector<double> x, y;
+
+        for (double yq = -10.0; yq <= 80.0; yq += 1.25) {
+            for (double xq = -500.0; xq <= 10000.0; xq += 61.0) {
+                x.push_back(xq);
+                y.push_back(yq);
+            }
+        }
+
+        std::vector<double> batch(x.size());
+        interp.interpolate2D(avionics_sim::Bilinear_interp::View(x), avionics_sim::Bilinear_interp::View(y),
+                             batch.data());
+
+        for (std::size_t i = 0; i < x.size(); i++) {
+            double expected, z;
+            avionics_sim::Bilinear_interp::InterpResult expectedResult = reference.interpolate2D(x[i], y[i], &expected);
+
+            ASSERT_EQ(interp.interpolate2D(x[i], y[i], &z), expectedResult);
+            ASSERT_NEAR(z, expected, error.maxValueError * (1.0 + 1e-9) + 1e-15);
+            ASSERT_EQ(batch[i], z);
+        }
+    }
+
+    // Back in double precision, the results are those of the table exactly
+    ASSERT_TRUE(interp.setStorage(avionics_sim::Bilinear_interp::STORAGE_DOUBLE));
+    EXPECT_EQ(interp.getStorageError().maxValueError, 0.0);
+
+    for (double yq = -10.0; yq <= 80.0; yq += 2.5) {
+        double expected, z;
+        reference.interpolate2D(4321.0, yq, &expected);
+        interp.interpolate2D(4321.0, yq, &z);
+        ASSERT_EQ(std::memcmp(&z, &expected, sizeof(double)), 0);
+    }
+}
+
+TEST_F(BilinearInterp_UnitTest, setStorageFixed16RejectsNonFiniteValues) {
+    avionics_sim::Bilinear_interp interp;
+    ASSERT_TRUE(interp.setXVals("0,1;0,1"));
+    ASSERT_TRUE(interp.setYVals("0,1"));
+    ASSERT_TRUE(interp.setZVals("1,1;1,1"));
+
+    // A flat table is stored exactly
+    avionics_sim::Bilinear_interp::StorageError error;
+    ASSERT_TRUE(interp.setStorage(avionics_sim::Bilinear_interp::STORAGE_FIXED16, &error));
+    EXPECT_EQ(error.maxValueError, 0.0);
+
+    double z;
+    interp.interpolate2D(0.5, 0.5, &z);
+    EXPECT_EQ(z, 1.0);
+
+    // Values which cannot be scaled revert the mode, which is then refused
+    interp.setZVals(std::vector<std::vector<double>>({{1.0, INFINITY}, {1.0, 2.0}}));
+    EXPECT_EQ(interp.getStorage(), avionics_sim::Bilinear_interp::STORAGE_DOUBLE);
+    EXPECT_FALSE(interp.setStorage(avionics_sim::Bilinear_interp::STORAGE_FIXED16));
+    EXPECT_TRUE(interp.setStorage(avionics_sim::Bilinear_interp::STORAGE_FLOAT32));
+}
+
+// Checks every count of telemetry, which are all left empty when telemetry is compiled out.
+static void expectTelemetry(const avionics_sim::Bilinear_interp::Telemetry &telemetry, std::uint64_t hits,
+                            std::uint64_t lowClamps, std::uint64_t highClamps, double minQuery, double maxQuery) {
+#if AVIONICS_SIM_INTERP_TELEMETRY
+    EXPECT_EQ(telemetry.hits, hits);
+    EXPECT_EQ(telemetry.lowClamps, lowClamps);
+    EXPECT_EQ(telemetry.highClamps, highClamps);
+    EXPECT_EQ(telemetry.minQuery, minQuery);
+    EXPECT_EQ(telemetry.maxQuery, maxQuery);
+#else
+    EXPECT_EQ(telemetry.hits + telemetry.lowClamps + telemetry.highClamps, 0u);
+    EXPECT_EQ(telemetry.minQuery, INFINITY);
+    EXPECT_EQ(telemetry.maxQuery, -INFINITY);
+#endif
+}
+
+TEST_F(BilinearInterp_UnitTest, telemetryCountsQueriesAgainstBounds) {
+    // Uniform rows, the second shifted from the first, so that the batch may be vectorised
+    avionics_sim::Bilinear_interp interp;
+    ASSERT_TRUE(interp.setXVals("0,1,2,3,4;1,2,3,4,5"));
+    ASSERT_TRUE(interp.setYVals("0,1"));
+    ASSERT_TRUE(interp.setZVals("0,1,2,3,4;1,2,3,4,5"));
+
+    avionics_sim::Bilinear_interp batch = interp;
+    avionics_sim::Bilinear_interp slopes = interp;
+    slopes.setPrecomputedSlopes(true);
+
+    // Between the rows x is within 1 to 4; on the first row alone within 0 to 4, and on the last within 1 to 5
+    std::vector<double> x = {2.5, 0.5, 4.5, 0.5, 4.5, NAN, -3.0, 2.0};
+    std::vector<double> y = {0.5, 0.5, 0.5, -1.0, 2.0, 0.5, 0.0, 1.0};
+
+    for (std::size_t i = 0; i < x.size(); i++) {
+        double z;
+        interp.interpolate2D(x[i], y[i], &z);
+        slopes.interpolate2D(x[i], y[i], &z);
+    }
+
+    std::vector<double> z(x.size());
+    batch.interpolate2D(avionics_sim::Bilinear_interp::View(x), avionics_sim::Bilinear_interp::View(y), z.data());
+
+    for (const avionics_sim::Bilinear_interp *counted : {&interp, &batch, &slopes}) {
+        avionics_sim::Bilinear_interp::Telemetry2D telemetry = counted->getTelemetry();
+
+        expectTelemetry(telemetry.x, 4, 3, 1, -3.0, 4.5);
+        expectTelemetry(telemetry.y, 6, 1, 1, -1.0, 2.0);
+    }
+
+    // Copies carry on from the counts, until reset
+    avionics_sim::Bilinear_interp copy = interp;
+    expectTelemetry(copy.getTelemetry().x, 4, 3, 1, -3.0, 4.5);
+
+    copy.resetTelemetry();
+    expectTelemetry(copy.getTelemetry().x, 0, 0, 0, INFINITY, -INFINITY);
+    expectTelemetry(copy.getTelemetry().y, 0, 0, 0, INFINITY, -INFINITY);
+    expectTelemetry(interp.getTelemetry().y, 6, 1, 1, -1.0, 2.0);
+}
+
+TEST_F(BilinearInterp_UnitTest, interpolateCubicIsMonotone) {
+    // Unevenly spaced, rising steeply then flat then falling, with a repeated breakpoint
+    std::vector<double> xv = {-10.0, -4.0, 0.0, 1.0, 2.0, 2.0, 8.0, 9.0, 20.0};
+    std::vector<double> yv = {-1.0, -0.9, 0.0, 1.0, 1.0, 1.0, 1.0, 0.5, -2.0};
+
+    std::vector<avionics_sim::Bilinear_interp::CubicSegment> segments;
+    avionics_sim::Bilinear_interp::computeMonotoneCubic(xv, yv, &segments);
+    ASSERT_EQ(segments.size(), yv.size());
+
+    avionics_sim::Bilinear_interp::UniformGrid grid = avionics_sim::Bilinear_interp::detectUniformGrid(xv);
+
+    // Passes through every breakpoint
+    for (std::size_t i = 0; i < xv.size(); i++) {
+        double y;
+        avionics_sim::Bilinear_interp::interpolateCubic(xv, grid, segments.data(), xv[i], &y);
+        EXPECT_NEAR(y, yv[i], 1e-14) << "x = " << xv[i];
+    }
+
+    // Stays within the values either side of each interval, and is flat where they are
+    for (double x = -10.0; x <= 20.0; x += 0.0625) {
+        double y;
+        ASSERT_EQ(avionics_sim::Bilinear_interp::interpolateCubic(xv, grid, segments.data(), x, &y),
+                  avionics_sim::Bilinear_interp::INTERP_SUCCESS);
+
+        avionics_sim::Bilinear_interp::Bracket bracket;
+        avionics_sim::Bilinear_interp::findBracket(xv, grid, x, &bracket);
+
+        EXPECT_GE(y, std::min(yv[bracket.lower], yv[bracket.upper]) - 1e-14) << "x = " << x;
+        EXPECT_LE(y, std::max(yv[bracket.lower], yv[bracket.upper]) + 1e-14) << "x = " << x;
+    }
+
+    // Clamped values are exactly those of the table
+    double y;
+    EXPECT_EQ(avionics_sim::Bilinear_interp::interpolateCubic(xv, grid, segments.data(), 25.0, &y),
+              avionics_sim::Bilinear_interp::INTERP_WARN_OUT_OF_BOUNDS);
+    EXPECT_EQ(y, yv.back());
+    EXPECT_EQ(avionics_sim::Bilinear_interp::interpolateCubic(xv, grid, segments.data(), -25.0, &y),
+              avionics_sim::Bilinear_interp::INTERP_WARN_OUT_OF_BOUNDS);
+    EXPECT_EQ(y, yv.front());
+}
+
+TEST_F(BilinearInterp_UnitTest, interpolateCubicOfSparseTableMatchesDenseLinear) {
+    // A lift curve sampled every 15 degrees, and every 5 degrees
+    std::vector<double> sparseX, sparseY, denseX, denseY;
+
+    for (double alpha = -90.0; alpha <= 90.0; alpha += 5.0) {
+        denseX.push_back(alpha);
+        denseY.push_back(std::sin(2.0 * alpha * M_PI / 180.0));
+
+        if (std::fmod(alpha, 15.0) == 0.0) {
+            sparseX.push_back(alpha);
+            sparseY.push_back(denseY.back());
+        }
+    }
+
+    std::vector<avionics_sim::Bilinear_interp::CubicSegment> segments;
+    avionics_sim::Bilinear_interp::computeMonotoneCubic(sparseX, sparseY, &segments);
+
+    avionics_sim::Bilinear_interp::UniformGrid sparseGrid = avionics_sim::Bilinear_interp::detectUniformGrid(sparseX);
+    avionics_sim::Bilinear_interp::UniformGrid denseGrid = avionics_sim::Bilinear_interp::detectUniformGrid(denseX);
+    double cubicError = 0.0, sparseError = 0.0, denseError = 0.0;
+
+    for (double alpha = -90.0; alpha <= 90.0; alpha += 0.1) {
+        double expected = std::sin(2.0 * alpha * M_PI / 180.0);
+        double cubic, sparse, dense;
+
+        avionics_sim::Bilinear_interp::interpolateCubic(sparseX, sparseGrid, segments.data(), alpha, &cubic);
+        avionics_sim::Bilinear_interp::interpolate(sparseX, sparseGrid, sparseY, alpha, &sparse);
+        avionics_sim::Bilinear_interp::interpolate(denseX, denseGrid, denseY, alpha, &dense);
+
+        cubicError = std::max(cubicError, std::fabs(cubic - expected));
+        sparseError = std::max(sparseError, std::fabs(sparse - expected));
+        denseError = std::max(denseError, std::fabs(dense - expected));
+    }
+
+    // A third of the breakpoints give an error no worse than the dense linear table
+    EXPECT_LT(cubicError, sparseError / 10.0);
+    EXPECT_LE(cubicError, denseError);
+}
+
+TEST_F(BilinearInterp_UnitTest, getLUTelementsFromStringReportsError) {
+    avionics_sim::Bilinear_interp::ParseError error;
+    std::vector<double> outVect(1, 42.0);
+
+    EXPECT_FALSE(avionics_sim::Bilinear_interp::get1DLUTelementsFromString("0,20.0,30.0,,50.0", &outVect, &error));
+    EXPECT_EQ(error.row, 0);
+    EXPECT_EQ(error.column, 3);
+
+    EXPECT_FALSE(avionics_sim::Bilinear_interp::get1DLUTelementsFromString("", &outVect, &error));
+    EXPECT_EQ(error.row, 0);
+    EXPECT_EQ(error.column, 0);
+
+    // The output is left untouched on failure.
+    ASSERT_EQ(outVect.size(), 1);
+    EXPECT_EQ(outVect[0], 42.0);
+
+    std::vector<std::vector<double>> outVect2D;
+
+    EXPECT_FALSE(avionics_sim::Bilinear_interp::get2DLUTelementsFromString("0,1,2;3,4,5;6,7,abc;", &outVect2D,
+                 &error));
+    EXPECT_EQ(error.row, 2);
+    EXPECT_EQ(error.column, 2);
+
+    // An empty row is an error, unlike a single trailing semicolon.
+    EXPECT_FALSE(avionics_sim::Bilinear_interp::get2DLUTelementsFromString("0,1;;2,3", &outVect2D, &error));
+    EXPECT_EQ(error.row, 1);
+    EXPECT_EQ(error.column, 0);
+
+    EXPECT_FALSE(avionics_sim::Bilinear_interp::get2DLUTelementsFromString("0,1;2,3,", &outVect2D, &error));
+    EXPECT_EQ(error.row, 1);
+    EXPECT_EQ(error.column, 2);
+
+    EXPECT_TRUE(outVect2D.empty());
+}
+
+TEST_F(BilinearInterp_UnitTest, getLUTelementsFromStringMatchesSscanf) {
+    // Leading whitespace is skipped and anything after a number up to the next comma ignored, as with sscanf.
+    std::vector<double> outVect;
+    ASSERT_TRUE(avionics_sim::Bilinear_interp::get1DLUTelementsFromString(" 1.5,\n-2e1 ,3.25deg", &outVect));
+    ASSERT_EQ(outVect.size(), 3);
+    EXPECT_EQ(outVect[0], 1.5);
+    EXPECT_EQ(outVect[1], -20.0);
+    EXPECT_EQ(outVect[2], 3.25);
+
+    std::vector<std::vector<double>> outVect2D;
+    ASSERT_TRUE(avionics_sim::Bilinear_interp::get2DLUTelementsFromString("1,2,3;\n4;5,6;", &outVect2D));
+    ASSERT_EQ(outVect2D.size(), 3);
+    ASSERT_EQ(outVect2D[0].size(), 3);
+    ASSERT_EQ(outVect2D[1].size(), 1);
+    ASSERT_EQ(outVect2D[2].size(), 2);
+    EXPECT_EQ(outVect2D[0][2], 3.0);
+    EXPECT_EQ(outVect2D[1][0], 4.0);
+    EXPECT_EQ(outVect2D[2][1], 6.0);
+}
+
 TEST_F(BilinearInterp_UnitTest, get2DLUTelementsFromString) {
     std::string badVals1 =
         "0.0,596.92,1193.6,1790.4,,2983.8,3580.5,4177.2,4774.0,5370.7,5967.4,6564.1,7160.8,7757.6,8354.3,8951.0,8951.0;0.0,606.61,1212.8,1819.0,2425.2,3031.4,3637.6,4243.8,4850.1,5456.3,6062.5,6668.7,7274.9,7881.1,8487.3,9093.5,9093.5;0.0,2265.4,2719.2,3173.0,3626.7,4080.5,4534.3,4988.1,5441.9,5895.6,6349.4,6803.2,7257.0,7710.8,8164.5,8618.3,9072.1;0.0,3115.6,3511.0,3906.4,4301.8,4697.1,5092.5,5487.9,5883.3,6278.7,6674.1,7069.5,7464.9,7860.2,8255.6,8651.0,9046.4;0.0,3915.8,4256.5,4597.1,4937.8,5278.4,5619.1,5959.8,6300.4,6641.1,6981.7,7322.4,7663.1,8003.7,8344.4,8685.0,9025.7;0.0,4854.5,5134.3,5414.1,5693.9,5973.6,6253.4,6533.2,6813.0,7092.8,7372.6,7652.4,7932.2,8211.9,8491.7,8771.5,9051.3;0.0,5685.4,5915.7,6146.1,6376.4,6606.8,6837.1,7067.5,7297.8,7528.2,7758.5,7988.9,8219.2,8449.6,8679.9,8910.3,9140.6;";  // NOLINT
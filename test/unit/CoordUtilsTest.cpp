@@ -10,6 +10,7 @@
 #include <stdio.h>
 #include <ignition/math/Pose3.hh>
 #include <ignition/math/Vector3.hh>
+#include <ignition/math/Matrix3.hh>
 #include <ignition/math/Quaternion.hh>
 
 #include "Coordinate_Utils.hpp"
@@ -67,6 +68,19 @@ class CoordUtilsParamTest : public ::testing::TestWithParam<CoordUtilsParams> {
     }
 };
 
+TEST_P(CoordUtilsParamTest, ProjectRotationGlobalTest) {
+    CoordUtilsParams params = GetParam();
+
+    ignition::math::Matrix3d rotation;
+    avionics_sim::Coordinate_Utils::project_rotation_global(params.poseInWorld, &rotation);
+
+    ignition::math::Vector3d vecResult = rotation * params.vecToRotate;
+
+    for (int i = 0; i < 3; i++) {
+        EXPECT_NEAR(vecResult[i], params.vecExpected[i], 0.01);
+    }
+}
+
 TEST_P(CoordUtilsParamTest, ProjectVectorGlobalTest) {
     CoordUtilsParams params = GetParam();
 
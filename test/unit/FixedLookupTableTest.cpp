@@ -0,0 +1,108 @@
+/**
+ * @copyright   Copyright (c) 2021, Swift Engineering Inc.
+ * @license     Licensed under the MIT license. See LICENSE for details.
+ */
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+#include "Airfoil.hpp"
+#include "FixedLookupTable.hpp"
+#include "LookupTable.hpp"
+
+namespace {
+
+// Unevenly spaced, with a repeated breakpoint and an odd number of rows.
+constexpr avionics_sim::AirfoilTable<9> polar = {{
+        {-90.0, -20.0, -10.0, -5.0, 0.0, 0.0, 10.0, 20.0, 90.0},
+        {0.0, -1.0, -0.8, -0.4, 0.0, 0.0, 0.8, 1.0, 0.0},
+        {1.0, 0.3, 0.1, 0.05, 0.02, 0.02, 0.1, 0.3, 1.0}
+    }
+};
+
+// Looked up when the program is compiled.
+static_assert(polar.lookup(-7.5, 0, 1) > -0.6 - 1e-15 && polar.lookup(-7.5, 0, 1) < -0.6 + 1e-15, "Interpolation");
+static_assert(polar.lookup(-100.0, 0, 2) == 1.0 && polar.lookup(100.0, 0, 1) == 0.0, "Clamping");
+
+}  // namespace
+
+TEST(FixedLookupTableTest, MatchesLookupTable) {
+    std::vector<std::vector<double>> columns;
+
+    for (const auto &column : polar.columns) {
+        columns.push_back(std::vector<double>(std::begin(column), std::end(column)));
+    }
+
+    avionics_sim::LookupTable table({"alpha", "CL", "CD"}, columns);
+    avionics_sim::LookupTable::ColumnHandle alpha = table.resolveColumn("alpha");
+    avionics_sim::LookupTable::ColumnHandle cl = table.resolveColumn("CL");
+    avionics_sim::LookupTable::ColumnHandle cd = table.resolveColumn("CD");
+
+    std::vector<double> queries = {std::numeric_limits<double>::quiet_NaN(), -90.0, 0.0, 90.0};
+
+    for (double value = -100.0; value <= 100.0; value += 0.125) {
+        queries.push_back(value);
+    }
+
+    for (double value : queries) {
+        double expected[] = {table.lookup(value, alpha, cl), table.lookup(value, alpha, cd)};
+        double single[] = {polar.lookup(value, 0, 1), polar.lookup(value, 0, 2)};
+
+        const std::size_t to[] = {1, 2};
+        double fused[2];
+        polar.lookup(value, 0, to, 2, fused);
+
+        ASSERT_EQ(std::memcmp(single, expected, sizeof(expected)), 0) << "alpha = " << value;
+        ASSERT_EQ(std::memcmp(fused, expected, sizeof(expected)), 0) << "alpha = " << value;
+    }
+}
+
+TEST(FixedLookupTableTest, LowerBoundMatchesStandardLibrary) {
+    const double xv[] = {-3.0, -1.0, -1.0, 0.0, 2.0, 2.5, 4.0};
+
+    for (double x = -4.0; x <= 5.0; x += 0.25) {
+        for (std::size_t count = 0; count <= 7; count++) {
+            std::size_t expected = static_cast<std::size_t>(std::lower_bound(xv, xv + count, x) - xv);
+
+            switch (count) {
+            case 0: ASSERT_EQ(avionics_sim::FixedLowerBound<0>::find(xv, 0, x), expected); break;
+            case 1: ASSERT_EQ(avionics_sim::FixedLowerBound<1>::find(xv, 0, x), expected); break;
+            case 2: ASSERT_EQ(avionics_sim::FixedLowerBound<2>::find(xv, 0, x), expected); break;
+            case 3: ASSERT_EQ(avionics_sim::FixedLowerBound<3>::find(xv, 0, x), expected); break;
+            case 4: ASSERT_EQ(avionics_sim::FixedLowerBound<4>::find(xv, 0, x), expected); break;
+            case 5: ASSERT_EQ(avionics_sim::FixedLowerBound<5>::find(xv, 0, x), expected); break;
+            case 6: ASSERT_EQ(avionics_sim::FixedLowerBound<6>::find(xv, 0, x), expected); break;
+            default: ASSERT_EQ(avionics_sim::FixedLowerBound<7>::find(xv, 0, x), expected); break;
+            }
+        }
+    }
+}
+
+TEST(FixedLookupTableTest, AirfoilFromFixedTableMatchesVectors) {
+    avionics_sim::Airfoil fixed(1.5, 0.2, polar);
+    avionics_sim::Airfoil vectors(1.5, 0.2,
+                                  std::vector<double>(std::begin(polar.columns[0]), std::end(polar.columns[0])),
+                                  std::vector<double>(std::begin(polar.columns[1]), std::end(polar.columns[1])),
+                                  std::vector<double>(std::begin(polar.columns[2]), std::end(polar.columns[2])));
+
+    EXPECT_EQ(fixed.getArea_m2(), 1.5);
+    EXPECT_EQ(fixed.getLateralArea_m2(), 0.2);
+
+    // Copies use the same table.
+    avionics_sim::Airfoil copy = fixed;
+
+    for (double value = -100.0; value <= 100.0; value += 0.5) {
+        avionics_sim::AeroCoefficients expected = vectors.calculateCoefficients(value);
+        avionics_sim::AeroCoefficients coefficients = copy.calculateCoefficients(value);
+
+        ASSERT_EQ(coefficients.lift, expected.lift) << "alpha = " << value;
+        ASSERT_EQ(coefficients.drag, expected.drag) << "alpha = " << value;
+        ASSERT_EQ(copy.calculateLiftCoefficient(value), expected.lift) << "alpha = " << value;
+        ASSERT_EQ(copy.calculateDragCoefficient(value), expected.drag) << "alpha = " << value;
+    }
+}
@@ -4,14 +4,19 @@
  */
 #include <gtest/gtest.h>
 
+#include <cstring>
+#include <random>
 #include <string>
 #include <sstream>
+#include <vector>
 #include <boost/array.hpp>
 #include <stdio.h>
+#include <ignition/math/Matrix3.hh>
 #include <ignition/math/Pose3.hh>
 #include <ignition/math/Vector3.hh>
 
 #include "AerodynamicModel.hpp"
+#include "Coordinate_Utils.hpp"
 
 namespace avionics_sim {
 
@@ -25,6 +30,10 @@ class LiftDragModelTest : public ::testing::Test, IPhysicsEnvironment {
     avionics_sim::AerodynamicModel lift_drag_model_;
     double tolerance = 0.001;
 
+    IPhysicsEnvironment &environment() {
+        return *this;
+    }
+
     // You can define per-test set-up logic as usual.
     virtual void SetUp() {
         std::vector<double> LUT_NACA0012_alpha;
@@ -164,4 +173,406 @@ TEST_F(LiftDragModelTest, TestRotatingForcesToBodyLargeAttack) {
     ASSERT_NEAR(force_N.Z(), 0.845313, tolerance);
 }
 
+TEST_F(LiftDragModelTest, TestBatchMatchesSingleUpdates) {
+    // Given: A batch of poses and velocities, with prop wash dominating some and reversed flow in others
+    std::mt19937 generator(3);
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+    std::uniform_real_distribution<double> speed(-30.0, 30.0);
+    std::uniform_real_distribution<double> wash(0.0, 25.0);
+    std::uniform_real_distribution<double> control(-0.5, 0.5);
+
+    std::vector<ignition::math::Pose3d> poses;
+    std::vector<ignition::math::Vector3d> velocities;
+    std::vector<double> propWashes, controlAngles;
+
+    for (int i = 0; i < 500; i++) {
+        poses.push_back(ignition::math::Pose3d(0, 0, 0, angle(generator), angle(generator), angle(generator)));
+        velocities.push_back(ignition::math::Vector3d(speed(generator), speed(generator), speed(generator)));
+        propWashes.push_back(i % 3 == 0 ? wash(generator) : 0.0);
+        controlAngles.push_back(i % 2 == 0 ? control(generator) : 0.0);
+    }
+
+    AerodynamicModel single = lift_drag_model_;
+    IAerodynamicModel &batch = lift_drag_model_;
+
+    // When: Forces are calculated in one batch, and one at a time
+    std::vector<ignition::math::Vector3d> forces_N(poses.size());
+    batch.updateForcesInBody_N(poses.data(), velocities.data(), propWashes.data(), controlAngles.data(),
+                               poses.size(), forces_N.data());
+
+    // Then: Forces should be exactly the same
+    for (std::size_t i = 0; i < poses.size(); i++) {
+        ignition::math::Vector3d expected_N = single.updateForcesInBody_N(poses[i], velocities[i], propWashes[i],
+                                              controlAngles[i]);
+
+        ASSERT_EQ(std::memcmp(&forces_N[i], &expected_N, sizeof(expected_N)), 0) << "element " << i;
+    }
+
+    // An empty batch writes nothing.
+    ignition::math::Vector3d untouched_N(1, 2, 3);
+    batch.updateForcesInBody_N(poses.data(), velocities.data(), propWashes.data(), controlAngles.data(), 0,
+                               &untouched_N);
+    ASSERT_EQ(untouched_N, ignition::math::Vector3d(1, 2, 3));
+}
+
+TEST_F(LiftDragModelTest, TestStateCaptureLevels) {
+    // Given: Models keeping the full state, only the forces, and nothing
+    AerodynamicModel full = lift_drag_model_;
+    AerodynamicModel forcesOnly = lift_drag_model_;
+    AerodynamicModel none = lift_drag_model_;
+
+    forcesOnly.setStateCapture(AerodynamicModel::STATE_CAPTURE_FORCES);
+    none.setStateCapture(AerodynamicModel::STATE_CAPTURE_NONE);
+
+    ASSERT_EQ(full.getStateCapture(), AerodynamicModel::STATE_CAPTURE_FULL);
+    ASSERT_EQ(none.getStateCapture(), AerodynamicModel::STATE_CAPTURE_NONE);
+
+    ignition::math::Pose3d poseInWorld_m_rad(0, 0, 0, -0.09, 1.48, 0.1);
+    ignition::math::Vector3d velocityInWorld_m_per_s(10, 1, 0.1);
+
+    // When: Each is updated with the same pose and velocity
+    ignition::math::Vector3d fullForce_N = full.updateForcesInBody_N(poseInWorld_m_rad, velocityInWorld_m_per_s, 2.0,
+                                           0.05);
+    ignition::math::Vector3d forcesOnlyForce_N = forcesOnly.updateForcesInBody_N(poseInWorld_m_rad,
+            velocityInWorld_m_per_s, 2.0, 0.05);
+    ignition::math::Vector3d noneForce_N = none.updateForcesInBody_N(poseInWorld_m_rad, velocityInWorld_m_per_s, 2.0,
+                                           0.05);
+
+    // Then: Forces should be exactly the same at every level
+    ASSERT_EQ(std::memcmp(&forcesOnlyForce_N, &fullForce_N, sizeof(fullForce_N)), 0);
+    ASSERT_EQ(std::memcmp(&noneForce_N, &fullForce_N, sizeof(fullForce_N)), 0);
+
+    // And the full state should hold every step of the update
+    AerodynamicState fullState = full.getState();
+    ASSERT_EQ(ignition::math::Vector3d(fullState.velocityWorld_m_per_s), velocityInWorld_m_per_s);
+    ASSERT_EQ(ignition::math::Vector3d(fullState.velocityBody_m_per_s),
+              full.transformToLocalVelocity(poseInWorld_m_rad, velocityInWorld_m_per_s));
+    ASSERT_NEAR(fullState.angleOfAttack_deg, 7.516, tolerance);
+    ignition::math::Vector3d fullStateForce_N = fullState.force_N;
+    ASSERT_EQ(std::memcmp(&fullStateForce_N, &fullForce_N, sizeof(fullForce_N)), 0);
+
+    // And the forces only state should hold the forces alone
+    AerodynamicState forcesOnlyState = forcesOnly.getState();
+    ASSERT_EQ(double(forcesOnlyState.lift_N), double(fullState.lift_N));
+    ASSERT_EQ(double(forcesOnlyState.drag_N), double(fullState.drag_N));
+    ASSERT_EQ(double(forcesOnlyState.lateralForce_N), double(fullState.lateralForce_N));
+    ignition::math::Vector3d forcesOnlyStateForce_N = forcesOnlyState.force_N;
+    ASSERT_EQ(std::memcmp(&forcesOnlyStateForce_N, &fullForce_N, sizeof(fullForce_N)), 0);
+    ASSERT_EQ(double(forcesOnlyState.angleOfAttack_deg), 0.0);
+    ASSERT_EQ(ignition::math::Vector3d(forcesOnlyState.velocityWorld_m_per_s), ignition::math::Vector3d::Zero);
+
+    // And no state should hold nothing
+    AerodynamicState noneState = none.getState();
+    ASSERT_EQ(double(noneState.lift_N), 0.0);
+    ASSERT_EQ(ignition::math::Vector3d(noneState.force_N), ignition::math::Vector3d::Zero);
+
+    // And lowering the level should clear what is no longer kept
+    full.setStateCapture(AerodynamicModel::STATE_CAPTURE_FORCES);
+    ASSERT_EQ(double(full.getState().lift_N), 0.0);
+}
+
+TEST_F(LiftDragModelTest, TestRotationMatchesPose) {
+    // Given: Surfaces sharing poses, one rotation built per pose
+    std::mt19937 generator(5);
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+    std::uniform_real_distribution<double> speed(-30.0, 30.0);
+
+    AerodynamicModel fromRotation = lift_drag_model_;
+
+    for (int i = 0; i < 500; i++) {
+        ignition::math::Pose3d poseInWorld_m_rad(0, 0, 0, angle(generator), angle(generator), angle(generator));
+        ignition::math::Vector3d velocityInWorld_m_per_s(speed(generator), speed(generator), speed(generator));
+        double propWash_m_per_s = i % 3 == 0 ? 10.0 : 0.0;
+
+        ignition::math::Matrix3d worldToBody;
+        Coordinate_Utils::project_rotation_global(poseInWorld_m_rad, &worldToBody);
+
+        // When: Forces are calculated from the rotation, and from the pose
+        ignition::math::Vector3d force_N = fromRotation.updateForcesInBody_N(worldToBody, velocityInWorld_m_per_s,
+                                           propWash_m_per_s, 0.05);
+        ignition::math::Vector3d expected_N = lift_drag_model_.updateForcesInBody_N(poseInWorld_m_rad,
+                                              velocityInWorld_m_per_s, propWash_m_per_s, 0.05);
+
+        // Then: Forces should be exactly the same
+        ASSERT_EQ(std::memcmp(&force_N, &expected_N, sizeof(expected_N)), 0) << "element " << i;
+
+        ignition::math::Vector3d velocityInBody_m_per_s = fromRotation.getState().velocityBody_m_per_s;
+        ignition::math::Vector3d expectedVelocityInBody_m_per_s = lift_drag_model_.getState().velocityBody_m_per_s;
+        ASSERT_EQ(std::memcmp(&velocityInBody_m_per_s, &expectedVelocityInBody_m_per_s,
+                              sizeof(expectedVelocityInBody_m_per_s)), 0);
+    }
+}
+
+TEST_F(LiftDragModelTest, TestFastAngleMathMatchesExact) {
+    // Given: A model taking its angles with the fast approximations
+    std::mt19937 generator(11);
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+    std::uniform_real_distribution<double> speed(-30.0, 30.0);
+
+    AerodynamicModel fast = lift_drag_model_;
+    fast.setAngleMath(AerodynamicModel::ANGLE_MATH_FAST);
+
+    ASSERT_EQ(lift_drag_model_.getAngleMath(), AerodynamicModel::ANGLE_MATH_EXACT);
+    ASSERT_EQ(fast.getAngleMath(), AerodynamicModel::ANGLE_MATH_FAST);
+
+    for (int i = 0; i < 500; i++) {
+        ignition::math::Pose3d poseInWorld_m_rad(0, 0, 0, angle(generator), angle(generator), angle(generator));
+        ignition::math::Vector3d velocityInWorld_m_per_s(speed(generator), speed(generator), speed(generator));
+
+        // When: Forces are calculated with either
+        ignition::math::Vector3d force_N = fast.updateForcesInBody_N(poseInWorld_m_rad, velocityInWorld_m_per_s,
+                                           0.0, 0.05);
+        ignition::math::Vector3d expected_N = lift_drag_model_.updateForcesInBody_N(poseInWorld_m_rad,
+                                              velocityInWorld_m_per_s, 0.0, 0.05);
+
+        // Then: Forces and angles should be the same, within the error of the approximations
+        for (int axis = 0; axis < 3; axis++) {
+            ASSERT_NEAR(force_N[axis], expected_N[axis], tolerance) << "element " << i;
+        }
+
+        ASSERT_NEAR(fast.getState().angleOfAttack_deg, lift_drag_model_.getState().angleOfAttack_deg, 1e-5);
+        ASSERT_NEAR(fast.getState().sideSlipAngle_deg, lift_drag_model_.getState().sideSlipAngle_deg, 1e-5);
+    }
+}
+
+TEST_F(LiftDragModelTest, TestWrenchOfPitchingMomentAndOffset) {
+    // Given: An airfoil with pitching moment coefficients, its center of pressure half a meter along x
+    std::vector<double> alpha_deg = {-180.0, -15.0, 0.0, 15.0, 180.0};
+    std::vector<double> cl = {0.0, -0.9, 0.0, 0.9, 0.0};
+    std::vector<double> cd = {0.05, 0.3, 0.02, 0.3, 0.05};
+    std::vector<double> cm = {0.0, 0.1, -0.05, -0.2, 0.0};
+
+    AerodynamicModel model(Airfoil(0.5, 0.1, 0.25, alpha_deg, cl, cd, cm), environment());
+    model.setBasisVectors(ignition::math::Vector3d(0, 0, 1), ignition::math::Vector3d(-1, 0, 0));
+    model.setCenterOfPressure(ignition::math::Vector3d(0.5, 0, 0));
+
+    // When: The flow is straight along the forward vector
+    AeroWrench wrench = model.updateWrenchInBody(ignition::math::Pose3d(0, 0, 0, 0, 0, 0),
+                        ignition::math::Vector3d(0, 0, 10), 0.0, 0.0);
+
+    // Then: The drag of 0.02 * 61 Pa * 0.5 m2 acts backward at the center of pressure
+    ASSERT_NEAR(wrench.force_N.Z(), -0.61, 1e-9);
+
+    // And the moment should be its own, plus the pitching moment of -0.05 * 61 Pa * 0.5 m2 * 0.25 m about port
+    ASSERT_NEAR(wrench.moment_N_m.X(), 0.0, 1e-9);
+    ASSERT_NEAR(wrench.moment_N_m.Y(), 0.5 * 0.61 + 0.38125, 1e-9);
+    ASSERT_NEAR(wrench.moment_N_m.Z(), 0.0, 1e-9);
+
+    ASSERT_DOUBLE_EQ(model.getState().momentCoeff, -0.05);
+    ASSERT_EQ(ignition::math::Vector3d(model.getState().moment_N_m), wrench.moment_N_m);
+
+    // And an airfoil with no pitching moment coefficients should give the moment of its force alone
+    AerodynamicModel noMoment(Airfoil(0.5, 0.1, alpha_deg, cl, cd), environment());
+    noMoment.setBasisVectors(ignition::math::Vector3d(0, 0, 1), ignition::math::Vector3d(-1, 0, 0));
+    noMoment.setCenterOfPressure(ignition::math::Vector3d(0.5, 0, 0));
+
+    AeroWrench forceOnly = noMoment.updateWrenchInBody(ignition::math::Pose3d(0, 0, 0, 0, 0, 0),
+                           ignition::math::Vector3d(0, 0, 10), 0.0, 0.0);
+    ASSERT_NEAR(forceOnly.moment_N_m.Y(), 0.5 * 0.61, 1e-9);
+}
+
+TEST_F(LiftDragModelTest, TestWrenchMatchesForces) {
+    // Given: A model with an offset center of pressure, and poses all around
+    std::vector<double> alpha_deg = {-180.0, -15.0, 0.0, 15.0, 180.0};
+    std::vector<double> cl = {0.0, -0.9, 0.0, 0.9, 0.0};
+    std::vector<double> cd = {0.05, 0.3, 0.02, 0.3, 0.05};
+    std::vector<double> cm = {0.0, 0.1, -0.05, -0.2, 0.0};
+
+    AerodynamicModel model(Airfoil(0.5, 0.1, 0.25, alpha_deg, cl, cd, cm), environment());
+    model.setBasisVectors(ignition::math::Vector3d(0.3, 0, 1), ignition::math::Vector3d(-1, 0, 0.3));
+    model.setCenterOfPressure(ignition::math::Vector3d(-1.2, 0.4, 0.1));
+
+    AerodynamicModel forces = model;
+    IAerodynamicModel &wrenchModel = model;
+    EnvironmentSnapshot snapshot;
+    snapshot.airDensity_kg_per_m3 = get_air_density_kg_per_m3();
+
+    std::mt19937 generator(12);
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+    std::uniform_real_distribution<double> speed(-30.0, 30.0);
+
+    for (int i = 0; i < 500; i++) {
+        ignition::math::Pose3d poseInWorld_m_rad(0, 0, 0, angle(generator), angle(generator), angle(generator));
+        ignition::math::Vector3d velocityInWorld_m_per_s(speed(generator), speed(generator), speed(generator));
+        double propWash_m_per_s = i % 3 == 0 ? 10.0 : 0.0;
+
+        ignition::math::Matrix3d worldToBody;
+        Coordinate_Utils::project_rotation_global(poseInWorld_m_rad, &worldToBody);
+
+        // When: The wrench is calculated through the interface, and the force alone
+        AeroWrench wrench = wrenchModel.updateWrenchInBody(poseInWorld_m_rad, velocityInWorld_m_per_s,
+                            propWash_m_per_s, 0.05);
+        ignition::math::Vector3d expected_N = forces.updateForcesInBody_N(poseInWorld_m_rad, velocityInWorld_m_per_s,
+                                              propWash_m_per_s, 0.05);
+
+        // Then: The force should be exactly the same
+        ASSERT_EQ(std::memcmp(&wrench.force_N, &expected_N, sizeof(expected_N)), 0) << "element " << i;
+
+        // And the moment should be that of the force at the center of pressure, plus the pitching moment
+        AerodynamicState state = model.getState();
+        double pitchingMoment_N_m = state.momentCoeff * state.dynamicPressurePlanar_Pa * 0.5 * 0.25;
+        ignition::math::Vector3d expectedMoment_N_m = ignition::math::Vector3d(-1.2, 0.4, 0.1).Cross(expected_N) +
+                ignition::math::Vector3d(0.3, 0, 1).Cross(ignition::math::Vector3d(-1, 0, 0.3)) * pitchingMoment_N_m;
+
+        for (int axis = 0; axis < 3; axis++) {
+            ASSERT_NEAR(wrench.moment_N_m[axis], expectedMoment_N_m[axis], 1e-9) << "element " << i;
+        }
+
+        // And so should the wrench from a rotation, and in the air of a snapshot
+        AeroWrench fromRotation = model.updateWrenchInBody(worldToBody, velocityInWorld_m_per_s, propWash_m_per_s,
+                                  0.05);
+        AeroWrench fromSnapshot = model.updateWrenchInBody(snapshot, poseInWorld_m_rad, velocityInWorld_m_per_s,
+                                  propWash_m_per_s, 0.05);
+
+        ASSERT_EQ(std::memcmp(&fromRotation, &wrench, sizeof(wrench)), 0) << "element " << i;
+        ASSERT_EQ(std::memcmp(&fromSnapshot, &wrench, sizeof(wrench)), 0) << "element " << i;
+    }
+}
+
+
+// Model extending the update from the resolved flow, as for evaluating aerodynamics under prop wash.
+class ResolvedFlowModel : public AerodynamicModel {
+  public:
+    int calls = 0;
+    double planarVelocityScale = 1.0;
+    double lastAngleOfAttack_deg = 0.0;
+
+    ResolvedFlowModel(const AerodynamicModel &model) : AerodynamicModel(model) {}
+
+    virtual ignition::math::Vector3d updateForcesInBody_N(
+        double planarVelocity_m_per_s,
+        double lateralVelocity_m_per_s,
+        double angleOfAttack_deg,
+        double sideSlipAngle_deg) {
+        calls++;
+        lastAngleOfAttack_deg = angleOfAttack_deg;
+        return AerodynamicModel::updateForcesInBody_N(planarVelocityScale * planarVelocity_m_per_s,
+                lateralVelocity_m_per_s, angleOfAttack_deg, sideSlipAngle_deg);
+    }
+
+    using AerodynamicModel::updateForcesInBody_N;
+};
+
+TEST_F(LiftDragModelTest, TestPoseUpdateCallsResolvedFlowUpdate) {
+    // Given: A model extending the update from the resolved flow, and the model it extends
+    ResolvedFlowModel extended(lift_drag_model_);
+    IAerodynamicModel &model = extended;
+
+    std::mt19937 generator(5);
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+    std::uniform_real_distribution<double> speed(-30.0, 30.0);
+
+    for (int i = 0; i < 200; i++) {
+        ignition::math::Pose3d poseInWorld_m_rad(0, 0, 0, angle(generator), angle(generator), angle(generator));
+        ignition::math::Vector3d velocityInWorld_m_per_s(speed(generator), speed(generator), speed(generator));
+        double propWash_m_per_s = i % 3 == 0 ? 12.0 : 0.0;
+
+        // When: It is updated from a pose, passing the flow on unchanged
+        extended.calls = 0;
+        extended.planarVelocityScale = 1.0;
+        ignition::math::Vector3d force_N = model.updateForcesInBody_N(poseInWorld_m_rad, velocityInWorld_m_per_s,
+                                           propWash_m_per_s, 0.1);
+        ignition::math::Vector3d expected_N = lift_drag_model_.updateForcesInBody_N(poseInWorld_m_rad,
+                                              velocityInWorld_m_per_s, propWash_m_per_s, 0.1);
+
+        // Then: The update from the resolved flow should be called once, for the force of the model
+        AerodynamicState state = lift_drag_model_.getState();
+        double angleOfAttack_deg = state.angleOfAttack_deg;
+
+        ASSERT_EQ(extended.calls, 1);
+        ASSERT_EQ(extended.lastAngleOfAttack_deg, angleOfAttack_deg);
+
+        for (int axis = 0; axis < 3; axis++) {
+            ASSERT_NEAR(force_N[axis], expected_N[axis], 1e-9) << "element " << i;
+        }
+
+        // And when it changes the flow, the force should be that of the changed flow
+        extended.planarVelocityScale = 2.0;
+        force_N = model.updateForcesInBody_N(poseInWorld_m_rad, velocityInWorld_m_per_s, propWash_m_per_s, 0.1);
+        expected_N = lift_drag_model_.updateForcesInBody_N(2.0 * state.planarVelocity_m_per_s,
+                     state.lateralVelocity_m_per_s, state.angleOfAttack_deg, state.sideSlipAngle_deg);
+
+        for (int axis = 0; axis < 3; axis++) {
+            ASSERT_NEAR(force_N[axis], expected_N[axis], 1e-9) << "element " << i;
+        }
+    }
+
+    // And every element of a batch should go through it too, for the forces of updating each pose in turn
+    std::vector<ignition::math::Pose3d> poses;
+    std::vector<ignition::math::Vector3d> velocities;
+    std::vector<double> propWashes, controlAngles;
+
+    for (int i = 0; i < 3; i++) {
+        poses.push_back(ignition::math::Pose3d(0, 0, 0, angle(generator), angle(generator), angle(generator)));
+        velocities.push_back(ignition::math::Vector3d(speed(generator), speed(generator), speed(generator)));
+        propWashes.push_back(i == 1 ? 12.0 : 0.0);
+        controlAngles.push_back(0.05 * i);
+    }
+
+    std::vector<ignition::math::Vector3d> forces_N(poses.size());
+    extended.planarVelocityScale = 2.0;
+    extended.calls = 0;
+    model.updateForcesInBody_N(poses.data(), velocities.data(), propWashes.data(), controlAngles.data(),
+                               poses.size(), forces_N.data());
+    ASSERT_EQ(extended.calls, 3);
+
+    for (std::size_t i = 0; i < poses.size(); i++) {
+        ignition::math::Vector3d expected_N = model.updateForcesInBody_N(poses[i], velocities[i], propWashes[i],
+                                              controlAngles[i]);
+
+        ASSERT_EQ(std::memcmp(&forces_N[i], &expected_N, sizeof(expected_N)), 0) << "element " << i;
+    }
+
+    ASSERT_EQ(extended.calls, 6);
+}
+
+// Model extending the forces of the resolved flow, with the angle of attack in radians.
+class RadianFlowModel : public AerodynamicModel {
+  public:
+    int calls = 0;
+    double lastAngleOfAttack_rad = 0.0;
+
+    RadianFlowModel(const AerodynamicModel &model) : AerodynamicModel(model) {}
+
+  protected:
+    virtual ignition::math::Vector3d updateForcesInBodyFromFlow_N(
+        double planarVelocity_m_per_s,
+        double lateralVelocity_m_per_s,
+        double angleOfAttack_deg,
+        double angleOfAttack_rad,
+        double sideSlipAngle_deg) {
+        calls++;
+        lastAngleOfAttack_rad = angleOfAttack_rad;
+        return AerodynamicModel::updateForcesInBodyFromFlow_N(planarVelocity_m_per_s, lateralVelocity_m_per_s,
+                angleOfAttack_deg, angleOfAttack_rad, sideSlipAngle_deg);
+    }
+};
+
+TEST_F(LiftDragModelTest, TestUpdatesCallResolvedFlowHook) {
+    // Given: A model extending the forces of the resolved flow
+    RadianFlowModel extended(lift_drag_model_);
+    IAerodynamicModel &model = extended;
+    ignition::math::Pose3d poseInWorld_m_rad(0, 0, 0, 0.4, -0.3, 1.2);
+    ignition::math::Vector3d velocityInWorld_m_per_s(3, -4, 25);
+
+    // When: It is updated from a pose
+    ignition::math::Vector3d force_N = model.updateForcesInBody_N(poseInWorld_m_rad, velocityInWorld_m_per_s, 0, 0.1);
+    ignition::math::Vector3d expected_N = lift_drag_model_.updateForcesInBody_N(poseInWorld_m_rad,
+                                          velocityInWorld_m_per_s, 0, 0.1);
+
+    // Then: The hook should be called once, with the angle of attack in radians
+    double angleOfAttack_deg = lift_drag_model_.getState().angleOfAttack_deg;
+    ASSERT_EQ(extended.calls, 1);
+    ASSERT_NEAR(extended.lastAngleOfAttack_rad, DEG2RAD(angleOfAttack_deg), 1e-12);
+
+    for (int axis = 0; axis < 3; axis++) {
+        ASSERT_NEAR(force_N[axis], expected_N[axis], 1e-9);
+    }
+
+    // And once for an update from the resolved flow in degrees
+    model.updateForcesInBody_N(20.0, 1.0, 7.5, 2.0);
+    ASSERT_EQ(extended.calls, 2);
+    ASSERT_EQ(extended.lastAngleOfAttack_rad, DEG2RAD(7.5));
+}
+
 }  // namespace avionics_sim
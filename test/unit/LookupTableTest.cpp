@@ -4,11 +4,13 @@
  */
 #include <gtest/gtest.h>
 
+#include <cmath>
 #include <string>
 #include <sstream>
 #include <boost/array.hpp>
 #include <stdio.h>
 
+#include "Airfoil.hpp"
 #include "LookupTable.hpp"
 
 
@@ -34,3 +36,190 @@ TEST_F(LookupTableTest, TestConstruction) {
     // Then
     ASSERT_EQ(result, 4.5);
 }
+
+TEST_F(LookupTableTest, TestLookupByHandleMatchesLookupByName) {
+    // Given handles resolved from the column names
+    avionics_sim::LookupTable::ColumnHandle from = lookupTable_.resolveColumn("Angle Of Attack");
+    avionics_sim::LookupTable::ColumnHandle to = lookupTable_.resolveColumn("Lift Coefficient");
+
+    // When values are looked up by handle, including out of bounds
+    // Then the results match those looked up by name
+    for (double value : {0.0, 1.0, 1.5, 2.75, 3.0, 4.0}) {
+        ASSERT_EQ(lookupTable_.lookup(value, from, to),
+                  lookupTable_.lookup(value, "Angle Of Attack", "Lift Coefficient"));
+    }
+}
+
+TEST_F(LookupTableTest, TestHandleValidInCopy) {
+    // Given a handle resolved before the table is copied
+    avionics_sim::LookupTable::ColumnHandle from = lookupTable_.resolveColumn("Angle Of Attack");
+    avionics_sim::LookupTable::ColumnHandle to = lookupTable_.resolveColumn("Lift Coefficient");
+    avionics_sim::LookupTable copy = lookupTable_;
+
+    // When value is looked up in the copy
+    double result = copy.lookup(2.5, from, to);
+
+    // Then
+    ASSERT_EQ(result, 5.5);
+}
+
+TEST_F(LookupTableTest, TestResolvingUnknownColumnThrows) {
+    ASSERT_THROW(lookupTable_.resolveColumn("Drag Coefficient"), std::out_of_range);
+}
+
+TEST_F(LookupTableTest, TestLookupOfSeveralColumns) {
+    // Given a table with two destination columns
+    avionics_sim::LookupTable table({"alpha", "CL", "CD"}, {{-10.0, 0.0, 10.0}, {-1.0, 0.0, 1.0}, {0.5, 0.1, 0.5}});
+    avionics_sim::LookupTable::ColumnHandle from = table.resolveColumn("alpha");
+    avionics_sim::LookupTable::ColumnHandle to[] = {table.resolveColumn("CD"), table.resolveColumn("CL")};
+
+    // When both are looked up at once, in and out of bounds
+    // Then each value matches the corresponding single lookup
+    for (double value : {-20.0, -10.0, -2.5, 0.0, 7.5, 10.0, 20.0}) {
+        double result[2];
+        table.lookup(value, from, to, 2, result);
+
+        ASSERT_EQ(result[0], table.lookup(value, from, to[0]));
+        ASSERT_EQ(result[1], table.lookup(value, from, to[1]));
+    }
+}
+
+TEST_F(LookupTableTest, TestLookupWithCursor) {
+    // Given a table with uneven spacing
+    avionics_sim::LookupTable table({"alpha", "CL", "CD"},
+    {{-90.0, -20.0, -10.0, -5.0, 0.0, 5.0, 10.0, 20.0, 90.0}, {0.0, -1.0, -0.8, -0.4, 0.0, 0.4, 0.8, 1.0, 0.0},
+        {1.0, 0.3, 0.1, 0.05, 0.02, 0.05, 0.1, 0.3, 1.0}
+    });
+    avionics_sim::LookupTable::ColumnHandle from = table.resolveColumn("alpha");
+    avionics_sim::LookupTable::ColumnHandle to[] = {table.resolveColumn("CL"), table.resolveColumn("CD")};
+
+    // When successive values are looked up through a cursor
+    // Then the results match lookups without one
+    avionics_sim::Bilinear_interp::Cursor cursor;
+
+    for (double value : {-100.0, -90.0, -17.0, -15.0, -4.0, 3.0, 4.0, 60.0, 2.0, -60.0, 0.0, 90.0, 100.0}) {
+        double result[2];
+        table.lookup(value, from, to, 2, result, &cursor);
+
+        ASSERT_EQ(result[0], table.lookup(value, from, to[0]));
+        ASSERT_EQ(result[1], table.lookup(value, from, to[1]));
+        ASSERT_EQ(table.lookup(value, from, to[0], &cursor), result[0]);
+    }
+}
+
+TEST_F(LookupTableTest, TestPrecomputedSlopes) {
+    // Given a table with uneven spacing, and a copy of it with slopes precomputed
+    avionics_sim::LookupTable table({"alpha", "CL", "CD"},
+    {{-90.0, -20.0, -10.0, -5.0, 0.0, 5.0, 10.0, 20.0, 90.0}, {0.0, -1.0, -0.8, -0.4, 0.0, 0.4, 0.8, 1.0, 0.0},
+        {1.0, 0.3, 0.1, 0.05, 0.02, 0.05, 0.1, 0.3, 1.0}
+    });
+    avionics_sim::LookupTable::ColumnHandle from = table.resolveColumn("alpha");
+    avionics_sim::LookupTable::ColumnHandle to[] = {table.resolveColumn("CL"), table.resolveColumn("CD")};
+
+    avionics_sim::LookupTable slopes = table;
+    slopes.precomputeSlopes(from);
+
+    // When values are looked up, including out of bounds
+    // Then the results agree to within rounding, and exactly where clamped
+    for (double value = -100.0; value <= 100.0; value += 0.25) {
+        double result[2];
+        slopes.lookup(value, from, to, 2, result);
+
+        ASSERT_NEAR(result[0], table.lookup(value, from, to[0]), 1e-14);
+        ASSERT_NEAR(result[1], table.lookup(value, from, to[1]), 1e-14);
+        ASSERT_EQ(slopes.lookup(value, from, to[0]), result[0]);
+    }
+
+    ASSERT_EQ(slopes.lookup(100.0, from, to[1]), 1.0);
+    ASSERT_EQ(slopes.lookup(-100.0, from, to[0]), 0.0);
+}
+
+TEST_F(LookupTableTest, TestMonotoneCubic) {
+    // Given a table with uneven spacing, and copies of it with cubic interpolation
+    avionics_sim::LookupTable table({"alpha", "CL", "CD"},
+    {{-90.0, -20.0, -10.0, -5.0, 0.0, 5.0, 10.0, 20.0, 90.0}, {0.0, -1.0, -0.8, -0.4, 0.0, 0.4, 0.8, 1.0, 0.0},
+        {1.0, 0.3, 0.1, 0.05, 0.02, 0.05, 0.1, 0.3, 1.0}
+    });
+    avionics_sim::LookupTable::ColumnHandle from = table.resolveColumn("alpha");
+    avionics_sim::LookupTable::ColumnHandle to[] = {table.resolveColumn("CL"), table.resolveColumn("CD")};
+
+    avionics_sim::LookupTable cubic = table;
+    cubic.precomputeMonotoneCubic(from);
+
+    // When values are looked up, singly, together and through a cursor
+    // Then the results agree with each other and with the table at its breakpoints
+    avionics_sim::Bilinear_interp::Cursor cursor;
+
+    for (double value = -100.0; value <= 100.0; value += 0.25) {
+        double result[2];
+        cubic.lookup(value, from, to, 2, result, &cursor);
+
+        ASSERT_EQ(cubic.lookup(value, from, to[0]), result[0]);
+        ASSERT_EQ(cubic.lookup(value, from, to[1]), result[1]);
+    }
+
+    for (double value : {-90.0, -20.0, -5.0, 0.0, 10.0, 90.0}) {
+        ASSERT_NEAR(cubic.lookup(value, from, to[0]), table.lookup(value, from, to[0]), 1e-14);
+        ASSERT_NEAR(cubic.lookup(value, from, to[1]), table.lookup(value, from, to[1]), 1e-14);
+    }
+
+    // And the curve is smooth between breakpoints rather than linear
+    EXPECT_GT(std::fabs(cubic.lookup(15.0, from, to[0]) - table.lookup(15.0, from, to[0])), 1e-3);
+
+    // When slopes are precomputed afterwards
+    // Then lookups are linear again
+    cubic.precomputeSlopes(from);
+    EXPECT_NEAR(cubic.lookup(15.0, from, to[0]), table.lookup(15.0, from, to[0]), 1e-14);
+}
+
+TEST_F(LookupTableTest, TestTelemetry) {
+    avionics_sim::LookupTable::ColumnHandle from = lookupTable_.resolveColumn("Angle Of Attack");
+    avionics_sim::LookupTable::ColumnHandle to = lookupTable_.resolveColumn("Lift Coefficient");
+
+    // Given lookups within, below, above and off the table, by name, by handle and of several columns
+    double values[1];
+    lookupTable_.lookup(1.5, "Angle Of Attack", "Lift Coefficient");
+    lookupTable_.lookup(3.0, from, to);
+    lookupTable_.lookup(0.5, from, to);
+    lookupTable_.lookup(NAN, from, &to, 1, values);
+    lookupTable_.lookup(4.5, from, &to, 1, values);
+
+    // Then each is counted against the source column alone
+    EXPECT_EQ(lookupTable_.getTelemetry(to).hits, 0u);
+
+#if AVIONICS_SIM_INTERP_TELEMETRY
+    const avionics_sim::Bilinear_interp::Telemetry &telemetry = lookupTable_.getTelemetry(from);
+    EXPECT_EQ(telemetry.hits, 2u);
+    EXPECT_EQ(telemetry.lowClamps, 2u);
+    EXPECT_EQ(telemetry.highClamps, 1u);
+    EXPECT_EQ(telemetry.minQuery, 0.5);
+    EXPECT_EQ(telemetry.maxQuery, 4.5);
+#endif
+
+    // When reset
+    // Then the counts are cleared
+    lookupTable_.resetTelemetry();
+    EXPECT_EQ(lookupTable_.getTelemetry(from).hits + lookupTable_.getTelemetry(from).lowClamps, 0u);
+    EXPECT_EQ(lookupTable_.getTelemetry(from).minQuery, INFINITY);
+
+    // Given airfoils from vectors and from a fixed polar, looked up off the polar
+    static const avionics_sim::AirfoilTable<3> polar = {{{-10.0, 0.0, 10.0}, {-0.8, 0.0, 0.8}, {0.1, 0.02, 0.1}}};
+    avionics_sim::Airfoil vectors(1.0, 0.1, {-10.0, 0.0, 10.0}, {-0.8, 0.0, 0.8}, {0.1, 0.02, 0.1});
+    avionics_sim::Airfoil fixed(1.0, 0.1, polar);
+
+    for (avionics_sim::Airfoil *airfoil : {&vectors, &fixed}) {
+        airfoil->calculateCoefficients(5.0);
+        airfoil->calculateLiftCoefficient(15.0);
+        airfoil->calculateDragCoefficient(-15.0);
+
+        // Then each lookup is counted alike
+#if AVIONICS_SIM_INTERP_TELEMETRY
+        EXPECT_EQ(airfoil->getTelemetry().hits, 1u);
+        EXPECT_EQ(airfoil->getTelemetry().lowClamps, 1u);
+        EXPECT_EQ(airfoil->getTelemetry().highClamps, 1u);
+#endif
+
+        airfoil->resetTelemetry();
+        EXPECT_EQ(airfoil->getTelemetry().highClamps, 0u);
+    }
+}
@@ -4,6 +4,8 @@
  */
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <limits>
 #include <string>
 #include <sstream>
 #include <boost/array.hpp>
@@ -109,6 +111,62 @@ TEST_F(MathUtilTest, TestLinearMap) {
     ASSERT_NEAR(result, expectedValue, tolerance);
 }
 
+TEST_F(MathUtilTest, TestFastAtan2) {
+    // Given: Points all around the origin, on the axes and near the diagonals
+    double bound = 1e-7;
+    double worst = 0.0;
+
+    for (int i = -200; i <= 200; i++) {
+        for (int j = -200; j <= 200; j++) {
+            double y = i * 0.137;
+            double x = j * 0.089;
+
+            // When:
+            double result = avionics_sim::Math_util::fast_atan2(y, x);
+
+            // Then:
+            worst = std::max(worst, fabs(result - atan2(y, x)));
+        }
+    }
+
+    ASSERT_LT(worst, bound);
+
+    // And the signs of zero, and the quadrants of the axes, are those of atan2
+    double zeros[] = {0.0, -0.0};
+
+    for (double y : zeros) {
+        for (double x : zeros) {
+            ASSERT_EQ(avionics_sim::Math_util::fast_atan2(y, x), atan2(y, x));
+            ASSERT_EQ(std::signbit(avionics_sim::Math_util::fast_atan2(y, x)), std::signbit(atan2(y, x)));
+        }
+    }
+
+    ASSERT_NEAR(avionics_sim::Math_util::fast_atan2(1.0, 0.0), M_PI / 2, bound);
+    ASSERT_NEAR(avionics_sim::Math_util::fast_atan2(-1.0, 0.0), -M_PI / 2, bound);
+    ASSERT_NEAR(avionics_sim::Math_util::fast_atan2(0.0, -1.0), M_PI, bound);
+    ASSERT_NEAR(avionics_sim::Math_util::fast_atan2(-0.0, -1.0), -M_PI, bound);
+
+    ASSERT_TRUE(std::isnan(avionics_sim::Math_util::fast_atan2(std::numeric_limits<double>::quiet_NaN(), 1.0)));
+    ASSERT_TRUE(std::isnan(avionics_sim::Math_util::fast_atan2(1.0, std::numeric_limits<double>::quiet_NaN())));
+}
+
+TEST_F(MathUtilTest, TestFastAsin) {
+    // Given: Sines across [-1, 1]
+    double bound = 1e-7;
+
+    for (int i = -1000; i <= 1000; i++) {
+        double x = i / 1000.0;
+
+        // When:
+        double result = avionics_sim::Math_util::fast_asin(x);
+
+        // Then:
+        ASSERT_NEAR(result, asin(x), bound) << "x " << x;
+    }
+
+    ASSERT_TRUE(std::isnan(avionics_sim::Math_util::fast_asin(1.5)));
+}
+
 // TODO(Mike Lyons): Figure out why this has a hold up in the test
 // TEST_F(MathUtilTest, TestPowInteger) {
 //   // Given:
@@ -0,0 +1,118 @@
+/**
+ * @copyright   Copyright (c) 2021, Swift Engineering Inc.
+ * @license     Licensed under the MIT license. See LICENSE for details.
+ */
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include "Bilinear_interp.hpp"
+#include "Multilinear_interp.hpp"
+
+class MultilinearInterpTest : public ::testing::Test {
+  protected:
+    // Unevenly spaced alpha, evenly spaced Mach and deflection.
+    std::vector<double> alpha = {-10.0, -2.0, 0.0, 4.0, 8.0, 16.0};
+    std::vector<double> mach = {0.0, 0.2, 0.4, 0.6};
+    std::vector<double> deflection = {-20.0, 0.0, 20.0};
+
+    // Multilinear, so reproduced exactly, up to rounding, by multilinear interpolation.
+    static double trilinear(double a, double m, double d) {
+        return 0.1 * a + 2.0 * m - 0.01 * d + 0.5 * a * m + 0.02 * m * d - 0.003 * a * d + 0.07 * a * m * d + 0.3;
+    }
+};
+
+TEST_F(MultilinearInterpTest, NoTable) {
+    avionics_sim::Multilinear_interp<2> interp;
+    double value;
+
+    EXPECT_EQ(interp.interpolate({1.0, 1.0}, &value), avionics_sim::Bilinear_interp::INTERP_ERROR_NO_LUT);
+
+    // The wrong number of values, and an empty axis.
+    EXPECT_FALSE(interp.setTable({alpha, mach}, std::vector<double>(alpha.size() * mach.size() - 1, 0.0)));
+    EXPECT_FALSE(interp.setTable({alpha, std::vector<double>()}, std::vector<double>()));
+    EXPECT_EQ(interp.interpolate({1.0, 1.0}, &value), avionics_sim::Bilinear_interp::INTERP_ERROR_NO_LUT);
+}
+
+TEST_F(MultilinearInterpTest, Rank1MatchesInterpolate) {
+    std::vector<double> cl = {-0.8, 0.0, 0.2, 0.6, 0.9, 1.1};
+    avionics_sim::Multilinear_interp<1> interp({alpha}, cl);
+
+    for (double a = -15.0; a <= 20.0; a += 0.25) {
+        double expected, value;
+        avionics_sim::Bilinear_interp::InterpResult expectedResult =
+            avionics_sim::Bilinear_interp::interpolate(alpha, cl, a, &expected);
+
+        ASSERT_EQ(interp.interpolate({a}, &value), expectedResult) << "alpha = " << a;
+        ASSERT_EQ(value, expected) << "alpha = " << a;
+    }
+}
+
+TEST_F(MultilinearInterpTest, Rank2MatchesBilinearInterp) {
+    // The same breakpoints of alpha in every row of mach.
+    std::vector<std::vector<double>> xVals, zVals;
+    std::vector<double> values;
+
+    for (std::size_t j = 0; j < mach.size(); j++) {
+        xVals.push_back(alpha);
+        zVals.push_back(std::vector<double>());
+
+        for (std::size_t i = 0; i < alpha.size(); i++) {
+            zVals[j].push_back(std::sin(0.1 * alpha[i]) + mach[j] * mach[j]);
+            values.push_back(zVals[j].back());
+        }
+    }
+
+    avionics_sim::Bilinear_interp bilinear(xVals, mach, zVals);
+    avionics_sim::Multilinear_interp<2> interp({mach, alpha}, values);
+
+    for (double m = -0.1; m <= 0.7; m += 0.05) {
+        for (double a = -15.0; a <= 20.0; a += 0.5) {
+            double expected, value;
+            avionics_sim::Bilinear_interp::InterpResult expectedResult = bilinear.interpolate2D(a, m, &expected);
+
+            ASSERT_EQ(interp.interpolate({m, a}, &value), expectedResult) << "mach = " << m << ", alpha = " << a;
+            ASSERT_EQ(std::memcmp(&value, &expected, sizeof(double)), 0) << "mach = " << m << ", alpha = " << a;
+        }
+    }
+}
+
+TEST_F(MultilinearInterpTest, Rank3ReproducesTrilinearFunction) {
+    std::vector<double> values;
+
+    for (double a : alpha) {
+        for (double m : mach) {
+            for (double d : deflection) {
+                values.push_back(trilinear(a, m, d));
+            }
+        }
+    }
+
+    avionics_sim::Multilinear_interp<3> interp({alpha, mach, deflection}, values);
+    std::array<avionics_sim::Bilinear_interp::Cursor, 3> cursors;
+
+    for (double a = -10.0; a <= 16.0; a += 0.75) {
+        for (double m = 0.0; m <= 0.6; m += 0.05) {
+            for (double d = -20.0; d <= 20.0; d += 2.5) {
+                double value = 0.0, valueWithCursors = 0.0;
+                ASSERT_EQ(interp.interpolate({a, m, d}, &value), avionics_sim::Bilinear_interp::INTERP_SUCCESS);
+                EXPECT_NEAR(value, trilinear(a, m, d), 1e-12);
+
+                interp.interpolate({a, m, d}, &valueWithCursors, cursors.data());
+                ASSERT_EQ(value, valueWithCursors);
+            }
+        }
+    }
+
+    // Out of bounds along one axis clamps that axis only.
+    double value = 0.0;
+    EXPECT_EQ(interp.interpolate({2.0, 0.9, 5.0}, &value), avionics_sim::Bilinear_interp::INTERP_WARN_OUT_OF_BOUNDS);
+    EXPECT_NEAR(value, trilinear(2.0, 0.6, 5.0), 1e-12);
+
+    EXPECT_EQ(interp.interpolate({-30.0, -1.0, 50.0}, &value),
+              avionics_sim::Bilinear_interp::INTERP_WARN_OUT_OF_BOUNDS);
+    EXPECT_EQ(value, trilinear(alpha.front(), mach.front(), deflection.back()));
+}
@@ -0,0 +1,231 @@
+/**
+ * @copyright   Copyright (c) 2021, Swift Engineering Inc.
+ * @license     Licensed under the MIT license. See LICENSE for details.
+ */
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Bilinear_interp.hpp"
+#include "LookupTable.hpp"
+#include "TableFile.hpp"
+
+class TableFileTest : public ::testing::Test {
+  protected:
+    std::string path = ::testing::TempDir() + "TableFileTest.lut";
+
+    // Evenly spaced rows of x, unevenly spaced y, and the first row of x longer than the others.
+    std::string xValsString = "0,10,20,30,40;0,15,30,45;0,20,40,60";
+    std::string yValsString = "0,20,70";
+    std::string zValsString = "0,1,2,3,4;1,2,3,4;2,4,6,8";
+
+    virtual void TearDown() {
+        std::remove(path.c_str());
+    }
+
+    // Overwrites the byte at offset within the file at path.
+    void corruptByte(std::size_t offset) {
+        std::fstream stream(path.c_str(), std::ios::binary | std::ios::in | std::ios::out);
+        stream.seekg(offset);
+        char byte = static_cast<char>(stream.get());
+        stream.seekp(offset);
+        stream.put(static_cast<char>(byte ^ 0x10));
+    }
+};
+
+TEST_F(TableFileTest, RoundTrip) {
+    std::vector<avionics_sim::TableFile::ArrayData> arrays = {
+        {"even", {{0.0, 1.0, 2.0}, {5.0, 7.5, 10.0}}},
+        {"uneven", {{0.0, 1.0, 3.0}}},
+        {"empty", {}}
+    };
+
+    std::string error;
+    ASSERT_TRUE(avionics_sim::TableFile::write(path, arrays, &error)) << error;
+
+    std::shared_ptr<const avionics_sim::TableFile> file = avionics_sim::TableFile::open(path, &error);
+    ASSERT_TRUE(file != nullptr) << error;
+    ASSERT_EQ(file->arrays().size(), 3);
+
+    // The values start on a cache line.
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(file->data()) % 64, 0);
+
+    for (const avionics_sim::TableFile::ArrayData &expected : arrays) {
+        const avionics_sim::TableFile::Array *array = file->find(expected.first);
+        ASSERT_TRUE(array != nullptr) << expected.first;
+
+        avionics_sim::Bilinear_interp::TableView rows = file->rows(*array);
+        ASSERT_EQ(rows.size(), expected.second.size());
+
+        for (std::size_t i = 0; i < rows.size(); i++) {
+            EXPECT_EQ(std::vector<double>(rows[i].begin(), rows[i].end()), expected.second[i]);
+        }
+    }
+
+    EXPECT_EQ(file->find("even")->flags, avionics_sim::TableFile::ARRAY_UNIFORM_ROWS);
+    EXPECT_EQ(file->find("uneven")->flags, 0u);
+    EXPECT_TRUE(file->find("missing") == nullptr);
+}
+
+TEST_F(TableFileTest, ConcurrentWritersOfOnePath) {
+    // Given: Writers of the same path at once, each with a table of its own
+    const int writers = 8;
+    std::vector<std::thread> threads;
+    std::vector<int> written(writers, 0);
+
+    // When: They all write it
+    for (int w = 0; w < writers; w++) {
+        threads.push_back(std::thread([this, w, &written] {
+            std::vector<avionics_sim::TableFile::ArrayData> arrays = {
+                {"writer", {std::vector<double>(1000, double(w))}}
+            };
+
+            written[w] = avionics_sim::TableFile::write(path, arrays) ? 1 : 0;
+        }));
+    }
+
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+
+    // Then: Every write should succeed, leaving the whole table of one of them
+    for (int w = 0; w < writers; w++) {
+        EXPECT_EQ(written[w], 1) << "writer " << w;
+    }
+
+    std::string error;
+    std::shared_ptr<const avionics_sim::TableFile> file = avionics_sim::TableFile::open(path, &error);
+    ASSERT_TRUE(file != nullptr) << error;
+
+    avionics_sim::Bilinear_interp::TableView rows = file->rows(*file->find("writer"));
+    ASSERT_EQ(rows.size(), 1u);
+    ASSERT_EQ(rows[0].size(), 1000u);
+
+    for (double value : rows[0]) {
+        ASSERT_EQ(value, rows[0][0]);
+    }
+}
+
+TEST_F(TableFileTest, RejectsBadFiles) {
+    std::string error;
+    EXPECT_TRUE(avionics_sim::TableFile::open(path, &error) == nullptr);
+    EXPECT_NE(error.find("Cannot open"), std::string::npos);
+
+    // A name too long to be stored.
+    EXPECT_FALSE(avionics_sim::TableFile::write(path, {{std::string(64, 'a'), {{1.0}}}}, &error));
+
+    ASSERT_TRUE(avionics_sim::TableFile::write(path, {{"a", {{1.0, 2.0}}}}, &error));
+
+    // A changed value.
+    std::ifstream stream(path.c_str(), std::ios::binary | std::ios::ate);
+    std::size_t size = static_cast<std::size_t>(stream.tellg());
+    stream.close();
+
+    corruptByte(size - 1);
+    EXPECT_TRUE(avionics_sim::TableFile::open(path, &error) == nullptr);
+    EXPECT_NE(error.find("checksum"), std::string::npos);
+
+    // A file of another format.
+    ASSERT_TRUE(avionics_sim::TableFile::write(path, {{"a", {{1.0, 2.0}}}}, &error));
+    corruptByte(0);
+    EXPECT_TRUE(avionics_sim::TableFile::open(path, &error) == nullptr);
+    EXPECT_NE(error.find("not a table file"), std::string::npos);
+
+    // A truncated file.
+    ASSERT_TRUE(avionics_sim::TableFile::write(path, {{"a", {{1.0, 2.0}}}}, &error));
+    ASSERT_EQ(truncate(path.c_str(), size - 8), 0);
+    EXPECT_TRUE(avionics_sim::TableFile::open(path, &error) == nullptr);
+    EXPECT_NE(error.find("truncated"), std::string::npos);
+}
+
+TEST_F(TableFileTest, BilinearInterpFromFileMatchesStrings) {
+    avionics_sim::Bilinear_interp fromStrings;
+    ASSERT_TRUE(fromStrings.setXVals(xValsString));
+    ASSERT_TRUE(fromStrings.setYVals(yValsString));
+    ASSERT_TRUE(fromStrings.setZVals(zValsString));
+
+    std::string error;
+    ASSERT_TRUE(avionics_sim::TableFile::writeFromStrings(path, {{"x", xValsString}, {"y", yValsString},
+                {"z", zValsString}}, &error)) << error;
+
+    avionics_sim::Bilinear_interp fromFile;
+
+    {
+        std::shared_ptr<const avionics_sim::TableFile> file = avionics_sim::TableFile::open(path, &error);
+        ASSERT_TRUE(file != nullptr) << error;
+        ASSERT_TRUE(fromFile.setTableFile(file));
+
+        // The values are used in place rather than copied.
+        EXPECT_EQ(fromFile.viewX()[0].data(), file->data());
+        EXPECT_EQ(fromFile.viewZ()[0].data(), file->rows(*file->find("z"))[0].data());
+    }
+
+    // The file stays mapped while the interpolator, or a copy of it, uses it.
+    avionics_sim::Bilinear_interp copy = fromFile;
+    fromFile = avionics_sim::Bilinear_interp();
+
+    for (double y = -5.0; y <= 75.0; y += 2.5) {
+        for (double x = -5.0; x <= 65.0; x += 1.25) {
+            double zStrings, zFile;
+            avionics_sim::Bilinear_interp::InterpResult resultStrings = fromStrings.interpolate2D(x, y, &zStrings);
+            avionics_sim::Bilinear_interp::InterpResult resultFile = copy.interpolate2D(x, y, &zFile);
+
+            ASSERT_EQ(resultStrings, resultFile) << "x = " << x << ", y = " << y;
+            ASSERT_EQ(std::memcmp(&zStrings, &zFile, sizeof(double)), 0) << "x = " << x << ", y = " << y;
+        }
+    }
+
+    // Setting values afterwards copies the rest out of the file.
+    ASSERT_TRUE(copy.setZVals(zValsString));
+    std::vector<std::vector<double>> xVals, xExpected;
+    ASSERT_TRUE(copy.getX(&xVals));
+    ASSERT_TRUE(fromStrings.getX(&xExpected));
+    EXPECT_EQ(xVals, xExpected);
+}
+
+TEST_F(TableFileTest, BilinearInterpRejectsFileWithoutTable) {
+    std::string error;
+    ASSERT_TRUE(avionics_sim::TableFile::writeFromStrings(path, {{"x", xValsString}, {"z", zValsString}}, &error));
+
+    avionics_sim::Bilinear_interp interp;
+    EXPECT_FALSE(interp.setTableFile(avionics_sim::TableFile::open(path)));
+    EXPECT_FALSE(interp.setTableFile(nullptr));
+
+    double z;
+    EXPECT_EQ(interp.interpolate2D(1.0, 1.0, &z), avionics_sim::Bilinear_interp::INTERP_ERROR_NO_LUT);
+}
+
+TEST_F(TableFileTest, LookupTableFromFileMatchesColumns) {
+    std::vector<std::string> colNames = {"alpha", "CL", "CD"};
+    std::vector<std::vector<double>> cols = {{-10.0, 0.0, 5.0, 15.0}, {-0.8, 0.1, 0.6, 1.2}, {0.05, 0.01, 0.02, 0.1}};
+    avionics_sim::LookupTable fromColumns(colNames, cols);
+
+    std::string error;
+    ASSERT_TRUE(avionics_sim::TableFile::write(path, {{"alpha", {cols[0]}}, {"CL", {cols[1]}}, {"CD", {cols[2]}}},
+                &error)) << error;
+
+    avionics_sim::LookupTable fromFile(avionics_sim::TableFile::open(path));
+
+    for (double alpha = -20.0; alpha <= 20.0; alpha += 0.5) {
+        ASSERT_EQ(fromFile.lookup(alpha, "alpha", "CL"), fromColumns.lookup(alpha, "alpha", "CL"));
+        ASSERT_EQ(fromFile.lookup(alpha, "alpha", "CD"), fromColumns.lookup(alpha, "alpha", "CD"));
+    }
+}
+
+TEST_F(TableFileTest, LookupTableRejectsTwoDimensionalArrays) {
+    std::string error;
+    ASSERT_TRUE(avionics_sim::TableFile::writeFromStrings(path, {{"z", zValsString}}, &error));
+
+    EXPECT_THROW(avionics_sim::LookupTable(avionics_sim::TableFile::open(path)), std::invalid_argument);
+}
@@ -0,0 +1,116 @@
+/**
+ * @copyright   Copyright (c) 2021, Swift Engineering Inc.
+ * @license     Licensed under the MIT license. See LICENSE for details.
+ */
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "Airfoil.hpp"
+#include "Bilinear_interp.hpp"
+#include "LookupTable.hpp"
+#include "TableRegistry.hpp"
+
+class TableRegistryTest : public ::testing::Test {
+  protected:
+    avionics_sim::TableRegistry &registry = avionics_sim::TableRegistry::instance();
+
+    // Values unlikely to be held by anything else in the process.
+    std::vector<double> alpha = {-12.5, -3.25, 0.0, 4.75, 17.125};
+    std::vector<double> cl = {-0.91, -0.27, 0.03, 0.55, 1.31};
+    std::vector<double> cd = {0.071, 0.023, 0.011, 0.019, 0.093};
+};
+
+TEST_F(TableRegistryTest, InternsIdenticalValuesOnce) {
+    avionics_sim::TableRegistry::Usage before = registry.usage();
+
+    avionics_sim::TableRegistry::Table first = registry.intern(alpha);
+    avionics_sim::TableRegistry::Table second = registry.intern(alpha);
+    avionics_sim::TableRegistry::Table other = registry.intern(cl);
+
+    EXPECT_EQ(first.get(), second.get());
+    EXPECT_NE(first.get(), other.get());
+    EXPECT_EQ(*first, alpha);
+
+    avionics_sim::TableRegistry::Usage during = registry.usage();
+    EXPECT_EQ(during.tableCount - before.tableCount, 2);
+    EXPECT_EQ(during.tableBytes - before.tableBytes, 2 * alpha.size() * sizeof(double));
+    EXPECT_EQ(during.referenceCount - before.referenceCount, 3);
+    EXPECT_EQ(during.unsharedBytes - before.unsharedBytes, 3 * alpha.size() * sizeof(double));
+
+    // Released once the last reference goes.
+    first.reset();
+    EXPECT_EQ(registry.usage().tableCount - before.tableCount, 2);
+
+    second.reset();
+    other.reset();
+    EXPECT_EQ(registry.usage().tableCount, before.tableCount);
+    EXPECT_EQ(registry.usage().tableBytes, before.tableBytes);
+}
+
+TEST_F(TableRegistryTest, ComparesValuesByTheirBytes) {
+    avionics_sim::TableRegistry::Table positive = registry.intern({0.0, 1.0});
+    avionics_sim::TableRegistry::Table negative = registry.intern({-0.0, 1.0});
+    avionics_sim::TableRegistry::Table shorter = registry.intern({0.0});
+
+    EXPECT_NE(positive.get(), negative.get());
+    EXPECT_NE(positive.get(), shorter.get());
+    EXPECT_TRUE(std::signbit((*negative)[0]));
+}
+
+TEST_F(TableRegistryTest, TablesShareValues) {
+    avionics_sim::TableRegistry::Usage before = registry.usage();
+
+    {
+        // Airfoils, their copies, and tables built separately from the same values.
+        std::vector<avionics_sim::Airfoil> airfoils;
+
+        for (int i = 0; i < 10; i++) {
+            airfoils.push_back(avionics_sim::Airfoil(1.0, 0.1, alpha, cl, cd));
+        }
+
+        std::vector<avionics_sim::Airfoil> copies = airfoils;
+        avionics_sim::LookupTable table({"alpha", "CL", "CD"}, {alpha, cl, cd});
+
+        avionics_sim::TableRegistry::Usage during = registry.usage();
+        EXPECT_EQ(during.tableCount - before.tableCount, 3);
+        EXPECT_EQ(during.tableBytes - before.tableBytes, 3 * alpha.size() * sizeof(double));
+        EXPECT_EQ(during.referenceCount - before.referenceCount, 3 * 21);
+
+        for (double value = -15.0; value <= 20.0; value += 0.5) {
+            EXPECT_EQ(copies[9].calculateLiftCoefficient(value), table.lookup(value, "alpha", "CL"));
+        }
+    }
+
+    EXPECT_EQ(registry.usage().tableCount, before.tableCount);
+}
+
+TEST_F(TableRegistryTest, BilinearInterpsShareValues) {
+    std::vector<std::vector<double>> xv = {alpha, alpha};
+    std::vector<double> yv = {0.0, 0.5};
+    std::vector<std::vector<double>> zv = {cl, cd};
+
+    avionics_sim::Bilinear_interp first(xv, yv, zv);
+    avionics_sim::TableRegistry::Usage before = registry.usage();
+
+    avionics_sim::Bilinear_interp second(xv, yv, zv);
+    avionics_sim::Bilinear_interp copy = second;
+
+    EXPECT_EQ(first.viewZ()[0].data(), second.viewZ()[0].data());
+    EXPECT_EQ(first.viewY().data(), copy.viewY().data());
+
+    // Only the values set before the last were interned along the way, and are released.
+    avionics_sim::TableRegistry::Usage after = registry.usage();
+    EXPECT_EQ(after.tableCount, before.tableCount);
+    EXPECT_EQ(after.referenceCount - before.referenceCount, 2 * 2);
+
+    // Setting new values leaves the others as they were.
+    second.setZVals(std::vector<std::vector<double>>({cd, cl}));
+
+    double z;
+    first.interpolate2D(alpha[0], 0.0, &z);
+    EXPECT_EQ(z, cl[0]);
+    second.interpolate2D(alpha[0], 0.0, &z);
+    EXPECT_EQ(z, cd[0]);
+}
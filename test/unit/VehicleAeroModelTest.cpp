@@ -0,0 +1,178 @@
+/**
+ * @copyright   Copyright (c) 2021, Swift Engineering Inc.
+ * @license     Licensed under the MIT license. See LICENSE for details.
+ */
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+#include <ignition/math/Pose3.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "AerodynamicModel.hpp"
+#include "VehicleAeroModel.hpp"
+
+namespace {
+
+// Environment counting the queries of its air density.
+class CountingEnvironment : public avionics_sim::IPhysicsEnvironment {
+  public:
+    int queries = 0;
+
+    virtual double get_air_density_kg_per_m3() {
+        queries++;
+        return 1.22;
+    }
+};
+
+}  // namespace
+
+namespace avionics_sim {
+
+class VehicleAeroModelTest : public ::testing::Test {
+  protected:
+    CountingEnvironment environment_;
+    std::vector<AerodynamicModel> models_;
+    VehicleAeroModel vehicle_{environment_};
+
+    std::mt19937 generator_ = std::mt19937(9);
+    std::vector<ignition::math::Vector3d> velocities_;
+    std::vector<double> propWashes_, controlAngles_;
+
+    // Surfaces of a wing, a tail and a ring of rotor arms, added to the vehicle and as models of their own.
+    void addSurfaces(std::size_t count) {
+        std::vector<double> alpha_deg = {-180.0, -15.0, 0.0, 15.0, 180.0};
+        std::vector<double> cl = {0.0, -0.9, 0.0, 0.9, 0.0};
+        std::vector<double> cd = {0.05, 0.3, 0.02, 0.3, 0.05};
+        std::vector<double> cm = {0.0, 0.1, -0.05, -0.2, 0.0};
+        std::uniform_real_distribution<double> offset(-2.0, 2.0);
+
+        for (std::size_t i = 0; i < count; i++) {
+            Airfoil airfoil(0.2 + 0.01 * i, 0.05, 0.3, alpha_deg, cl, cd, cm);
+            double heading = i * 2.0 * M_PI / count;
+            ignition::math::Vector3d forward(cos(heading), sin(heading), 0.2);
+            ignition::math::Vector3d upward(0, 0, 1);
+            ignition::math::Vector3d centerOfPressure_m(offset(generator_), offset(generator_), offset(generator_));
+
+            vehicle_.addSurface(airfoil, forward, upward, centerOfPressure_m);
+
+            models_.push_back(AerodynamicModel(airfoil, environment_));
+            models_.back().setBasisVectors(forward, upward);
+            models_.back().setCenterOfPressure(centerOfPressure_m);
+        }
+    }
+
+    // Velocities of the surfaces, with the prop wash over some and the control surfaces deflected.
+    void drawInputs() {
+        std::uniform_real_distribution<double> speed(-30.0, 30.0);
+        velocities_.clear();
+        propWashes_.clear();
+        controlAngles_.clear();
+
+        for (std::size_t i = 0; i < vehicle_.size(); i++) {
+            velocities_.push_back(ignition::math::Vector3d(speed(generator_), speed(generator_), speed(generator_)));
+            propWashes_.push_back(i % 4 == 0 ? 12.0 : 0.0);
+            controlAngles_.push_back(i % 3 == 0 ? 0.1 : 0.0);
+        }
+    }
+};
+
+TEST_F(VehicleAeroModelTest, MatchesSumOfSurfaces) {
+    // Given: A vehicle of 12 surfaces
+    addSurfaces(12);
+    ASSERT_EQ(vehicle_.size(), 12u);
+    ASSERT_EQ(vehicle_.getThreadCount(), 1u);
+
+    std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+
+    for (int step = 0; step < 50; step++) {
+        ignition::math::Pose3d poseInWorld_m_rad(0, 0, 0, angle(generator_), angle(generator_), angle(generator_));
+        drawInputs();
+
+        // When: The vehicle is updated, and each surface on its own
+        AeroWrench wrench = vehicle_.updateWrenchInBody(poseInWorld_m_rad, velocities_.data(), propWashes_.data(),
+                            controlAngles_.data());
+
+        AeroWrench expected;
+
+        for (std::size_t i = 0; i < models_.size(); i++) {
+            AeroWrench surface = models_[i].updateWrenchInBody(poseInWorld_m_rad, velocities_[i], propWashes_[i],
+                                 controlAngles_[i]);
+
+            // Then: Each surface should have exactly the wrench of its model
+            ASSERT_EQ(std::memcmp(&vehicle_.getSurfaceWrench(i), &surface, sizeof(surface)), 0) << "surface " << i;
+
+            expected.force_N += surface.force_N;
+            expected.moment_N_m += surface.moment_N_m;
+        }
+
+        // And the vehicle should have exactly their sum, in order
+        ASSERT_EQ(std::memcmp(&wrench, &expected, sizeof(expected)), 0) << "step " << step;
+    }
+}
+
+TEST_F(VehicleAeroModelTest, SameForAnyThreadCount) {
+    // Given: A vehicle of many surfaces, and its wrench calculated on the calling thread alone
+    addSurfaces(101);
+    drawInputs();
+    ignition::math::Pose3d poseInWorld_m_rad(0, 0, 0, 0.3, -0.2, 1.1);
+
+    AeroWrench expected = vehicle_.updateWrenchInBody(poseInWorld_m_rad, velocities_.data(), propWashes_.data(),
+                          controlAngles_.data());
+
+    const std::size_t threadCounts[] = {2, 3, 8, 1, 0};
+
+    for (std::size_t threadCount : threadCounts) {
+        vehicle_.setThreadCount(threadCount);
+        ASSERT_EQ(vehicle_.getThreadCount(), threadCount == 0 ? 1u : threadCount);
+
+        // When: It is updated again, split between threads
+        for (int step = 0; step < 20; step++) {
+            AeroWrench wrench = vehicle_.updateWrenchInBody(poseInWorld_m_rad, velocities_.data(),
+                                propWashes_.data(), controlAngles_.data());
+
+            // Then: The wrench should be exactly the same
+            ASSERT_EQ(std::memcmp(&wrench, &expected, sizeof(expected)), 0) << threadCount << " threads";
+        }
+    }
+}
+
+TEST_F(VehicleAeroModelTest, SnapshotQueriesNoEnvironment) {
+    // Given: A vehicle of a few surfaces
+    addSurfaces(5);
+    drawInputs();
+    ignition::math::Pose3d poseInWorld_m_rad(0, 0, 0, 0.1, 0.2, 0.3);
+
+    // When: It is updated in its environment, and in the air of a snapshot
+    environment_.queries = 0;
+    AeroWrench expected = vehicle_.updateWrenchInBody(poseInWorld_m_rad, velocities_.data(), propWashes_.data(),
+                          controlAngles_.data());
+
+    // Then: The environment should have been queried once for the whole vehicle
+    ASSERT_EQ(environment_.queries, 1);
+
+    EnvironmentSnapshot snapshot;
+    snapshot.airDensity_kg_per_m3 = 1.22;
+    AeroWrench wrench = vehicle_.updateWrenchInBody(snapshot, poseInWorld_m_rad, velocities_.data(),
+                        propWashes_.data(), controlAngles_.data());
+
+    // And not at all for the snapshot, whose wrench should be exactly the same
+    ASSERT_EQ(environment_.queries, 1);
+    ASSERT_EQ(std::memcmp(&wrench, &expected, sizeof(expected)), 0);
+}
+
+TEST_F(VehicleAeroModelTest, EmptyVehicle) {
+    // Given: A vehicle with no surfaces, split between threads
+    vehicle_.setThreadCount(4);
+
+    // When: It is updated
+    AeroWrench wrench = vehicle_.updateWrenchInBody(ignition::math::Pose3d(), nullptr, nullptr, nullptr);
+
+    // Then: There should be no force or moment
+    ASSERT_EQ(wrench.force_N, ignition::math::Vector3d::Zero);
+    ASSERT_EQ(wrench.moment_N_m, ignition::math::Vector3d::Zero);
+}
+
+}  // namespace avionics_sim
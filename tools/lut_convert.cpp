@@ -0,0 +1,48 @@
+/**
+ * @brief       Converts LUT strings into a table file.
+ * @file        lut_convert.cpp
+ * @copyright   Copyright (c) 2021, Swift Engineering Inc.
+ * @license     Licensed under the MIT license. See LICENSE for details.
+ * @details     Usage: lut_convert <output file> <name>=<values> [<name>=<values> ...]
+ *
+ *              Each values string is in the format taken by Bilinear_interp::setXVals() and the like. Name the arrays
+ *              "x", "y" and "z" for a file to be loaded by Bilinear_interp::setTableFile(), or after the columns of a
+ *              LookupTable.
+ */
+
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "TableFile.hpp"
+
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        fprintf(stderr, "Usage: %s <output file> <name>=<values> [<name>=<values> ...]\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<std::pair<std::string, std::string>> lutStrings;
+
+    for (int i = 2; i < argc; i++) {
+        std::string argument = argv[i];
+        std::size_t equals = argument.find('=');
+
+        if (equals == std::string::npos) {
+            fprintf(stderr, "Expected <name>=<values>, not %s\n", argv[i]);
+            return 1;
+        }
+
+        lutStrings.push_back(std::make_pair(argument.substr(0, equals), argument.substr(equals + 1)));
+    }
+
+    std::string error;
+
+    if (!avionics_sim::TableFile::writeFromStrings(argv[1], lutStrings, &error)) {
+        fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+
+    return 0;
+}